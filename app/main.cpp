@@ -3,15 +3,303 @@
 // ICS 46 Spring 2018
 // Project #4: Set the Controls for the Heart of the Sun
 //
-// You will not need to modify this file at all; it simply calls into the
-// provided code and prints any error messages that emanate from it.
+// Run without arguments, the app starts the interactive spell-checking shell.
+// Run with --batch, it instead checks a whole file (or, when no file is
+// named, the standard input) without interaction, writing one line per
+// misspelled word to the standard output and a summary, including the
+// throughput in MB/s, to the standard error:
+//
+//     ./app --batch [--dict DICTIONARY] [--freq FREQUENCIES] [--threads N] [FILE]
+//
+// The dictionary is either a dictionary file written by the dict tool or a
+// word list with words separated by whitespace; it defaults to words.txt.
+// Suggestions are made from the letters that appear in its words, so a
+// dictionary in another language gets suggestions in its own letters.
+// When a frequency file (see WordFrequencies.hpp) is given with it, only
+// the best suggestions for each misspelled word are written, ranked by
+// how little the word had to be changed and how often they're used.
+// Suggestions are generated on N threads, by default one fewer than the
+// number of processors (see PipelineChecker.hpp); the standard input is
+// checked as it arrives, rather than after all of it has been read.
+//
+// Run with --serve, it loads the dictionary once and then answers requests
+// from other processes over a Unix domain socket with the given path (see
+// SpellCheckServer.hpp), until it's interrupted:
+//
+//     ./app --serve [--dict DICTIONARY] [--freq FREQUENCIES] [--threads N] SOCKET
+//
+// The client program is a small client for the server.
 
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Alphabet.hpp"
+#include "BatchChecker.hpp"
+#include "DocumentTokenizer.hpp"
+#include "HashSet.hpp"
+#include "MappedDictionary.hpp"
+#include "PipelineChecker.hpp"
+#include "SpellCheckServer.hpp"
 #include "SpellCheckShell.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
 
 
-int main()
+namespace
 {
+    const std::string DEFAULT_DICTIONARY = "words.txt";
+
+
+    struct CommandError
+    {
+        std::string reason;
+    };
+
+
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    // A Dictionary is the set of words to check against, along with the
+    // Alphabet of every letter that appears in them, from which
+    // suggestions are made.
+    struct Dictionary
+    {
+        std::unique_ptr<Set<std::string>> words;
+        Alphabet alphabet;
+    };
+
+
+    Dictionary loadDictionary(const std::string& path)
+    {
+        // Only a file that isn't a dictionary file at all is read as a word
+        // list; one that is, but can't be opened, is an error, rather than
+        // a list of whatever words its bytes happen to spell.
+        if (isMappedDictionaryFile(path))
+        {
+            try
+            {
+                auto mapped = std::make_unique<MappedDictionary>(path);
+                Alphabet alphabet;
+                mapped->forEachWord([&](std::string_view word) { alphabet.add(word); });
+                return Dictionary{std::move(mapped), std::move(alphabet)};
+            }
+            catch (MappedDictionary::DictionaryException& e)
+            {
+                throw CommandError{e.reason()};
+            }
+        }
+
+        std::ifstream in{path};
+        if (!in)
+        {
+            throw CommandError{"Cannot open dictionary " + path};
+        }
+
+        std::vector<std::string> words{
+            std::istream_iterator<std::string>{in}, std::istream_iterator<std::string>{}};
+
+        auto set = std::make_unique<HashSet<std::string>>(stringHash, words.size());
+        set->addMany(words);
+        return Dictionary{std::move(set), Alphabet{words}};
+    }
+
+
+    // loadFrequencies() reads the frequency file with the given path, or
+    // returns an empty table if there is none.
+    WordFrequencies loadFrequencies(const std::string& path)
+    {
+        if (path.empty())
+        {
+            return WordFrequencies{};
+        }
+
+        try
+        {
+            return WordFrequencies{path};
+        }
+        catch (WordFrequencies::FrequencyException& e)
+        {
+            throw CommandError{e.reason()};
+        }
+    }
+
+
+    // Options are the command-line arguments shared by --batch and --serve.
+    struct Options
+    {
+        std::string dictionaryPath = DEFAULT_DICTIONARY;
+        std::string frequencyPath;
+        unsigned int threads = 0;
+        std::string path;
+    };
+
+
+    // makeChecker() makes a WordChecker for the given dictionary, which
+    // makes suggestions from the dictionary's own alphabet and ranks them
+    // by the given frequencies if a frequency file was named in the
+    // options.
+    WordChecker makeChecker(
+        const Options& options, const Dictionary& dictionary, const WordFrequencies& frequencies)
+    {
+        return options.frequencyPath.empty()
+            ? WordChecker{*dictionary.words, dictionary.alphabet}
+            : WordChecker{*dictionary.words, frequencies, dictionary.alphabet};
+    }
+
+
+    Options parseOptions(const std::vector<std::string>& args, const std::string& usage)
+    {
+        Options options;
+
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            if (args[i] == "--dict" && i + 1 < args.size())
+            {
+                options.dictionaryPath = args[++i];
+            }
+            else if (args[i] == "--freq" && i + 1 < args.size())
+            {
+                options.frequencyPath = args[++i];
+            }
+            else if (args[i] == "--threads" && i + 1 < args.size())
+            {
+                options.threads = static_cast<unsigned int>(std::strtoul(args[++i].c_str(), nullptr, 10));
+            }
+            else if (options.path.empty())
+            {
+                options.path = args[i];
+            }
+            else
+            {
+                throw CommandError{"usage: " + usage};
+            }
+        }
+
+        return options;
+    }
+
+
+    int runBatch(const std::vector<std::string>& args)
+    {
+        Options options = parseOptions(
+            args, "app --batch [--dict DICTIONARY] [--freq FREQUENCIES] [--threads N] [FILE]");
+
+        Dictionary dictionary = loadDictionary(options.dictionaryPath);
+        WordFrequencies frequencies = loadFrequencies(options.frequencyPath);
+        WordChecker checker = makeChecker(options, dictionary, frequencies);
+        PipelineChecker pipeline{checker, options.threads};
+
+        std::ios::sync_with_stdio(false);
+        BatchOutput output{std::cout};
+        BatchStatistics stats;
+
+        // A file is mapped and checked where it lies; the standard input,
+        // which can't be mapped, is checked a chunk at a time as it's read.
+        if (options.path.empty() || options.path == "-")
+        {
+            stats = pipeline.check(std::cin, output);
+        }
+        else
+        {
+            MappedDocument document{options.path};
+            stats = pipeline.check(document.text(), output);
+        }
+
+        if (!output.flush())
+        {
+            throw CommandError{"Cannot write output"};
+        }
+
+        std::cerr << "Checked " << stats.words << " words (" << stats.bytes << " bytes) in "
+                  << stats.seconds << "s: " << stats.megabytesPerSecond() << " MB/s, "
+                  << stats.misspellings << " misspelled" << std::endl;
+
+        return 0;
+    }
+
+
+    SpellCheckServer* runningServer = nullptr;
+
+
+    void stopServer(int)
+    {
+        runningServer->stop();
+    }
+
+
+    int runServer(const std::vector<std::string>& args)
+    {
+        const std::string usage = "app --serve [--dict DICTIONARY] [--freq FREQUENCIES] [--threads N] SOCKET";
+
+        Options options = parseOptions(args, usage);
+        if (options.path.empty())
+        {
+            throw CommandError{"usage: " + usage};
+        }
+
+        Dictionary dictionary = loadDictionary(options.dictionaryPath);
+        WordFrequencies frequencies = loadFrequencies(options.frequencyPath);
+        WordChecker checker = makeChecker(options, dictionary, frequencies);
+        SpellCheckServer server{checker, options.path, options.threads};
+
+        runningServer = &server;
+        struct sigaction action{};
+        action.sa_handler = stopServer;
+        ::sigaction(SIGINT, &action, nullptr);
+        ::sigaction(SIGTERM, &action, nullptr);
+
+        std::cerr << "Serving " << dictionary.words->size() << " words on " << server.socketPath() << std::endl;
+        server.run();
+
+        action.sa_handler = SIG_DFL;
+        ::sigaction(SIGINT, &action, nullptr);
+        ::sigaction(SIGTERM, &action, nullptr);
+        runningServer = nullptr;
+
+        return 0;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args{argv + 1, argv + argc};
+
+    if (!args.empty() && (args[0] == "--batch" || args[0] == "--serve"))
+    {
+        try
+        {
+            std::vector<std::string> rest{args.begin() + 1, args.end()};
+            return args[0] == "--batch" ? runBatch(rest) : runServer(rest);
+        }
+        catch (CommandError& e)
+        {
+            std::cerr << "ERROR: " << e.reason << std::endl;
+            return 1;
+        }
+        catch (MappedDocument::DocumentException& e)
+        {
+            std::cerr << "ERROR: " << e.reason() << std::endl;
+            return 1;
+        }
+        catch (SpellCheckServer::ServerException& e)
+        {
+            std::cerr << "ERROR: " << e.reason() << std::endl;
+            return 1;
+        }
+    }
+
     try
     {
         SpellCheckShell shell;
@@ -24,4 +312,3 @@ int main()
 
     return 0;
 }
-
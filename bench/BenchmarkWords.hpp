@@ -0,0 +1,143 @@
+// BenchmarkWords.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// The benchmarks run against generated dictionaries rather than real word
+// lists, so that every run, on every machine, measures exactly the same
+// words.  The words are made by a fixed-seed SplitMix64 generator, not by
+// the standard library's distributions, whose output varies from one
+// library to another.  Word lengths follow roughly the shape of an English
+// dictionary's, most commonly 7 to 9 letters, and the letters are weighted
+// by how often they appear in English, so the suggestions generated for a
+// misspelled word hit the dictionary about as often as they would for real
+// text.
+//
+// Generating a large dictionary takes a while, so each is generated once
+// and kept for the rest of the run.
+
+#ifndef BENCHMARKWORDS_HPP
+#define BENCHMARKWORDS_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+
+class WordGenerator
+{
+public:
+    explicit WordGenerator(std::uint64_t seed)
+        : state{seed}
+    {
+    }
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    unsigned int below(unsigned int bound)
+    {
+        return static_cast<unsigned int>(next() % bound);
+    }
+
+    char letter()
+    {
+        // Letters repeated in proportion to their frequency in English.
+        static const std::string weighted =
+            "EEEEEEEEEEEEETTTTTTTTTAAAAAAAAOOOOOOOIIIIIIINNNNNNNSSSSSSHHHHHH"
+            "RRRRRRDDDDLLLLCCCUUUMMMWWFFGGYYPPBVKJXQZ";
+        return weighted[below(weighted.size())];
+    }
+
+    std::string word(unsigned int length)
+    {
+        std::string w(length, ' ');
+        for (char& c : w)
+        {
+            c = letter();
+        }
+        return w;
+    }
+
+    unsigned int wordLength()
+    {
+        // Lengths from 2 to 16, weighted toward the middle.
+        static const unsigned int lengths[] = {
+            2, 3, 3, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7,
+            8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11,
+            12, 12, 13, 13, 14, 15, 16};
+        return lengths[below(sizeof(lengths) / sizeof(lengths[0]))];
+    }
+
+private:
+    std::uint64_t state;
+};
+
+
+// dictionary() returns the given number of distinct words.  The same
+// count always gives the same words, in the same order.
+inline const std::vector<std::string>& dictionary(unsigned int count)
+{
+    static std::map<unsigned int, std::vector<std::string>> dictionaries;
+
+    std::vector<std::string>& words = dictionaries[count];
+    if (words.empty() && count > 0)
+    {
+        WordGenerator generator{46};
+        std::unordered_set<std::string> seen;
+
+        while (words.size() < count)
+        {
+            std::string w = generator.word(generator.wordLength());
+            if (seen.insert(w).second)
+            {
+                words.push_back(w);
+            }
+        }
+    }
+
+    return words;
+}
+
+
+// misspellings() returns the given number of words, each of which is a
+// word from the dictionary of the given size with one letter changed,
+// and none of which is in that dictionary.  When "length" is nonzero,
+// only words of that length are used.
+inline std::vector<std::string> misspellings(
+    unsigned int dictionarySize, unsigned int count, unsigned int length = 0)
+{
+    const std::vector<std::string>& words = dictionary(dictionarySize);
+    std::unordered_set<std::string> present{words.begin(), words.end()};
+    WordGenerator generator{4646 + length};
+
+    std::vector<std::string> misspelled;
+    while (misspelled.size() < count)
+    {
+        std::string w = words[generator.below(words.size())];
+        if (length != 0 && w.size() != length)
+        {
+            continue;
+        }
+
+        w[generator.below(w.size())] = generator.letter();
+        if (present.count(w) == 0)
+        {
+            misspelled.push_back(w);
+        }
+    }
+
+    return misspelled;
+}
+
+
+
+#endif // BENCHMARKWORDS_HPP
@@ -0,0 +1,71 @@
+// DocumentTokenizer_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks of splitting text into words with a DocumentTokenizer, with
+// no lookups, so that the tokenizer's own throughput (reported in bytes
+// per second) can be told apart from the checker's.  The text is made of
+// generated words in mixed case, separated mostly by spaces, with some
+// punctuation and a line break every dozen words or so.
+
+#include <cctype>
+#include <string>
+#include <benchmark/benchmark.h>
+#include "BenchmarkWords.hpp"
+#include "DocumentTokenizer.hpp"
+
+
+namespace
+{
+    std::string makeDocument(std::size_t size)
+    {
+        static const char* separators[] = {
+            " ", " ", " ", " ", " ", " ", " ", ", ", ". ", "; ", "'s ", " - ", "\n", "\n\n"};
+
+        WordGenerator generator{0x5eed};
+        std::string text;
+
+        while (text.size() < size)
+        {
+            std::string word = generator.word(generator.wordLength());
+            for (std::size_t i = generator.below(2); i < word.size(); ++i)
+            {
+                word[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(word[i])));
+            }
+
+            text += word;
+            text += separators[generator.below(sizeof(separators) / sizeof(separators[0]))];
+        }
+
+        text.resize(size);
+        return text;
+    }
+
+
+    void tokenize(benchmark::State& state)
+    {
+        std::string text = makeDocument(state.range(0));
+        std::size_t words = 0;
+
+        for (auto _ : state)
+        {
+            DocumentTokenizer tokenizer{text};
+            DocumentToken token;
+            while (tokenizer.next(token))
+            {
+                benchmark::DoNotOptimize(token);
+                ++words;
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * text.size());
+        state.counters["words"] = benchmark::Counter(static_cast<double>(words), benchmark::Counter::kIsRate);
+    }
+}
+
+
+BENCHMARK(tokenize)
+    ->Name("DocumentTokenizer/tokenize")
+    ->RangeMultiplier(16)->Range(1 << 12, 1 << 26)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,368 @@
+// Set_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks of the basic Set operations -- add(), contains() of words that
+// are and aren't in the set, and copying and moving a whole set -- for each
+// kind of set, across dictionary sizes from 10,000 to 1,000,000 words.
+//
+// ListSet takes linear time per operation, so it's only measured on the
+// smaller dictionaries; at a million words, building one would take hours.
+//
+// NodePerLevelSkipList is not one of the sets; it's the textbook skip list
+// that SkipListSet's towers replace, with a separate node (and a separate
+// copy of the key) on every level an element occupies, linked down to the
+// one below it.  Its heights come from the same kind of level tester, so
+// the two lists have the same shape, and its add() and contains() are
+// measured at the same sizes, as a baseline for SkipListSet's.
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "AVLSet.hpp"
+#include "BenchmarkWords.hpp"
+#include "HashSet.hpp"
+#include "ListSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    constexpr unsigned int QUERY_COUNT = 10000;
+
+
+    template <typename ElementType>
+    class NodePerLevelSkipList
+    {
+    public:
+        static constexpr unsigned int MAX_LEVELS = SkipListSet<ElementType>::MAX_LEVELS;
+
+        NodePerLevelSkipList()
+            : levels{1}, sz{0}
+        {
+            for (unsigned int level = 0; level < MAX_LEVELS; ++level)
+            {
+                head[level] = new Node{ElementType{}, nullptr, level > 0 ? head[level - 1] : nullptr};
+            }
+        }
+
+        NodePerLevelSkipList(NodePerLevelSkipList&& s) noexcept
+            : heights{std::move(s.heights)}, levels{s.levels}, sz{s.sz}
+        {
+            std::copy(s.head, s.head + MAX_LEVELS, head);
+            std::fill(s.head, s.head + MAX_LEVELS, nullptr);
+        }
+
+        ~NodePerLevelSkipList() noexcept
+        {
+            for (Node* node : head)
+            {
+                while (node != nullptr)
+                {
+                    Node* next = node->next;
+                    delete node;
+                    node = next;
+                }
+            }
+        }
+
+        NodePerLevelSkipList(const NodePerLevelSkipList&) = delete;
+        NodePerLevelSkipList& operator=(const NodePerLevelSkipList&) = delete;
+
+        void add(const ElementType& element)
+        {
+            Node* update[MAX_LEVELS];
+            Node* node = head[levels - 1];
+
+            for (unsigned int level = levels; level-- > 0; )
+            {
+                while (node->next != nullptr && node->next->key < element)
+                {
+                    node = node->next;
+                }
+
+                update[level] = node;
+                node = level > 0 ? node->down : node;
+            }
+
+            if (node->next != nullptr && node->next->key == element)
+            {
+                return;
+            }
+
+            unsigned int height = heights.towerHeight(element, MAX_LEVELS);
+
+            for (; levels < height; ++levels)
+            {
+                update[levels] = head[levels];
+            }
+
+            Node* below = nullptr;
+
+            for (unsigned int level = 0; level < height; ++level)
+            {
+                below = update[level]->next = new Node{element, update[level]->next, below};
+            }
+
+            ++sz;
+        }
+
+        bool contains(const ElementType& element) const
+        {
+            const Node* node = head[levels - 1];
+
+            for (unsigned int level = levels; level-- > 0; )
+            {
+                while (node->next != nullptr && node->next->key < element)
+                {
+                    node = node->next;
+                }
+
+                if (node->next != nullptr && node->next->key == element)
+                {
+                    return true;
+                }
+
+                node = node->down;
+            }
+
+            return false;
+        }
+
+        unsigned int size() const noexcept
+        {
+            return sz;
+        }
+
+    private:
+        struct Node
+        {
+            ElementType key;
+            Node* next;
+            Node* down;
+        };
+
+        // head[level] is the -INF node on each level.
+        Node* head[MAX_LEVELS];
+        FastRandomSkipListLevelTester<ElementType> heights;
+        unsigned int levels;
+        unsigned int sz;
+    };
+
+
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    // Each of these makes an empty set of one kind, so the benchmarks can
+    // be written once as templates.
+    struct MakeHashSet
+    {
+        HashSet<std::string> operator()() const
+        {
+            return HashSet<std::string>{stringHash};
+        }
+    };
+
+    struct MakeAVLSet
+    {
+        AVLSet<std::string> operator()() const
+        {
+            return AVLSet<std::string>{};
+        }
+    };
+
+    struct MakeSkipListSet
+    {
+        SkipListSet<std::string> operator()() const
+        {
+            return SkipListSet<std::string>{};
+        }
+    };
+
+    struct MakeNodePerLevelSkipList
+    {
+        NodePerLevelSkipList<std::string> operator()() const
+        {
+            return NodePerLevelSkipList<std::string>{};
+        }
+    };
+
+    struct MakeListSet
+    {
+        ListSet<std::string> operator()() const
+        {
+            return ListSet<std::string>{};
+        }
+    };
+
+
+    template <typename MakeSet>
+    auto buildSet(const std::vector<std::string>& words)
+    {
+        auto s = MakeSet{}();
+        for (const std::string& word : words)
+        {
+            s.add(word);
+        }
+        return s;
+    }
+
+
+    template <typename MakeSet>
+    void add(benchmark::State& state)
+    {
+        const std::vector<std::string>& words = dictionary(state.range(0));
+
+        for (auto _ : state)
+        {
+            auto s = buildSet<MakeSet>(words);
+            benchmark::DoNotOptimize(s.size());
+
+            // The set is destroyed outside of the timed region.
+            state.PauseTiming();
+            { auto expiring = std::move(s); }
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * words.size());
+    }
+
+
+    template <typename MakeSet>
+    void containsPresent(benchmark::State& state)
+    {
+        const std::vector<std::string>& words = dictionary(state.range(0));
+        auto s = buildSet<MakeSet>(words);
+
+        std::vector<std::string> queries;
+        for (unsigned int i = 0; i < QUERY_COUNT; ++i)
+        {
+            queries.push_back(words[(i * 7919ull) % words.size()]);
+        }
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                benchmark::DoNotOptimize(s.contains(query));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+    }
+
+
+    template <typename MakeSet>
+    void containsAbsent(benchmark::State& state)
+    {
+        const std::vector<std::string>& words = dictionary(state.range(0));
+        auto s = buildSet<MakeSet>(words);
+        std::vector<std::string> queries = misspellings(state.range(0), QUERY_COUNT);
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                benchmark::DoNotOptimize(s.contains(query));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+    }
+
+
+    template <typename MakeSet>
+    void copy(benchmark::State& state)
+    {
+        const std::vector<std::string>& words = dictionary(state.range(0));
+        auto s = buildSet<MakeSet>(words);
+
+        for (auto _ : state)
+        {
+            auto copied{s};
+            benchmark::DoNotOptimize(copied.size());
+
+            state.PauseTiming();
+            { auto expiring = std::move(copied); }
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * words.size());
+    }
+
+
+    template <typename MakeSet>
+    void move(benchmark::State& state)
+    {
+        const std::vector<std::string>& words = dictionary(state.range(0));
+        auto s = buildSet<MakeSet>(words);
+
+        for (auto _ : state)
+        {
+            auto moved{std::move(s)};
+            s = std::move(moved);
+            benchmark::DoNotOptimize(s.size());
+        }
+    }
+
+
+    using Function = void (*)(benchmark::State&);
+
+
+    void registerBenchmarks(
+        const std::string& name, long largestSize,
+        std::initializer_list<std::pair<const char*, Function>> benchmarks)
+    {
+        for (auto& [operation, function] : benchmarks)
+        {
+            benchmark::RegisterBenchmark((name + "/" + operation).c_str(), function)
+                ->RangeMultiplier(10)
+                ->Range(10000, largestSize)
+                ->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+
+    template <typename MakeSet>
+    void registerSetBenchmarks(const std::string& name, long largestSize)
+    {
+        registerBenchmarks(name, largestSize, {
+            {"add", add<MakeSet>},
+            {"containsPresent", containsPresent<MakeSet>},
+            {"containsAbsent", containsAbsent<MakeSet>},
+            {"copy", copy<MakeSet>},
+            {"move", move<MakeSet>}
+        });
+    }
+
+
+    // The baseline can't be copied, so only its add() and contains() are
+    // measured.
+    template <typename MakeSet>
+    void registerBaselineBenchmarks(const std::string& name, long largestSize)
+    {
+        registerBenchmarks(name, largestSize, {
+            {"add", add<MakeSet>},
+            {"containsPresent", containsPresent<MakeSet>},
+            {"containsAbsent", containsAbsent<MakeSet>}
+        });
+    }
+
+
+    const bool registered = [] {
+        registerSetBenchmarks<MakeHashSet>("HashSet", 1000000);
+        registerSetBenchmarks<MakeAVLSet>("AVLSet", 1000000);
+        registerSetBenchmarks<MakeSkipListSet>("SkipListSet", 1000000);
+        registerBaselineBenchmarks<MakeNodePerLevelSkipList>("NodePerLevelSkipList", 1000000);
+        registerSetBenchmarks<MakeListSet>("ListSet", 10000);
+        return true;
+    }();
+}
@@ -0,0 +1,232 @@
+// WordChecker_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks of checking words, and of generating suggestions for
+// misspelled words, by word length, against a 100,000-word dictionary.
+// wordExists() is measured with words written in lower case, so that all of
+// its time isn't just the lookup, but also folding them to upper case.  The number of candidates
+// findSuggestions() tries grows with the length of the word, so its cost
+// does too.  Each is measured both through WordChecker, which looks words
+// up through the Set interface, and through a BasicWordChecker that knows
+// it has a HashSet, which calls contains() directly.
+//
+// findTopSuggestions() is measured asking for the best 5 and the best 1,
+// with frequencies following Zipf's law (the i-th word of the dictionary
+// being used 1/i as often as the first), as real word counts roughly do.
+// findLikelySuggestions() is measured asking for 1 and 5, trying every
+// tier of letters or only the adjacent keys.  findDistance2Suggestions() is
+// measured with the default candidate budget and with a budget of 2,000.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "BasicWordChecker.hpp"
+#include "BenchmarkWords.hpp"
+#include "HashSet.hpp"
+#include "PrefixFilter.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    constexpr unsigned int DICTIONARY_SIZE = 100000;
+    constexpr unsigned int QUERY_COUNT = 100;
+
+
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    const HashSet<std::string>& hashDictionary()
+    {
+        static const HashSet<std::string> words = [] {
+            HashSet<std::string> s{stringHash};
+            for (const std::string& word : dictionary(DICTIONARY_SIZE))
+            {
+                s.add(word);
+            }
+            return s;
+        }();
+
+        return words;
+    }
+
+
+    const PrefixFilter& dictionaryPrefixes()
+    {
+        static const PrefixFilter prefixes{dictionary(DICTIONARY_SIZE)};
+        return prefixes;
+    }
+
+
+    const WordFrequencies& zipfFrequencies()
+    {
+        static const WordFrequencies frequencies = [] {
+            WordFrequencies f;
+            std::uint64_t rank = 1;
+            for (const std::string& word : dictionary(DICTIONARY_SIZE))
+            {
+                f.add(word, 1000000000 / rank++);
+            }
+            return f;
+        }();
+
+        return frequencies;
+    }
+
+
+    void wordExists(benchmark::State& state)
+    {
+        WordChecker checker{hashDictionary()};
+        std::size_t length = static_cast<std::size_t>(state.range(0));
+
+        std::vector<std::string> queries;
+        for (const std::string& word : dictionary(DICTIONARY_SIZE))
+        {
+            if (word.size() == length && queries.size() < QUERY_COUNT)
+            {
+                queries.push_back(word);
+                for (char& c : queries.back())
+                {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+            }
+        }
+
+        std::size_t found = 0;
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                found += checker.wordExists(query) ? 1 : 0;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+        state.counters["found"] = static_cast<double>(found) / (state.iterations() * queries.size());
+    }
+
+
+    template <typename Checker>
+    void findSuggestions(benchmark::State& state)
+    {
+        Checker checker{hashDictionary()};
+        std::vector<std::string> queries = misspellings(DICTIONARY_SIZE, QUERY_COUNT, state.range(0));
+        std::size_t suggestions = 0;
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                suggestions += checker.findSuggestions(query).size();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+        state.counters["suggestionsPerWord"] = static_cast<double>(suggestions) / (state.iterations() * queries.size());
+    }
+
+
+    void findTopSuggestions(benchmark::State& state)
+    {
+        WordChecker checker{hashDictionary(), zipfFrequencies()};
+        std::vector<std::string> queries = misspellings(DICTIONARY_SIZE, QUERY_COUNT, state.range(0));
+        std::size_t k = static_cast<std::size_t>(state.range(1));
+        std::size_t suggestions = 0;
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                suggestions += checker.findTopSuggestions(query, k).size();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+        state.counters["suggestionsPerWord"] = static_cast<double>(suggestions) / (state.iterations() * queries.size());
+    }
+
+
+    void findDistance2Suggestions(benchmark::State& state)
+    {
+        WordChecker checker{hashDictionary()};
+        std::vector<std::string> queries = misspellings(DICTIONARY_SIZE, QUERY_COUNT, state.range(0));
+        std::size_t budget = static_cast<std::size_t>(state.range(1));
+        std::size_t suggestions = 0;
+        std::size_t incomplete = 0;
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                SuggestionResult result = checker.findDistance2Suggestions(query, dictionaryPrefixes(), budget);
+                suggestions += result.words.size();
+                incomplete += result.complete ? 0 : 1;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+        state.counters["suggestionsPerWord"] = static_cast<double>(suggestions) / (state.iterations() * queries.size());
+        state.counters["incomplete"] = static_cast<double>(incomplete) / (state.iterations() * queries.size());
+    }
+
+
+    void findLikelySuggestions(benchmark::State& state)
+    {
+        WordChecker checker{hashDictionary()};
+        std::vector<std::string> queries = misspellings(DICTIONARY_SIZE, QUERY_COUNT, state.range(0));
+        std::size_t k = static_cast<std::size_t>(state.range(1));
+        EditTier widest = state.range(2) == 0 ? EditTier::Adjacent : EditTier::Other;
+        std::size_t suggestions = 0;
+
+        for (auto _ : state)
+        {
+            for (const std::string& query : queries)
+            {
+                suggestions += checker.findLikelySuggestions(query, k, nullptr, widest).size();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * queries.size());
+        state.counters["suggestionsPerWord"] = static_cast<double>(suggestions) / (state.iterations() * queries.size());
+    }
+}
+
+
+BENCHMARK(wordExists)
+    ->Name("WordChecker/wordExists")
+    ->DenseRange(3, 15, 3)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(findSuggestions, WordChecker)
+    ->Name("WordChecker/findSuggestions")
+    ->DenseRange(3, 15, 3)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(findSuggestions, BasicWordChecker<HashSet<std::string>>)
+    ->Name("BasicWordChecker<HashSet>/findSuggestions")
+    ->DenseRange(3, 15, 3)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(findTopSuggestions)
+    ->Name("WordChecker/findTopSuggestions")
+    ->ArgsProduct({{3, 6, 9, 12, 15}, {1, 5}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(findLikelySuggestions)
+    ->Name("WordChecker/findLikelySuggestions")
+    ->ArgsProduct({{3, 6, 9, 12, 15}, {1, 5}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(findDistance2Suggestions)
+    ->Name("WordChecker/findDistance2Suggestions")
+    ->ArgsProduct({{3, 6, 9, 12, 15}, {BasicWordChecker<Set<std::string>>::DEFAULT_CANDIDATE_BUDGET, 2000}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,51 @@
+// benchmain.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// This launches Google Benchmark and runs the benchmarks in the source files
+// in the "bench" directory.  Along with the usual table on the console, the
+// results are written as JSON to bench_output.json (unless another file is
+// named with --benchmark_out), so that one run can be compared against
+// another, e.g., with Google Benchmark's tools/compare.py.
+//
+// Any of Google Benchmark's options can be given; for instance, to measure
+// only HashSet,
+//
+//     ./bench --benchmark_filter=HashSet
+
+#include <cstring>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+
+int main(int argc, char** argv)
+{
+    std::vector<char*> args{argv, argv + argc};
+
+    bool outputNamed = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        outputNamed = outputNamed || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+
+    char defaultOutput[] = "--benchmark_out=bench_output.json";
+    char defaultFormat[] = "--benchmark_out_format=json";
+    if (!outputNamed)
+    {
+        args.push_back(defaultOutput);
+        args.push_back(defaultFormat);
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+// clientmain.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// This is a small client for the spell-checking server (started with
+// "./app --serve SOCKET"), for trying it out and measuring it.  Given
+// words, it checks each one and, for those that are misspelled, asks for
+// suggestions:
+//
+//     ./client /tmp/spell.sock HELLO WROLD
+//
+// Given no words, it sends each line of the standard input as a request
+// and prints each response, so the protocol can be spoken by hand.  With
+// --bench N, it instead makes N CHECK requests, one at a time, and reports
+// how long the round trips took:
+//
+//     ./client --bench 10000 /tmp/spell.sock
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SpellCheckClient.hpp"
+
+
+namespace
+{
+    void checkWords(SpellCheckClient& client, const std::vector<std::string>& words)
+    {
+        for (const std::string& word : words)
+        {
+            if (client.check(word))
+            {
+                std::cout << word << ": OK" << std::endl;
+                continue;
+            }
+
+            std::cout << word << ": misspelled; suggestions:";
+            for (const std::string& suggestion : client.suggest(word))
+            {
+                std::cout << " " << suggestion;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+
+    void forwardRequests(SpellCheckClient& client)
+    {
+        std::string line;
+        while (std::getline(std::cin, line))
+        {
+            std::cout << client.request(line) << std::endl;
+        }
+    }
+
+
+    void benchmark(SpellCheckClient& client, unsigned int count)
+    {
+        std::vector<double> microseconds;
+        microseconds.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            client.check(i % 2 == 0 ? "THE" : "TEH");
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            microseconds.push_back(elapsed.count());
+        }
+
+        if (microseconds.empty())
+        {
+            return;
+        }
+
+        std::sort(microseconds.begin(), microseconds.end());
+
+        double total = 0.0;
+        for (double us : microseconds)
+        {
+            total += us;
+        }
+
+        auto percentile = [&](double p) {
+            return microseconds[static_cast<std::size_t>(p * (microseconds.size() - 1))];
+        };
+
+        std::cout << count << " round trips: mean " << total / count << "us, median "
+                  << percentile(0.5) << "us, 99th percentile " << percentile(0.99)
+                  << "us, max " << microseconds.back() << "us" << std::endl;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args{argv + 1, argv + argc};
+
+    unsigned int benchCount = 0;
+    if (args.size() >= 2 && args[0] == "--bench")
+    {
+        benchCount = static_cast<unsigned int>(std::strtoul(args[1].c_str(), nullptr, 10));
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    if (args.empty())
+    {
+        std::cout << "usage: " << argv[0] << " [--bench N] SOCKET [WORD...]" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        SpellCheckClient client{args[0]};
+        std::vector<std::string> words{args.begin() + 1, args.end()};
+
+        if (benchCount > 0)
+        {
+            benchmark(client, benchCount);
+        }
+        else if (words.empty())
+        {
+            forwardRequests(client);
+        }
+        else
+        {
+            checkWords(client, words);
+        }
+    }
+    catch (SpellCheckClient::ClientException& e)
+    {
+        std::cout << "ERROR: " << e.reason() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
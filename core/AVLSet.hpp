@@ -20,18 +20,57 @@
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include "Set.hpp"
+#include <future>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "BatchSet.hpp"
+#include "PrefixBound.hpp"
+#include "SetSerialization.hpp"
 
 
 template <typename ElementType>
-class AVLSet : public Set<ElementType>
+class AVLSet : public BatchSet<ElementType>
 {
+private:
+    struct TreeNode;
+
 public:
     // A VisitFunction is a function that takes a reference to a const
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType&)>;
 
+    // A const_iterator walks the elements of the set in ascending order,
+    // one at a time, without visiting the whole tree up front.  It can be
+    // used with range-based for loops and the standard algorithms.
+    class const_iterator;
+    using iterator = const_iterator;
+
+    // A Range is a pair of iterators [begin, end) delimiting a contiguous
+    // run of elements in ascending order.
+    class Range;
+
+    // A preorder_iterator and a postorder_iterator walk the elements of
+    // the set in the order of a preorder or postorder traversal of the
+    // tree.  Like const_iterator, they keep their own stack of nodes, so
+    // no traversal recurses, even in a degenerate unbalanced tree.
+    class preorder_iterator;
+    class postorder_iterator;
+
+    // A Traversal is a pair of iterators [begin, end) delimiting one
+    // complete traversal of the tree.
+    template <typename Iterator>
+    class Traversal;
+
 public:
     // Initializes an AVLSet to be empty, with or without balancing.
     explicit AVLSet(bool shouldBalance = true);
@@ -70,6 +109,27 @@ public:
     virtual bool contains(const ElementType& element) const override;
 
 
+    // addMany() adds a batch of elements to the set.  When the tree is
+    // balanced, the batch is sorted, built into a perfectly balanced tree
+    // of its own in linear time, and then merged in the same way as
+    // unionWith(), rather than being inserted one rotation at a time.  An
+    // unbalanced tree adds the elements one at a time, in the order given,
+    // so that its shape is the same as if add() had been called.
+    virtual void addMany(const ElementType* elements, unsigned int count) override;
+
+
+    // containsMany() looks up a batch of elements by sorting it and then
+    // descending the tree with the whole batch at once, splitting it at
+    // each node between the two subtrees, so that the nodes near the root
+    // are compared against the batch once rather than once per element.
+    virtual void containsMany(
+        const ElementType* elements, unsigned int count,
+        std::vector<bool>& found) const override;
+
+    using BatchSet<ElementType>::addMany;
+    using BatchSet<ElementType>::containsMany;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept override;
 
@@ -96,8 +156,95 @@ public:
     // tree.
     void postorder(VisitFunction visit) const;
 
-  
-  
+
+    // These overloads of preorder(), inorder() and postorder() accept any
+    // callable directly, rather than through a VisitFunction, so that the
+    // compiler can inline the visit into the traversal loop.
+    template <typename Visitor>
+    void preorder(Visitor visit) const;
+
+    template <typename Visitor>
+    void inorder(Visitor visit) const;
+
+    template <typename Visitor>
+    void postorder(Visitor visit) const;
+
+
+    // preorderTraversal(), inorderTraversal() and postorderTraversal()
+    // return the elements in the order of the corresponding traversal,
+    // produced lazily as the returned Traversal is iterated.
+    Traversal<preorder_iterator> preorderTraversal() const;
+    Traversal<const_iterator> inorderTraversal() const;
+    Traversal<postorder_iterator> postorderTraversal() const;
+
+
+    // begin() and end() delimit all of the elements in the set, in
+    // ascending order.
+    const_iterator begin() const;
+    const_iterator end() const;
+
+
+    // lowerBound() returns an iterator positioned at the smallest element
+    // that is not less than the given one, or end() if there is no such
+    // element.  This function always runs in O(log n) time when there are
+    // n elements in the AVL tree.
+    const_iterator lowerBound(const ElementType& element) const;
+
+
+    // range() returns the elements that are at least lo and less than hi,
+    // in ascending order.  Finding the endpoints takes O(log n) time; the
+    // elements themselves are produced lazily as the range is iterated.
+    Range range(const ElementType& lo, const ElementType& hi) const;
+
+
+    // prefixRange() returns the elements that start with the given prefix,
+    // in ascending order, with the same costs as range().  It is only
+    // available when the elements are strings.
+    Range prefixRange(const ElementType& prefix) const;
+
+
+    // forEachWithPrefix() calls the given "visit" function for each of the
+    // elements that start with the given prefix, in ascending order,
+    // stopping as soon as it walks past the last one.  It is only
+    // available when the elements are strings.
+    template <typename PrefixVisitFunction>
+    void forEachWithPrefix(const ElementType& prefix, PrefixVisitFunction visit) const;
+
+
+    // unionWith(), intersectWith() and differenceWith() replace the
+    // contents of this set with its union, intersection or difference
+    // with another set.  When both sets are balanced, they split and join
+    // whole subtrees rather than adding elements one at a time, doing
+    // O(m log(n/m + 1)) work for sets of sizes m <= n, and the two halves
+    // of each large enough subproblem run in parallel on separate threads.
+    // The overloads taking an expiring set reuse its nodes instead of
+    // copying them first.  When either set is unbalanced, these fall back
+    // to adding elements one at a time, which preserves the shape that
+    // plain binary search tree insertion would give.
+    void unionWith(const AVLSet& s);
+    void unionWith(AVLSet&& s);
+    void intersectWith(const AVLSet& s);
+    void intersectWith(AVLSet&& s);
+    void differenceWith(const AVLSet& s);
+    void differenceWith(AVLSet&& s);
+
+
+    // save() writes a snapshot of the tree to the given stream: whether it
+    // is balanced, then each node in preorder, with its height and which
+    // children it has.  It throws a SnapshotException if the stream fails.
+    // Elements are written by SnapshotCodec<ElementType>.
+    void save(std::ostream& out) const;
+
+
+    // load() replaces the contents of the set with a snapshot read from
+    // the given stream, relinking the nodes into exactly the tree that was
+    // saved, so no comparisons or rotations are needed.  The set takes on
+    // the snapshot's choice of whether to balance, since the saved tree's
+    // shape depends on it.  If the snapshot can't be read, this function
+    // throws a SnapshotException and the set is left unchanged.
+    void load(std::istream& in);
+
+
 private:
     // You'll no doubt want to add member variables and "helper" member
     // functions here.
@@ -113,17 +260,179 @@ private:
   TreeNode* root;
   int sz;
   bool bal;
-  void copyOldTree(TreeNode* curr);
-  TreeNode* insertIt(TreeNode* curr, ElementType key);
-  void helpPre(VisitFunction visit, TreeNode* curr) const;
-  void helpIn(VisitFunction visit, TreeNode* curr) const;
-  void helpPos(VisitFunction visit, TreeNode* curr) const;
+  TreeNode* insertIt(TreeNode* curr, const ElementType& key, bool& inserted);
   int findH(TreeNode* curr);
   int balH(TreeNode* curr);
   int setH(TreeNode* curr);
   TreeNode* RR(TreeNode* &curr);
   TreeNode* RL(TreeNode* &curr);
-  void delChild(TreeNode* curr);
+  unsigned int delChild(TreeNode* curr);
+
+  // Subtrees at least this tall are worth handing to another thread
+  // during the set algebra; smaller ones finish faster than a thread
+  // can be started.
+  static constexpr int PARALLEL_MIN_HEIGHT = 10;
+
+  enum class Algebra
+  {
+    Union,
+    Intersection,
+    Difference
+  };
+
+  void combineWith(TreeNode* other, unsigned int otherSize, Algebra op);
+  void combineSlowly(const AVLSet& s, Algebra op);
+  TreeNode* cloneTree(const TreeNode* curr);
+  TreeNode* buildTree(const ElementType* elements, const unsigned int* order, unsigned int count);
+  TreeNode* makeNode(TreeNode* l, TreeNode* mid, TreeNode* r);
+  TreeNode* joinTrees(TreeNode* l, TreeNode* mid, TreeNode* r);
+  TreeNode* joinRight(TreeNode* l, TreeNode* mid, TreeNode* r);
+  TreeNode* joinLeft(TreeNode* l, TreeNode* mid, TreeNode* r);
+  TreeNode* joinTwo(TreeNode* l, TreeNode* r);
+  TreeNode* splitLast(TreeNode* curr, TreeNode*& last);
+  bool splitTree(TreeNode* curr, const ElementType& key, TreeNode*& l, TreeNode*& r);
+  TreeNode* unionTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted);
+  TreeNode* intersectTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted);
+  TreeNode* differenceTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted);
+  bool shouldFork(TreeNode* t1, TreeNode* t2, int forks);
+  template <typename LeftTask, typename RightTask>
+  void forkJoin(bool parallel, LeftTask left, RightTask right);
+};
+
+
+
+template <typename ElementType>
+class AVLSet<ElementType>::const_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    // A default-constructed const_iterator is equal to end().
+    const_iterator() = default;
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    bool operator==(const const_iterator& other) const noexcept;
+    bool operator!=(const const_iterator& other) const noexcept;
+
+private:
+    friend class AVLSet<ElementType>;
+
+    // The nodes on the way down from the root whose elements have not been
+    // visited yet, i.e., those we went left from, with the current node on
+    // top.  Keeping this path explicitly means that stepping forward never
+    // needs to search from the root again.  An empty path is end().
+    std::vector<const TreeNode*> path;
+
+    void pushLeftSpine(const TreeNode* curr);
+};
+
+
+
+template <typename ElementType>
+class AVLSet<ElementType>::Range
+{
+public:
+    Range(const_iterator first, const_iterator last);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool empty() const noexcept;
+
+private:
+    const_iterator first;
+    const_iterator last;
+};
+
+
+
+template <typename ElementType>
+class AVLSet<ElementType>::preorder_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    // A default-constructed preorder_iterator is the end of a traversal.
+    preorder_iterator() = default;
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    preorder_iterator& operator++();
+    preorder_iterator operator++(int);
+
+    bool operator==(const preorder_iterator& other) const noexcept;
+    bool operator!=(const preorder_iterator& other) const noexcept;
+
+private:
+    friend class AVLSet<ElementType>;
+
+    // The current node on top, with the right subtrees still waiting to be
+    // visited beneath it.
+    std::vector<const TreeNode*> pending;
+};
+
+
+
+template <typename ElementType>
+class AVLSet<ElementType>::postorder_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    // A default-constructed postorder_iterator is the end of a traversal.
+    postorder_iterator() = default;
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    postorder_iterator& operator++();
+    postorder_iterator operator++(int);
+
+    bool operator==(const postorder_iterator& other) const noexcept;
+    bool operator!=(const postorder_iterator& other) const noexcept;
+
+private:
+    friend class AVLSet<ElementType>;
+
+    // The path from the root down to the current node, which is on top.
+    // Every node on the path is visited after the subtree below it.
+    std::vector<const TreeNode*> path;
+
+    void descendToFirst(const TreeNode* curr);
+};
+
+
+
+template <typename ElementType>
+template <typename Iterator>
+class AVLSet<ElementType>::Traversal
+{
+public:
+    explicit Traversal(Iterator first);
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    Iterator first;
 };
 
 
@@ -146,20 +455,19 @@ AVLSet<ElementType>::~AVLSet() noexcept
 template <typename ElementType>
 AVLSet<ElementType>::AVLSet(const AVLSet& s)
 {
-  root = nullptr;
+  bal = s.bal;
+  root = cloneTree(s.root);
   sz = s.sz;
-  copyOldTree(s.root);
 }
 
 template <typename ElementType>
 AVLSet<ElementType>::AVLSet(AVLSet&& s) noexcept
 {
-  root = nullptr;
+  bal = s.bal;
+  root = s.root;
   sz = s.sz;
-  if(s.root)
-    {
-      copyOldTree(s.root);
-    }
+  s.root = nullptr;
+  s.sz = 0;
 }
 
 template <typename ElementType>
@@ -167,10 +475,11 @@ AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
 {
     if(this != &s)
     {
-      this->sz = s.sz;
+      TreeNode* copy = cloneTree(s.root);
       this->delChild(root);
-      root = nullptr;
-      this->copyOldTree(s.root);
+      root = copy;
+      this->sz = s.sz;
+      this->bal = s.bal;
     }
   return *this;
 }
@@ -181,10 +490,9 @@ AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
 {
   if(this != &s)
     {
-      this->sz = s.sz;
-      this->delChild(root);
-      root = nullptr;
-      this->copyOldTree(s.root);
+      std::swap(root, s.root);
+      std::swap(sz, s.sz);
+      std::swap(bal, s.bal);
     }
   return *this;
 }
@@ -199,8 +507,12 @@ bool AVLSet<ElementType>::isImplemented() const noexcept
 template <typename ElementType>
 void AVLSet<ElementType>::add(const ElementType& element)
 {
-  root = insertIt(root, element);
-  sz++;
+  bool inserted = false;
+  root = insertIt(root, element, inserted);
+  if(inserted)
+    {
+      sz++;
+    }
 }
 
 
@@ -227,6 +539,80 @@ bool AVLSet<ElementType>::contains(const ElementType& element) const
 }
 
 
+template <typename ElementType>
+void AVLSet<ElementType>::addMany(const ElementType* elements, unsigned int count)
+{
+  if(!bal)
+    {
+      BatchSet<ElementType>::addMany(elements, count);
+      return;
+    }
+
+  std::vector<unsigned int> order = impl_::batchSortedOrder(elements, count);
+  auto last = std::unique(order.begin(), order.end(), [elements](unsigned int a, unsigned int b)
+    {
+      return elements[a] == elements[b];
+    });
+  unsigned int distinct = last - order.begin();
+
+  combineWith(buildTree(elements, order.data(), distinct), distinct, Algebra::Union);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::containsMany(
+    const ElementType* elements, unsigned int count, std::vector<bool>& found) const
+{
+  found.assign(count, false);
+
+  // Each pending entry is a subtree along with the run of the sorted batch
+  // whose elements could be in it.  The runs are kept on an explicit stack,
+  // as in the iterators, so that a degenerate tree can't overflow the call
+  // stack.
+  struct Pending
+  {
+    const TreeNode* node;
+    unsigned int first;
+    unsigned int last;
+  };
+
+  std::vector<unsigned int> order = impl_::batchSortedOrder(elements, count);
+  std::vector<Pending> pending;
+  if(root && count > 0)
+    {
+      pending.push_back(Pending{root, 0, count});
+    }
+
+  while(!pending.empty())
+    {
+      Pending p = pending.back();
+      pending.pop_back();
+
+      const ElementType& key = p.node->key;
+      auto first = order.begin() + p.first;
+      auto last = order.begin() + p.last;
+      auto lower = std::lower_bound(first, last, key, [elements](unsigned int i, const ElementType& k)
+        {
+          return elements[i] < k;
+        });
+      auto upper = lower;
+      for(; upper != last && elements[*upper] == key; ++upper)
+        {
+          found[*upper] = true;
+        }
+
+      if(p.node->left && lower != first)
+        {
+          pending.push_back(Pending{p.node->left, p.first, static_cast<unsigned int>(lower - order.begin())});
+        }
+      if(p.node->right && upper != last)
+        {
+          pending.push_back(Pending{p.node->right, static_cast<unsigned int>(upper - order.begin()), p.last});
+        }
+    }
+}
+
+
 template <typename ElementType>
 unsigned int AVLSet<ElementType>::size() const noexcept
 {
@@ -242,160 +628,607 @@ int AVLSet<ElementType>::height() const
 template <typename ElementType>
 void AVLSet<ElementType>::preorder(VisitFunction visit) const
 {
-  helpPre(visit, root);
+  preorder<VisitFunction&>(visit);
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::inorder(VisitFunction visit) const
 {
-  helpIn(visit, root);
+  inorder<VisitFunction&>(visit);
 }
 
 
 template <typename ElementType>
 void AVLSet<ElementType>::postorder(VisitFunction visit) const
 {
-  helpPos(visit, root);
+  postorder<VisitFunction&>(visit);
 }
 
-//******HELPER FUNCTIONS GO HERE******//
 
 template <typename ElementType>
-void AVLSet<ElementType>::copyOldTree(TreeNode* curr)
+template <typename Visitor>
+void AVLSet<ElementType>::preorder(Visitor visit) const
 {
-  if(curr)
+  for(const ElementType& element : preorderTraversal())
     {
-      add(curr->key);
-      copyOldTree(curr->right);
-      copyOldTree(curr->left);
+      visit(element);
     }
 }
 
+
 template <typename ElementType>
-typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::insertIt(TreeNode* curr, ElementType key)
+template <typename Visitor>
+void AVLSet<ElementType>::inorder(Visitor visit) const
 {
-  if (!curr)
-    {
-      TreeNode* temp = new TreeNode(key);
-      return temp;
-    }
-  key > curr->key? curr->right = insertIt(curr->right, key): curr->left = insertIt(curr->left, key);
-  
-  if(bal) // if AVL tree -> will need to be balanced otherwise BST
+  for(const ElementType& element : *this)
     {
-      curr->height = setH(curr);
-      int numB = balH(curr);
-      if(numB > 1)
-        {
-          if(curr->left->key > key)
-            {
-              return RR(curr);
-            }
-          if(curr->left->key < key)
-            {
-              curr->left = RL(curr->left);
-              return RR(curr);
-            }
-        }
-      if(numB < -1)
-        {
-          if(curr->right->key < key)
-            {
-              return RL(curr);
-            }
-          if(curr->right->key > key)
-            {
-              curr->right = RR(curr->right);
-              return RL(curr);
-            }
-        }
+      visit(element);
     }
-  else
+}
+
+
+template <typename ElementType>
+template <typename Visitor>
+void AVLSet<ElementType>::postorder(Visitor visit) const
+{
+  for(const ElementType& element : postorderTraversal())
     {
-      curr->height = setH(curr);
+      visit(element);
     }
-  return curr;
 }
 
+
 template <typename ElementType>
-void AVLSet<ElementType>::helpPre(VisitFunction visit, TreeNode* curr)const
+typename AVLSet<ElementType>::template Traversal<typename AVLSet<ElementType>::preorder_iterator>
+AVLSet<ElementType>::preorderTraversal() const
 {
-  if(!curr)
+  preorder_iterator it;
+  if(root)
     {
-      return;
+      it.pending.reserve(root->height + 1);
+      it.pending.push_back(root);
     }
-  visit(curr->key);
-  helpPre(visit, curr->left);
-  helpPre(visit, curr->right);
+  return Traversal<preorder_iterator>{std::move(it)};
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::template Traversal<typename AVLSet<ElementType>::const_iterator>
+AVLSet<ElementType>::inorderTraversal() const
+{
+  return Traversal<const_iterator>{begin()};
 }
 
+
 template <typename ElementType>
-void AVLSet<ElementType>::helpIn(VisitFunction visit, TreeNode* curr)const
+typename AVLSet<ElementType>::template Traversal<typename AVLSet<ElementType>::postorder_iterator>
+AVLSet<ElementType>::postorderTraversal() const
 {
-   if(!curr)
+  postorder_iterator it;
+  if(root)
     {
-      return;
+      it.path.reserve(root->height + 1);
     }
-   helpIn(visit, curr->left);
-   visit(curr->key);
-   helpIn(visit, curr->right);
+  it.descendToFirst(root);
+  return Traversal<postorder_iterator>{std::move(it)};
 }
 
+
 template <typename ElementType>
-void AVLSet<ElementType>::helpPos(VisitFunction visit, TreeNode* curr)const
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::begin() const
 {
-   if(!curr)
+  const_iterator it;
+  if(root)
     {
-      return;
+      it.path.reserve(root->height + 1);
     }
-   helpPos(visit, curr->left);
-   helpPos(visit, curr->right);
-   visit(curr->key);
+  it.pushLeftSpine(root);
+  return it;
 }
 
+
 template <typename ElementType>
-int AVLSet<ElementType>::findH(TreeNode* curr)
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::end() const
 {
-  return !curr? -1: curr->height;
+  return const_iterator{};
 }
 
+
 template <typename ElementType>
-int AVLSet<ElementType>::balH(TreeNode* curr)
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::lowerBound(const ElementType& element) const
 {
-  return !curr? 0: findH(curr->left) - findH(curr->right);
+  const_iterator it;
+  TreeNode* curr = root;
+  while(curr)
+    {
+      if(curr->key < element)
+        {
+          curr = curr->right;
+        }
+      else
+        {
+          it.path.push_back(curr);
+          if(curr->key == element)
+            {
+              break;
+            }
+          curr = curr->left;
+        }
+    }
+  return it;
 }
 
+
 template <typename ElementType>
-int AVLSet<ElementType>::setH(TreeNode* curr)
+typename AVLSet<ElementType>::Range AVLSet<ElementType>::range(const ElementType& lo, const ElementType& hi) const
 {
-  return std::max(findH(curr->right), findH(curr->left))+1;
+  if(!(lo < hi))
+    {
+      return Range{end(), end()};
+    }
+  return Range{lowerBound(lo), lowerBound(hi)};
 }
-  
+
+
 template <typename ElementType>
-typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::RR(TreeNode* &curr)
+typename AVLSet<ElementType>::Range AVLSet<ElementType>::prefixRange(const ElementType& prefix) const
 {
-  TreeNode* tp1;
-  TreeNode* tp2;
-  tp1 = curr->left;
-  tp2 = tp1->right;
-  tp1->right = curr;
-  curr->left = tp2;
-  
-  curr->height = setH(curr);
-  tp1->height = setH(tp1);
-  return tp1;
+  ElementType bound;
+  if(!impl_::prefixUpperBound(prefix, bound))
+    {
+      return Range{lowerBound(prefix), end()};
+    }
+  return Range{lowerBound(prefix), lowerBound(bound)};
 }
 
+
 template <typename ElementType>
-typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::RL(TreeNode* &curr)
+template <typename PrefixVisitFunction>
+void AVLSet<ElementType>::forEachWithPrefix(const ElementType& prefix, PrefixVisitFunction visit) const
 {
-  TreeNode* tp1;
-  TreeNode* tp2;
-  tp1 = curr->right;
-  tp2 = tp1->left;
-  tp1->left = curr;
-  curr->right = tp2;
+  for(const_iterator it = lowerBound(prefix); it != end() && impl_::startsWith(*it, prefix); ++it)
+    {
+      visit(*it);
+    }
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::unionWith(const AVLSet& s)
+{
+  if(this == &s)
+    {
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Union);
+      return;
+    }
+  combineWith(cloneTree(s.root), s.size(), Algebra::Union);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::unionWith(AVLSet&& s)
+{
+  if(this == &s)
+    {
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Union);
+      return;
+    }
+  unsigned int otherSize = s.size();
+  TreeNode* other = s.root;
+  s.root = nullptr;
+  s.sz = 0;
+  combineWith(other, otherSize, Algebra::Union);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::intersectWith(const AVLSet& s)
+{
+  if(this == &s)
+    {
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Intersection);
+      return;
+    }
+  combineWith(cloneTree(s.root), s.size(), Algebra::Intersection);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::intersectWith(AVLSet&& s)
+{
+  if(this == &s)
+    {
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Intersection);
+      return;
+    }
+  unsigned int otherSize = s.size();
+  TreeNode* other = s.root;
+  s.root = nullptr;
+  s.sz = 0;
+  combineWith(other, otherSize, Algebra::Intersection);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::differenceWith(const AVLSet& s)
+{
+  if(this == &s)
+    {
+      delChild(root);
+      root = nullptr;
+      sz = 0;
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Difference);
+      return;
+    }
+  combineWith(cloneTree(s.root), s.size(), Algebra::Difference);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::differenceWith(AVLSet&& s)
+{
+  if(this == &s)
+    {
+      differenceWith(static_cast<const AVLSet&>(s));
+      return;
+    }
+  if(!bal || !s.bal)
+    {
+      combineSlowly(s, Algebra::Difference);
+      return;
+    }
+  unsigned int otherSize = s.size();
+  TreeNode* other = s.root;
+  s.root = nullptr;
+  s.sz = 0;
+  combineWith(other, otherSize, Algebra::Difference);
+}
+
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator::reference AVLSet<ElementType>::const_iterator::operator*() const
+{
+  return path.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator::pointer AVLSet<ElementType>::const_iterator::operator->() const
+{
+  return &path.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator& AVLSet<ElementType>::const_iterator::operator++()
+{
+  const TreeNode* curr = path.back();
+  path.pop_back();
+  pushLeftSpine(curr->right);
+  return *this;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::const_iterator::operator++(int)
+{
+  const_iterator old = *this;
+  ++*this;
+  return old;
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::const_iterator::operator==(const const_iterator& other) const noexcept
+{
+  if(path.empty() || other.path.empty())
+    {
+      return path.empty() && other.path.empty();
+    }
+  return path.back() == other.path.back();
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::const_iterator::operator!=(const const_iterator& other) const noexcept
+{
+  return !(*this == other);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::const_iterator::pushLeftSpine(const TreeNode* curr)
+{
+  while(curr)
+    {
+      path.push_back(curr);
+      curr = curr->left;
+    }
+}
+
+
+
+template <typename ElementType>
+AVLSet<ElementType>::Range::Range(const_iterator first, const_iterator last)
+    : first{std::move(first)}, last{std::move(last)}
+{
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::Range::begin() const
+{
+  return first;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::Range::end() const
+{
+  return last;
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::Range::empty() const noexcept
+{
+  return first == last;
+}
+
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::preorder_iterator::reference AVLSet<ElementType>::preorder_iterator::operator*() const
+{
+  return pending.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::preorder_iterator::pointer AVLSet<ElementType>::preorder_iterator::operator->() const
+{
+  return &pending.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::preorder_iterator& AVLSet<ElementType>::preorder_iterator::operator++()
+{
+  const TreeNode* curr = pending.back();
+  pending.pop_back();
+  if(curr->right)
+    {
+      pending.push_back(curr->right);
+    }
+  if(curr->left)
+    {
+      pending.push_back(curr->left);
+    }
+  return *this;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::preorder_iterator AVLSet<ElementType>::preorder_iterator::operator++(int)
+{
+  preorder_iterator old = *this;
+  ++*this;
+  return old;
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::preorder_iterator::operator==(const preorder_iterator& other) const noexcept
+{
+  if(pending.empty() || other.pending.empty())
+    {
+      return pending.empty() && other.pending.empty();
+    }
+  return pending.back() == other.pending.back();
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::preorder_iterator::operator!=(const preorder_iterator& other) const noexcept
+{
+  return !(*this == other);
+}
+
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::postorder_iterator::reference AVLSet<ElementType>::postorder_iterator::operator*() const
+{
+  return path.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::postorder_iterator::pointer AVLSet<ElementType>::postorder_iterator::operator->() const
+{
+  return &path.back()->key;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::postorder_iterator& AVLSet<ElementType>::postorder_iterator::operator++()
+{
+  const TreeNode* done = path.back();
+  path.pop_back();
+  // Finishing a left child means the parent's right subtree is next;
+  // finishing a right child means the parent itself is next.
+  if(!path.empty() && path.back()->left == done)
+    {
+      descendToFirst(path.back()->right);
+    }
+  return *this;
+}
+
+
+template <typename ElementType>
+typename AVLSet<ElementType>::postorder_iterator AVLSet<ElementType>::postorder_iterator::operator++(int)
+{
+  postorder_iterator old = *this;
+  ++*this;
+  return old;
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::postorder_iterator::operator==(const postorder_iterator& other) const noexcept
+{
+  if(path.empty() || other.path.empty())
+    {
+      return path.empty() && other.path.empty();
+    }
+  return path.back() == other.path.back();
+}
+
+
+template <typename ElementType>
+bool AVLSet<ElementType>::postorder_iterator::operator!=(const postorder_iterator& other) const noexcept
+{
+  return !(*this == other);
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::postorder_iterator::descendToFirst(const TreeNode* curr)
+{
+  while(curr)
+    {
+      path.push_back(curr);
+      curr = curr->left? curr->left: curr->right;
+    }
+}
+
+
+
+template <typename ElementType>
+template <typename Iterator>
+AVLSet<ElementType>::Traversal<Iterator>::Traversal(Iterator first)
+    : first{std::move(first)}
+{
+}
+
+
+template <typename ElementType>
+template <typename Iterator>
+Iterator AVLSet<ElementType>::Traversal<Iterator>::begin() const
+{
+  return first;
+}
+
+
+template <typename ElementType>
+template <typename Iterator>
+Iterator AVLSet<ElementType>::Traversal<Iterator>::end() const
+{
+  return Iterator{};
+}
+
+//******HELPER FUNCTIONS GO HERE******//
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::insertIt(TreeNode* curr, const ElementType& key, bool& inserted)
+{
+  if (!curr)
+    {
+      TreeNode* temp = new TreeNode(key);
+      inserted = true;
+      return temp;
+    }
+  if (curr->key == key) // already in the set, so nothing changes
+    {
+      return curr;
+    }
+  key > curr->key? curr->right = insertIt(curr->right, key, inserted): curr->left = insertIt(curr->left, key, inserted);
+  
+  if(bal) // if AVL tree -> will need to be balanced otherwise BST
+    {
+      curr->height = setH(curr);
+      int numB = balH(curr);
+      if(numB > 1)
+        {
+          if(curr->left->key > key)
+            {
+              return RR(curr);
+            }
+          if(curr->left->key < key)
+            {
+              curr->left = RL(curr->left);
+              return RR(curr);
+            }
+        }
+      if(numB < -1)
+        {
+          if(curr->right->key < key)
+            {
+              return RL(curr);
+            }
+          if(curr->right->key > key)
+            {
+              curr->right = RR(curr->right);
+              return RL(curr);
+            }
+        }
+    }
+  else
+    {
+      curr->height = setH(curr);
+    }
+  return curr;
+}
+
+template <typename ElementType>
+int AVLSet<ElementType>::findH(TreeNode* curr)
+{
+  return !curr? -1: curr->height;
+}
+
+template <typename ElementType>
+int AVLSet<ElementType>::balH(TreeNode* curr)
+{
+  return !curr? 0: findH(curr->left) - findH(curr->right);
+}
+
+template <typename ElementType>
+int AVLSet<ElementType>::setH(TreeNode* curr)
+{
+  return std::max(findH(curr->right), findH(curr->left))+1;
+}
+  
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::RR(TreeNode* &curr)
+{
+  TreeNode* tp1;
+  TreeNode* tp2;
+  tp1 = curr->left;
+  tp2 = tp1->right;
+  tp1->right = curr;
+  curr->left = tp2;
   
   curr->height = setH(curr);
   tp1->height = setH(tp1);
@@ -403,20 +1236,506 @@ typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::RL(TreeNode* &curr)
 }
 
 template <typename ElementType>
-void AVLSet<ElementType>::delChild(TreeNode* curr)
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::RL(TreeNode* &curr)
 {
-  if(curr)
+  TreeNode* tp1;
+  TreeNode* tp2;
+  tp1 = curr->right;
+  tp2 = tp1->left;
+  tp1->left = curr;
+  curr->right = tp2;
+  
+  curr->height = setH(curr);
+  tp1->height = setH(tp1);
+  return tp1;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::save(std::ostream& out) const
+{
+  SnapshotWriter writer{out};
+  writer.writeHeader("AVLS", 1);
+  writer.writeValue(static_cast<std::uint8_t>(bal));
+  writer.writeValue(static_cast<std::uint32_t>(size()));
+
+  std::vector<const TreeNode*> pending;
+  if(root)
     {
+      pending.push_back(root);
+    }
+  while(!pending.empty())
+    {
+      const TreeNode* curr = pending.back();
+      pending.pop_back();
+
+      std::uint8_t children = (curr->left ? 1 : 0) | (curr->right ? 2 : 0);
+      writer.writeValue(static_cast<std::int32_t>(curr->height));
+      writer.writeValue(children);
+      SnapshotCodec<ElementType>::write(writer, curr->key);
+
       if(curr->right)
         {
-          delChild(curr->right);
+          pending.push_back(curr->right);
+        }
+      if(curr->left)
+        {
+          pending.push_back(curr->left);
+        }
+    }
+
+  writer.flush();
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::load(std::istream& in)
+{
+  SnapshotReader reader{in};
+  reader.readHeader("AVLS", 1);
+  bool newBal = reader.readValue<std::uint8_t>() != 0;
+  std::uint32_t newSz = reader.readValue<std::uint32_t>();
+
+  // Each pending entry is a link, not yet filled in, that the next node
+  // in preorder belongs at; a node's right link is pushed before its left
+  // so that its left subtree is filled in first.
+  TreeNode* newRoot = nullptr;
+  std::vector<TreeNode**> pending;
+  if(newSz > 0)
+    {
+      pending.push_back(&newRoot);
+    }
+
+  try
+    {
+      std::uint32_t count = 0;
+      while(!pending.empty())
+        {
+          if(count == newSz)
+            {
+              throw SnapshotException{"Snapshot of an AVLSet is damaged"};
+            }
+          TreeNode** link = pending.back();
+          pending.pop_back();
+
+          int height = reader.readValue<std::int32_t>();
+          std::uint8_t children = reader.readValue<std::uint8_t>();
+          TreeNode* node = new TreeNode(SnapshotCodec<ElementType>::read(reader));
+          node->height = height;
+          *link = node;
+          count++;
+
+          if(children & 2)
+            {
+              pending.push_back(&node->right);
+            }
+          if(children & 1)
+            {
+              pending.push_back(&node->left);
+            }
+        }
+      if(count != newSz)
+        {
+          throw SnapshotException{"Snapshot of an AVLSet is damaged"};
         }
+      reader.finish();
+    }
+  catch (...)
+    {
+      delChild(newRoot);
+      throw;
+    }
+
+  delChild(root);
+  root = newRoot;
+  sz = newSz;
+  bal = newBal;
+}
+
+
+template <typename ElementType>
+unsigned int AVLSet<ElementType>::delChild(TreeNode* curr)
+{
+  unsigned int deleted = 0;
+  // Rotating each left child up until there is none leaves a node that can
+  // be deleted before moving on to its right subtree, so even a degenerate
+  // tree is torn down without recursion or an explicit stack.
+  while(curr)
+    {
       if(curr->left)
         {
-          delChild(curr->left);
+          TreeNode* l = curr->left;
+          curr->left = l->right;
+          l->right = curr;
+          curr = l;
+        }
+      else
+        {
+          TreeNode* next = curr->right;
+          delete curr;
+          curr = next;
+          deleted++;
+        }
+    }
+  return deleted;
+}
+
+
+template <typename ElementType>
+void AVLSet<ElementType>::combineWith(TreeNode* other, unsigned int otherSize, Algebra op)
+{
+  // Every node of both trees either ends up in the result or is deleted
+  // along the way, so counting deletions is enough to know the new size.
+  int forks = 0;
+  for(unsigned int cores = std::thread::hardware_concurrency(); cores > 1; cores = (cores + 1) / 2)
+    {
+      forks++;
+    }
+
+  unsigned int deleted = 0;
+  unsigned int total = size() + otherSize;
+  switch(op)
+    {
+    case Algebra::Union:
+      root = unionTrees(root, other, forks, deleted);
+      break;
+    case Algebra::Intersection:
+      root = intersectTrees(root, other, forks, deleted);
+      break;
+    default: // Algebra::Difference
+      root = differenceTrees(root, other, forks, deleted);
+      break;
+    }
+  sz = total - deleted;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::combineSlowly(const AVLSet& s, Algebra op)
+{
+  if(op == Algebra::Union)
+    {
+      s.preorder([this](const ElementType& element) { add(element); });
+      return;
+    }
+
+  bool keepShared = op == Algebra::Intersection;
+  AVLSet result{bal};
+  preorder([&](const ElementType& element)
+    {
+      if(s.contains(element) == keepShared)
+        {
+          result.add(element);
+        }
+    });
+  *this = std::move(result);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::cloneTree(const TreeNode* curr)
+{
+  // Each pending entry pairs a node of the old tree with the link, not yet
+  // filled in, that its copy belongs at, so even a degenerate tree built
+  // with balancing off is copied without recursion.
+  TreeNode* newRoot = nullptr;
+  std::vector<std::pair<const TreeNode*, TreeNode**>> pending;
+  if(curr)
+    {
+      pending.emplace_back(curr, &newRoot);
+    }
+
+  try
+    {
+      while(!pending.empty())
+        {
+          const TreeNode* from = pending.back().first;
+          TreeNode** link = pending.back().second;
+          pending.pop_back();
+
+          TreeNode* temp = new TreeNode(from->key);
+          temp->height = from->height;
+          *link = temp;
+
+          if(from->right)
+            {
+              pending.emplace_back(from->right, &temp->right);
+            }
+          if(from->left)
+            {
+              pending.emplace_back(from->left, &temp->left);
+            }
+        }
+    }
+  catch (...)
+    {
+      delChild(newRoot);
+      throw;
+    }
+  return newRoot;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::buildTree(
+    const ElementType* elements, const unsigned int* order, unsigned int count)
+{
+  // The middle element becomes the root and each half becomes a subtree,
+  // so the heights of sibling subtrees never differ by more than one.
+  if(count == 0)
+    {
+      return nullptr;
+    }
+  unsigned int mid = count / 2;
+  TreeNode* l = buildTree(elements, order, mid);
+  TreeNode* r = buildTree(elements, order + mid + 1, count - mid - 1);
+  return makeNode(l, new TreeNode(elements[order[mid]]), r);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::makeNode(TreeNode* l, TreeNode* mid, TreeNode* r)
+{
+  mid->left = l;
+  mid->right = r;
+  mid->height = setH(mid);
+  return mid;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::joinTrees(TreeNode* l, TreeNode* mid, TreeNode* r)
+{
+  // Every key in l is less than mid's and every key in r is greater.  When
+  // their heights are far apart, mid is attached partway down the taller
+  // tree's spine and the tree is rebalanced on the way back up.
+  if(findH(l) > findH(r) + 1)
+    {
+      return joinRight(l, mid, r);
+    }
+  if(findH(r) > findH(l) + 1)
+    {
+      return joinLeft(l, mid, r);
+    }
+  return makeNode(l, mid, r);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::joinRight(TreeNode* l, TreeNode* mid, TreeNode* r)
+{
+  TreeNode* c = l->right;
+  if(findH(c) <= findH(r) + 1)
+    {
+      TreeNode* temp = makeNode(c, mid, r);
+      if(findH(temp) <= findH(l->left) + 1)
+        {
+          return makeNode(l->left, l, temp);
+        }
+      temp = RR(temp);
+      temp = makeNode(l->left, l, temp);
+      return RL(temp);
+    }
+  TreeNode* temp = joinRight(c, mid, r);
+  TreeNode* joined = makeNode(l->left, l, temp);
+  return findH(temp) <= findH(l->left) + 1? joined: RL(joined);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::joinLeft(TreeNode* l, TreeNode* mid, TreeNode* r)
+{
+  TreeNode* c = r->left;
+  if(findH(c) <= findH(l) + 1)
+    {
+      TreeNode* temp = makeNode(l, mid, c);
+      if(findH(temp) <= findH(r->right) + 1)
+        {
+          return makeNode(temp, r, r->right);
+        }
+      temp = RL(temp);
+      temp = makeNode(temp, r, r->right);
+      return RR(temp);
+    }
+  TreeNode* temp = joinLeft(l, mid, c);
+  TreeNode* joined = makeNode(temp, r, r->right);
+  return findH(temp) <= findH(r->right) + 1? joined: RR(joined);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::joinTwo(TreeNode* l, TreeNode* r)
+{
+  if(!l)
+    {
+      return r;
+    }
+  TreeNode* last = nullptr;
+  TreeNode* rest = splitLast(l, last);
+  return joinTrees(rest, last, r);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::splitLast(TreeNode* curr, TreeNode*& last)
+{
+  if(!curr->right)
+    {
+      last = curr;
+      return curr->left;
+    }
+  TreeNode* rest = splitLast(curr->right, last);
+  return joinTrees(curr->left, curr, rest);
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::splitTree(TreeNode* curr, const ElementType& key, TreeNode*& l, TreeNode*& r)
+{
+  // Splits the tree into the keys less than and greater than the given
+  // one.  If the key itself is found, its node is deleted, since the
+  // caller already has a node holding the same key.
+  if(!curr)
+    {
+      l = nullptr;
+      r = nullptr;
+      return false;
+    }
+  TreeNode* currL = curr->left;
+  TreeNode* currR = curr->right;
+  if(curr->key == key)
+    {
+      delete curr;
+      l = currL;
+      r = currR;
+      return true;
+    }
+  TreeNode* temp = nullptr;
+  bool found;
+  if(key < curr->key)
+    {
+      found = splitTree(currL, key, l, temp);
+      r = joinTrees(temp, curr, currR);
+    }
+  else
+    {
+      found = splitTree(currR, key, temp, r);
+      l = joinTrees(currL, curr, temp);
+    }
+  return found;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::unionTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted)
+{
+  if(!t1)
+    {
+      return t2;
+    }
+  if(!t2)
+    {
+      return t1;
+    }
+  TreeNode* l1;
+  TreeNode* r1;
+  if(splitTree(t1, t2->key, l1, r1))
+    {
+      deleted++;
+    }
+  TreeNode* l2 = t2->left;
+  TreeNode* r2 = t2->right;
+  TreeNode* l = nullptr;
+  TreeNode* r = nullptr;
+  unsigned int deletedL = 0;
+  unsigned int deletedR = 0;
+  forkJoin(shouldFork(l1, l2, forks),
+           [&] { l = unionTrees(l1, l2, forks - 1, deletedL); },
+           [&] { r = unionTrees(r1, r2, forks - 1, deletedR); });
+  deleted += deletedL + deletedR;
+  return joinTrees(l, t2, r);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::intersectTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted)
+{
+  if(!t1 || !t2)
+    {
+      deleted += delChild(t1) + delChild(t2);
+      return nullptr;
+    }
+  TreeNode* l2;
+  TreeNode* r2;
+  bool found = splitTree(t2, t1->key, l2, r2);
+  if(found)
+    {
+      deleted++;
+    }
+  TreeNode* l1 = t1->left;
+  TreeNode* r1 = t1->right;
+  TreeNode* l = nullptr;
+  TreeNode* r = nullptr;
+  unsigned int deletedL = 0;
+  unsigned int deletedR = 0;
+  forkJoin(shouldFork(l1, l2, forks),
+           [&] { l = intersectTrees(l1, l2, forks - 1, deletedL); },
+           [&] { r = intersectTrees(r1, r2, forks - 1, deletedR); });
+  deleted += deletedL + deletedR;
+  if(found)
+    {
+      return joinTrees(l, t1, r);
+    }
+  delete t1;
+  deleted++;
+  return joinTwo(l, r);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::TreeNode* AVLSet<ElementType>::differenceTrees(TreeNode* t1, TreeNode* t2, int forks, unsigned int& deleted)
+{
+  if(!t1 || !t2)
+    {
+      deleted += delChild(t2);
+      return t1;
+    }
+  TreeNode* l1;
+  TreeNode* r1;
+  if(splitTree(t1, t2->key, l1, r1))
+    {
+      deleted++;
+    }
+  TreeNode* l2 = t2->left;
+  TreeNode* r2 = t2->right;
+  delete t2;
+  deleted++;
+  TreeNode* l = nullptr;
+  TreeNode* r = nullptr;
+  unsigned int deletedL = 0;
+  unsigned int deletedR = 0;
+  forkJoin(shouldFork(l1, l2, forks),
+           [&] { l = differenceTrees(l1, l2, forks - 1, deletedL); },
+           [&] { r = differenceTrees(r1, r2, forks - 1, deletedR); });
+  deleted += deletedL + deletedR;
+  return joinTwo(l, r);
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::shouldFork(TreeNode* t1, TreeNode* t2, int forks)
+{
+  return forks > 0 && std::min(findH(t1), findH(t2)) >= PARALLEL_MIN_HEIGHT;
+}
+
+template <typename ElementType>
+template <typename LeftTask, typename RightTask>
+void AVLSet<ElementType>::forkJoin(bool parallel, LeftTask left, RightTask right)
+{
+  if(parallel)
+    {
+      std::future<void> pending;
+      try
+        {
+          pending = std::async(std::launch::async, left);
+        }
+      catch(const std::system_error&)
+        {
+          // No thread could be started, so do the work here instead.
+          left();
+          right();
+          return;
         }
-      delete curr;   
+      right();
+      pending.get();
+      return;
     }
+  left();
+  right();
 }
 
 #endif // AVLSET_HPP
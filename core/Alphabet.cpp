@@ -0,0 +1,88 @@
+// Alphabet.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include "Alphabet.hpp"
+#include "Utf8.hpp"
+
+
+namespace
+{
+    // insertLetter() adds the given letter to the sorted letters, unless
+    // it's already there, returning true if it was added.
+    bool insertLetter(std::vector<std::string>& letters, std::string_view letter)
+    {
+        auto position = std::lower_bound(letters.begin(), letters.end(), letter);
+        if (position != letters.end() && *position == letter)
+        {
+            return false;
+        }
+
+        letters.insert(position, std::string{letter});
+        return true;
+    }
+}
+
+
+Alphabet::Alphabet()
+{
+}
+
+
+Alphabet::Alphabet(const std::vector<std::string>& words)
+{
+    for (const std::string& word : words)
+    {
+        add(word);
+    }
+}
+
+
+const Alphabet& Alphabet::english()
+{
+    static const Alphabet alphabet{std::vector<std::string>{"ABCDEFGHIJKLMNOPQRSTUVWXYZ"}};
+    return alphabet;
+}
+
+
+void Alphabet::add(std::string_view word)
+{
+    std::string upper = Utf8::toUpper(word);
+
+    for (std::size_t i = 0; i < upper.size(); i += Utf8::sequenceLength(upper, i))
+    {
+        std::string_view letter = std::string_view{upper}.substr(i, Utf8::sequenceLength(upper, i));
+        unsigned char lead = static_cast<unsigned char>(letter[0]);
+
+        if (lead > ' ' && lead != 0x7F && insertLetter(all, letter))
+        {
+            insertLetter(byLead[lead], letter);
+        }
+    }
+}
+
+
+const std::vector<std::string>& Alphabet::letters() const noexcept
+{
+    return all;
+}
+
+
+const std::vector<std::string>& Alphabet::startingWith(char lead) const noexcept
+{
+    return byLead[static_cast<unsigned char>(lead)];
+}
+
+
+bool Alphabet::contains(std::string_view letter) const noexcept
+{
+    return !letter.empty() && std::binary_search(all.begin(), all.end(), letter);
+}
+
+
+std::size_t Alphabet::size() const noexcept
+{
+    return all.size();
+}
@@ -0,0 +1,71 @@
+// Alphabet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// An Alphabet is the set of characters that suggestions are made of: the
+// letters tried when a character is inserted into a word or replaced.  The
+// original algorithms try 'A' through 'Z', which is what english() is, but
+// a German or French or Russian dictionary has letters of its own, so an
+// Alphabet can instead be built from the words of a dictionary, holding
+// every character that appears in any of them, in upper case.
+//
+// Each letter is stored as the UTF-8 string that encodes it.  They're kept
+// in order, which for UTF-8 is the same as the order of the characters
+// themselves; startingWith() gives the letters whose encoding begins with
+// a given byte, which is how a search that walks a PrefixFilter a byte at
+// a time finds the letters that can come next.
+
+#ifndef ALPHABET_HPP
+#define ALPHABET_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class Alphabet
+{
+public:
+    // Initializes an empty Alphabet.
+    Alphabet();
+
+    // Initializes an Alphabet holding every character in the given words.
+    explicit Alphabet(const std::vector<std::string>& words);
+
+
+    // english() returns the Alphabet of the letters 'A' through 'Z'.
+    static const Alphabet& english();
+
+
+    // add() adds every character of the given word, in upper case, other
+    // than spaces and control characters.
+    void add(std::string_view word);
+
+
+    // letters() returns every letter in the Alphabet, in order.
+    const std::vector<std::string>& letters() const noexcept;
+
+    // startingWith() returns the letters whose UTF-8 encoding begins with
+    // the given byte, in order.
+    const std::vector<std::string>& startingWith(char lead) const noexcept;
+
+    // contains() returns true if the given character (as UTF-8) is a
+    // letter in the Alphabet.
+    bool contains(std::string_view letter) const noexcept;
+
+
+    // size() returns the number of letters.
+    std::size_t size() const noexcept;
+
+
+private:
+    std::vector<std::string> all;
+    std::vector<std::string> byLead[256];
+};
+
+
+
+#endif // ALPHABET_HPP
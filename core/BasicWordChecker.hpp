@@ -0,0 +1,937 @@
+// BasicWordChecker.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BasicWordChecker is a WordChecker that knows the concrete type of the
+// set of words it checks against, such as HashSet<std::string> or
+// AVLSet<std::string>.  Because of that, every lookup calls that type's
+// contains() directly, rather than through the virtual Set interface,
+// which lets the compiler inline the hash or comparison into the loops
+// that generate suggestions.
+//
+// WordChecker itself is a BasicWordChecker<Set<std::string>>, which works
+// with any kind of Set but pays for a virtual call on every lookup.
+//
+// Words are UTF-8.  Every edit swaps, deletes, replaces or inserts whole
+// characters (see Utf8.hpp), never part of one, and the letters inserted
+// and replaced are those of an Alphabet: 'A' through 'Z', as originally,
+// unless the BasicWordChecker is given one built from its dictionary.
+//
+// findTopSuggestions() ranks suggestions, rather than listing all of them
+// in the order they were found.  Each family of edits has a cost (a split
+// costs two, since it takes two words to be right; every other edit costs
+// one), and suggestions are ranked by cost, then by how frequent they are
+// in a WordFrequencies table, most frequent first, then alphabetically.
+// Only the best k found so far are kept, in a heap whose root is the worst
+// of them.  Before trying a family, its best possible rank (its cost, and
+// the largest frequency of any word as long as the family's candidates
+// are) is compared against that root; once a family can't beat it, none
+// of those after it can either, so the search stops there.
+//
+// findLikelySuggestions() tries the likeliest edits first instead (see
+// LikelyEdits.hpp): swaps and deletions, then replacements and insertions
+// of adjacent keys, then words that sound alike, then sound-alike letters,
+// then every other letter, then splits, stopping as soon as it has found
+// k suggestions.  It can also be told to stop after a given tier, never
+// trying the unlikely letters at all.
+//
+// findDistance2Suggestions() finds words two edits (swaps, insertions,
+// deletions or replacements) away, not just one.  Applying every edit to
+// every one of the roughly 53n single edits of an n-letter word would mean
+// on the order of (53n)^2 lookups, so instead the single edits are
+// generated once, without duplicates, and each is edited again only where
+// the result could still be a word: the characters before a second edit
+// are left as they were, so a second edit is made only at positions where
+// everything before it begins some word in a PrefixFilter, and only with
+// letters that keep it that way.  The rest of each candidate is then run
+// through the filter too, and only a candidate that begins some word all
+// the way to its end is made into a string and looked up in the set.
+// Every candidate tried counts against a budget; when it runs out, the
+// words found so far are returned, marked incomplete.
+
+#ifndef BASICWORDCHECKER_HPP
+#define BASICWORDCHECKER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Alphabet.hpp"
+#include "LikelyEdits.hpp"
+#include "PrefixFilter.hpp"
+#include "Set.hpp"
+#include "Utf8.hpp"
+#include "WordFrequencies.hpp"
+
+
+
+namespace impl_
+{
+    // IsWordSet is true when SetT has a contains() member function that
+    // can be called on a const SetT with a std::string and returns
+    // something usable as a bool.
+    template <typename SetT, typename = void>
+    struct IsWordSet : std::false_type
+    {
+    };
+
+    template <typename SetT>
+    struct IsWordSet<SetT, std::void_t<decltype(
+        static_cast<bool>(std::declval<const SetT&>().contains(std::declval<const std::string&>())))>>
+        : std::true_type
+    {
+    };
+
+
+    // wordSetContains() asks the given set whether it contains the given
+    // word.  Unless SetT is abstract (e.g., Set<std::string> itself), the
+    // call names SetT's own contains(), which the compiler binds directly
+    // instead of dispatching through the virtual function table.
+    template <typename SetT>
+    inline bool wordSetContains(const SetT& words, const std::string& word)
+    {
+        if constexpr (std::is_abstract<SetT>::value)
+        {
+            return words.contains(word);
+        }
+        else
+        {
+            return words.SetT::contains(word);
+        }
+    }
+
+
+    // BasicWordChecker__beyondEnglish() returns true if the given letter of
+    // an Alphabet is something other than 'A' through 'Z', which the tiers
+    // of LikelyEdits don't know about.
+    inline bool BasicWordChecker__beyondEnglish(const std::string& letter)
+    {
+        return letter.size() != 1 || letter[0] < 'A' || letter[0] > 'Z';
+    }
+
+
+    // A BasicWordChecker__Ranked is a suggestion as findTopSuggestions()
+    // ranks it.  BasicWordChecker__ranksBefore() returns true if "a" ranks
+    // ahead of "b".
+    struct BasicWordChecker__Ranked
+    {
+        unsigned int cost;
+        std::uint64_t frequency;
+        std::string word;
+    };
+
+
+    inline bool BasicWordChecker__ranksBefore(
+        const BasicWordChecker__Ranked& a, const BasicWordChecker__Ranked& b)
+    {
+        if (a.cost != b.cost)
+        {
+            return a.cost < b.cost;
+        }
+        else if (a.frequency != b.frequency)
+        {
+            return a.frequency > b.frequency;
+        }
+        else
+        {
+            return a.word < b.word;
+        }
+    }
+}
+
+
+
+// A SuggestionResult is a list of suggestions, along with whether the
+// search that found them was finished, rather than cut short by a deadline
+// or a budget.
+struct SuggestionResult
+{
+    std::vector<std::string> words;
+    bool complete = false;
+};
+
+
+
+template <typename SetT>
+class BasicWordChecker
+{
+    static_assert(impl_::IsWordSet<SetT>::value,
+                  "BasicWordChecker requires a set with contains(const std::string&) const");
+
+public:
+    // The number of candidates findDistance2Suggestions() tries, unless
+    // told otherwise.
+    static constexpr std::size_t DEFAULT_CANDIDATE_BUDGET = 250000;
+
+public:
+    // The constructor requires a set of words to be passed into it.  The
+    // BasicWordChecker will store a reference to it, which it will use
+    // whenever it needs to look up a word, and to the Alphabet whose
+    // letters it inserts and replaces characters with.
+    explicit BasicWordChecker(const SetT& words, const Alphabet& alphabet = Alphabet::english());
+
+
+    // wordExists() returns true if the given word is spelled correctly,
+    // false otherwise.
+    bool wordExists(const std::string& word) const;
+
+
+    // findSuggestions() returns a vector containing suggested alternative
+    // spellings for the given word, using the five algorithms below.
+    std::vector<std::string> findSuggestions(const std::string& word) const;
+
+    // findTopSuggestions() returns at most k of the suggestions found by
+    // the five algorithms below, the best-ranked first, as described
+    // above.  (Unlike findSuggestions(), it keeps a split even when one
+    // of its words was found by another algorithm.)
+    std::vector<std::string> findTopSuggestions(
+        const std::string& word, std::size_t k, const WordFrequencies& frequencies) const;
+
+    // findLikelySuggestions() returns at most k suggestions, found by
+    // trying the likeliest edits first and stopping once it has k, as
+    // described above.  Words that sound like the given one are suggested
+    // only if a PhoneticIndex is given; letters in tiers after "widest"
+    // are never tried.
+    std::vector<std::string> findLikelySuggestions(
+        const std::string& word, std::size_t k, const PhoneticIndex* phonetic = nullptr,
+        EditTier widest = EditTier::Other) const;
+
+    // findDistance2Suggestions() returns the words, in upper case, within
+    // two edits of the given word (other than the word itself), those one
+    // edit away first, trying at most "candidateBudget" candidates, as
+    // described above.
+    SuggestionResult findDistance2Suggestions(
+        const std::string& word, const PrefixFilter& prefixes,
+        std::size_t candidateBudget = DEFAULT_CANDIDATE_BUDGET) const;
+
+    // Swapping each adjacent pair of characters in the word
+    void swapIt(const std::string& word, std::vector<std::string>& sugs) const;
+
+    // In between each pair of adjacent pair of characters in the word ( also
+    // before the first and after the last character), each letter of the
+    // Alphabet is inserted
+    void insertIt(const std::string& word, std::vector<std::string>& sugs) const;
+
+    // Deleting each character from the word
+    void deleteIt(const std::string& word, std::vector<std::string>& sugs) const;
+
+    // Replacing each character in the word with each letter of the Alphabet
+    void replaceIt(const std::string& word, std::vector<std::string>& sugs) const;
+
+    // Splitting the word into a pair of words by adding a space in between
+    // adjacent pair of characters in the word
+    void splitIt(const std::string& word, std::vector<std::string>& sugs) const;
+
+    // Replacing each character in the word with each letter in the given
+    // tier for it (see LikelyEdits.hpp)
+    void likelyReplaceIt(const std::string& word, std::vector<std::string>& sugs, EditTier tier) const;
+
+    // Inserting, at each position in the word, each letter in the given
+    // tier for the characters on either side of it
+    void likelyInsertIt(const std::string& word, std::vector<std::string>& sugs, EditTier tier) const;
+
+    // Finding the words in the given index that sound like the word, and
+    // whose length differs from it by no more than two, nearest length
+    // first
+    void soundsLikeIt(const std::string& word, std::vector<std::string>& sugs, const PhoneticIndex& phonetic) const;
+
+private:
+    const SetT& words;
+    const Alphabet& alphabet;
+};
+
+
+
+template <typename SetT>
+BasicWordChecker<SetT>::BasicWordChecker(const SetT& words, const Alphabet& alphabet)
+    : words{words}, alphabet{alphabet}
+{
+}
+
+
+template <typename SetT>
+bool BasicWordChecker<SetT>::wordExists(const std::string& word) const
+{
+    std::string temp = word;
+    Utf8::foldToUpper(temp);
+    return impl_::wordSetContains(words, temp);
+}
+
+
+template <typename SetT>
+std::vector<std::string> BasicWordChecker<SetT>::findSuggestions(const std::string& word) const
+{
+   std::vector<std::string> sug;
+   swapIt(word, sug);
+   insertIt(word, sug);
+   deleteIt(word, sug);
+   replaceIt(word, sug);
+   splitIt(word, sug);
+   return sug;
+}
+
+
+template <typename SetT>
+std::vector<std::string> BasicWordChecker<SetT>::findTopSuggestions(
+    const std::string& word, std::size_t k, const WordFrequencies& frequencies) const
+{
+    if (k == 0)
+    {
+        return {};
+    }
+
+    using Ranked = impl_::BasicWordChecker__Ranked;
+    using Edit = void (BasicWordChecker::*)(const std::string&, std::vector<std::string>&) const;
+
+    struct Family
+    {
+        Edit edit;
+        unsigned int cost;
+        std::uint64_t bestFrequency;
+    };
+
+    std::size_t length = Utf8::length(word);
+
+    Family families[] = {
+        {&BasicWordChecker::swapIt, 1, frequencies.maxFrequency(length)},
+        {&BasicWordChecker::insertIt, 1, frequencies.maxFrequency(length + 1)},
+        {&BasicWordChecker::deleteIt, 1, length > 0 ? frequencies.maxFrequency(length - 1) : 0},
+        {&BasicWordChecker::replaceIt, 1, frequencies.maxFrequency(length)},
+        {&BasicWordChecker::splitIt, 2, frequencies.maxFrequency()}
+    };
+
+    // Trying the most promising families first makes it likelier that
+    // the rest can be skipped.
+    std::stable_sort(
+        std::begin(families), std::end(families),
+        [](const Family& a, const Family& b)
+        {
+            return a.cost != b.cost ? a.cost < b.cost : a.bestFrequency > b.bestFrequency;
+        });
+
+    std::vector<Ranked> best;
+    best.reserve(k + 1);
+
+    std::vector<std::string> candidates;
+
+    for (const Family& family : families)
+    {
+        if (best.size() == k)
+        {
+            const Ranked& worst = best.front();
+            bool canBeatWorst = family.cost < worst.cost
+                || (family.cost == worst.cost && family.bestFrequency >= worst.frequency);
+
+            if (!canBeatWorst)
+            {
+                break;
+            }
+        }
+
+        candidates.clear();
+        (this->*family.edit)(word, candidates);
+
+        for (std::string& candidate : candidates)
+        {
+            // An earlier family will have found the same word at no
+            // greater cost.
+            if (std::any_of(best.begin(), best.end(), [&](const Ranked& r) { return r.word == candidate; }))
+            {
+                continue;
+            }
+
+            std::uint64_t frequency;
+            std::size_t space = candidate.find(' ');
+            if (space == std::string::npos)
+            {
+                frequency = frequencies.frequency(candidate);
+            }
+            else
+            {
+                frequency = std::min(
+                    frequencies.frequency(candidate.substr(0, space)),
+                    frequencies.frequency(candidate.substr(space + 1)));
+            }
+
+            Ranked ranked{family.cost, frequency, std::move(candidate)};
+
+            if (best.size() < k)
+            {
+                best.push_back(std::move(ranked));
+                std::push_heap(best.begin(), best.end(), impl_::BasicWordChecker__ranksBefore);
+            }
+            else if (impl_::BasicWordChecker__ranksBefore(ranked, best.front()))
+            {
+                std::pop_heap(best.begin(), best.end(), impl_::BasicWordChecker__ranksBefore);
+                best.back() = std::move(ranked);
+                std::push_heap(best.begin(), best.end(), impl_::BasicWordChecker__ranksBefore);
+            }
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end(), impl_::BasicWordChecker__ranksBefore);
+
+    std::vector<std::string> top;
+    top.reserve(best.size());
+    for (Ranked& ranked : best)
+    {
+        top.push_back(std::move(ranked.word));
+    }
+    return top;
+}
+
+
+template <typename SetT>
+std::vector<std::string> BasicWordChecker<SetT>::findLikelySuggestions(
+    const std::string& word, std::size_t k, const PhoneticIndex* phonetic, EditTier widest) const
+{
+    std::vector<std::string> sugs;
+
+    auto enough = [&]() { return sugs.size() >= k; };
+
+    if (!enough())
+    {
+        swapIt(word, sugs);
+    }
+    if (!enough())
+    {
+        deleteIt(word, sugs);
+    }
+
+    for (EditTier tier : {EditTier::Adjacent, EditTier::SoundAlike, EditTier::Other})
+    {
+        if (tier > widest)
+        {
+            break;
+        }
+
+        if (!enough())
+        {
+            likelyReplaceIt(word, sugs, tier);
+        }
+        if (!enough())
+        {
+            likelyInsertIt(word, sugs, tier);
+        }
+        if (!enough() && tier == EditTier::Adjacent && phonetic != nullptr)
+        {
+            soundsLikeIt(word, sugs, *phonetic);
+        }
+    }
+
+    if (!enough())
+    {
+        splitIt(word, sugs);
+    }
+
+    if (sugs.size() > k)
+    {
+        sugs.resize(k);
+    }
+    return sugs;
+}
+
+
+template <typename SetT>
+SuggestionResult BasicWordChecker<SetT>::findDistance2Suggestions(
+    const std::string& word, const PrefixFilter& prefixes, std::size_t candidateBudget) const
+{
+    using Range = PrefixFilter::Range;
+    using Branch = PrefixFilter::Branch;
+
+    std::string upper = Utf8::toUpper(word);
+
+    SuggestionResult result;
+    std::unordered_set<std::string> seen{upper};
+    std::size_t tried = 0;
+
+    // narrowBy() narrows the given Range, of words starting with the first
+    // "depth" bytes of some candidate, by each of the given bytes in turn,
+    // stopping as soon as it's empty.
+    auto narrowBy = [&](Range range, std::size_t depth, std::string_view rest)
+    {
+        for (std::size_t i = 0; i < rest.size() && !range.empty(); ++i)
+        {
+            range = prefixes.narrow(range, depth + i, rest[i]);
+        }
+        return range;
+    };
+
+    // Nearly every candidate starts with some of the word's own characters,
+    // so the Ranges of words starting with the word's prefixes are found
+    // once: queryRanges[j] for its first j bytes, as far as they begin any
+    // word, and queryBranches[j] (found only when first needed) for each of
+    // them followed by each byte that can follow it.
+    std::vector<Range> queryRanges{prefixes.all()};
+    while (queryRanges.size() <= upper.size() && !queryRanges.back().empty())
+    {
+        queryRanges.push_back(prefixes.narrow(queryRanges.back(), queryRanges.size() - 1, upper[queryRanges.size() - 1]));
+    }
+    if (queryRanges.back().empty())
+    {
+        queryRanges.pop_back();
+    }
+
+    std::vector<std::vector<Branch>> queryBranches(queryRanges.size());
+    std::vector<bool> queryBranchesFound(queryRanges.size(), false);
+    std::vector<Branch> otherBranches;
+
+    // branchesAt() returns the Branches from the given Range, of words
+    // starting with the first j bytes of a candidate that has the first
+    // "shared" bytes of the word in common with it.
+    auto branchesAt = [&](const Range& range, std::size_t j, std::size_t shared) -> const std::vector<Branch>&
+    {
+        if (j > shared || j >= queryRanges.size())
+        {
+            prefixes.branches(range, j, otherBranches);
+            return otherBranches;
+        }
+
+        if (!queryBranchesFound[j])
+        {
+            prefixes.branches(queryRanges[j], j, queryBranches[j]);
+            queryBranchesFound[j] = true;
+        }
+
+        return queryBranches[j];
+    };
+
+    // narrowOne() narrows the given Range, of words starting with the first
+    // j bytes of a candidate like those above, by the byte c.
+    auto narrowOne = [&](const Range& range, std::size_t j, char c, std::size_t shared)
+    {
+        if (j > shared || j >= queryRanges.size())
+        {
+            return prefixes.narrow(range, j, c);
+        }
+
+        for (const Branch& branch : branchesAt(range, j, shared))
+        {
+            if (branch.c == c)
+            {
+                return branch.range;
+            }
+        }
+
+        return Range{0, 0};
+    };
+
+    // The single edits, without duplicates, each of which is a candidate
+    // itself and is then edited again, along with the number of bytes
+    // each one has in common with the word before its edit.
+    std::vector<std::string> firstEdits;
+    std::vector<std::size_t> firstShared;
+    auto addFirstEdit = [&](std::string edit, std::size_t shared)
+    {
+        if (seen.insert(edit).second)
+        {
+            firstEdits.push_back(std::move(edit));
+            firstShared.push_back(shared);
+        }
+    };
+
+    for (std::size_t i = 0; i <= upper.size(); i += i < upper.size() ? Utf8::sequenceLength(upper, i) : 1)
+    {
+        std::size_t length = i < upper.size() ? Utf8::sequenceLength(upper, i) : 0;
+        std::string_view character = std::string_view{upper}.substr(i, length);
+        std::size_t next = i + length;
+
+        if (next < upper.size())
+        {
+            std::size_t nextLength = Utf8::sequenceLength(upper, next);
+            if (std::string_view{upper}.substr(next, nextLength) != character)
+            {
+                std::string swapped = upper;
+                std::rotate(swapped.begin() + i, swapped.begin() + next, swapped.begin() + next + nextLength);
+                addFirstEdit(std::move(swapped), i);
+            }
+        }
+        if (i < upper.size())
+        {
+            addFirstEdit(upper.substr(0, i) + upper.substr(next), i);
+        }
+        for (const std::string& letter : alphabet.letters())
+        {
+            if (i < upper.size() && letter != character)
+            {
+                std::string replaced = upper;
+                replaced.replace(i, length, letter);
+                addFirstEdit(std::move(replaced), i);
+            }
+
+            std::string inserted = upper;
+            inserted.insert(i, letter);
+            addFirstEdit(std::move(inserted), i);
+        }
+    }
+
+    for (std::size_t e = 0; e < firstEdits.size(); ++e)
+    {
+        if (tried == candidateBudget)
+        {
+            return result;
+        }
+
+        ++tried;
+        std::size_t start = std::min(firstShared[e], queryRanges.size() - 1);
+        if (!narrowBy(queryRanges[start], start, std::string_view{firstEdits[e]}.substr(start)).empty()
+            && impl_::wordSetContains(words, firstEdits[e]))
+        {
+            result.words.push_back(firstEdits[e]);
+        }
+    }
+
+    // Words two edits away are collected separately, so that they follow
+    // all of those one edit away.
+    std::vector<std::string> secondWords;
+    bool withinBudget = true;
+
+    // tryCandidate() tries a second edit, given the Range of words that
+    // start with its first "depth" bytes and the rest of its bytes,
+    // returning false if the budget has run out.  Only if the Range,
+    // narrowed by the rest of the bytes, isn't empty (and the candidate
+    // hasn't been seen before) is the candidate made into a string and
+    // looked up.
+    auto tryCandidate = [&](
+        const Range& range, std::size_t depth, std::string_view rest, auto makeCandidate)
+    {
+        if (tried == candidateBudget)
+        {
+            return false;
+        }
+        ++tried;
+
+        if (narrowBy(range, depth, rest).empty())
+        {
+            return true;
+        }
+
+        std::string candidate = makeCandidate();
+        if (seen.insert(candidate).second && impl_::wordSetContains(words, candidate))
+        {
+            secondWords.push_back(std::move(candidate));
+        }
+        return true;
+    };
+
+    // ranges[j] is the Range of words starting with the first j bytes of
+    // the edit being edited again; the edit's first ranges.size() - 1
+    // bytes begin some word, but no more of them do.
+    std::vector<Range> ranges;
+
+    for (std::size_t e = 0; e < firstEdits.size() && withinBudget; ++e)
+    {
+        const std::string& edit = firstEdits[e];
+        std::string_view view = edit;
+        std::size_t shared = firstShared[e];
+
+        std::size_t start = std::min(shared, queryRanges.size() - 1);
+        ranges.assign(queryRanges.begin(), queryRanges.begin() + start + 1);
+        while (ranges.size() <= edit.size())
+        {
+            Range next = narrowOne(ranges.back(), ranges.size() - 1, edit[ranges.size() - 1], shared);
+            if (next.empty())
+            {
+                break;
+            }
+            ranges.push_back(next);
+        }
+
+        // The second edit is made at the start of each of the edit's
+        // characters (and at its end), as far as its prefix begins a word.
+        std::size_t length = 0;
+
+        for (std::size_t j = 0; j < ranges.size() && withinBudget; j += length)
+        {
+            const Range& range = ranges[j];
+            length = j < edit.size() ? Utf8::sequenceLength(edit, j) : 1;
+            std::size_t next = j + length;
+
+            // Swapping the character at j with the one after it, or
+            // deleting it, puts the one after it at j.
+            Range shifted{0, 0};
+            std::size_t nextLength = 0;
+
+            if (next < edit.size())
+            {
+                nextLength = Utf8::sequenceLength(edit, next);
+                Range first = narrowOne(range, j, edit[next], shared);
+                shifted = narrowBy(first, j + 1, view.substr(next + 1, nextLength - 1));
+            }
+
+            if (!shifted.empty() && view.substr(next, nextLength) != view.substr(j, length))
+            {
+                std::string swapped = edit;
+                std::rotate(swapped.begin() + j, swapped.begin() + next, swapped.begin() + next + nextLength);
+                withinBudget = tryCandidate(
+                    shifted, j + nextLength, std::string_view{swapped}.substr(j + nextLength),
+                    [&] { return swapped; });
+            }
+
+            if (withinBudget && next == edit.size())
+            {
+                withinBudget = tryCandidate(range, j, {}, [&] { return edit.substr(0, j); });
+            }
+            else if (withinBudget && !shifted.empty())
+            {
+                withinBudget = tryCandidate(
+                    shifted, j + nextLength, view.substr(next + nextLength),
+                    [&] { return edit.substr(0, j) + edit.substr(next); });
+            }
+
+            // Only the letters whose first byte follows the first j bytes
+            // in some word are worth replacing the character at j with or
+            // inserting there.
+            const std::vector<Branch>& branches = branchesAt(range, j, shared);
+
+            for (std::size_t b = 0; b < branches.size() && withinBudget; ++b)
+            {
+                for (const std::string& letter : alphabet.startingWith(branches[b].c))
+                {
+                    Range chosen = narrowBy(branches[b].range, j + 1, std::string_view{letter}.substr(1));
+                    if (chosen.empty())
+                    {
+                        continue;
+                    }
+
+                    if (j < edit.size() && letter != view.substr(j, length))
+                    {
+                        withinBudget = tryCandidate(
+                            chosen, j + letter.size(), view.substr(next),
+                            [&] { std::string replaced = edit; replaced.replace(j, length, letter); return replaced; });
+                    }
+
+                    if (withinBudget)
+                    {
+                        withinBudget = tryCandidate(
+                            chosen, j + letter.size(), view.substr(j),
+                            [&] { std::string inserted = edit; inserted.insert(j, letter); return inserted; });
+                    }
+
+                    if (!withinBudget)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    result.words.insert(result.words.end(), secondWords.begin(), secondWords.end());
+    result.complete = withinBudget;
+    return result;
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::swapIt(const std::string& word, std::vector<std::string>& sugs) const
+{
+  for(std::size_t i = 0; i < word.length(); i += Utf8::sequenceLength(word, i))
+     {
+       std::size_t next = i + Utf8::sequenceLength(word, i);
+       if(next == word.length())
+         {
+           break;
+         }
+       std::string temp = word;
+       std::rotate(temp.begin() + i, temp.begin() + next, temp.begin() + next + Utf8::sequenceLength(word, next));
+       if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+         {
+           sugs.push_back(temp);
+         }
+     }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::insertIt(const std::string& word, std::vector<std::string>& sugs) const
+{
+  std::size_t len = word.length();
+  for(std::size_t i = 0; i <= len; i += i < len ? Utf8::sequenceLength(word, i) : 1)
+    {
+      for(const std::string& letter : alphabet.letters())
+      {
+        std::string temp = word;
+        temp.insert(i, letter);
+        if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+          {
+            sugs.push_back(temp);
+          }
+      }
+    }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::deleteIt(const std::string& word, std::vector<std::string>& sugs) const
+{
+  for(std::size_t i = 0; i < word.length(); i += Utf8::sequenceLength(word, i))
+    {
+      std::string temp = word;
+      temp.erase(i, Utf8::sequenceLength(word, i));
+      if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+        {
+          sugs.push_back(temp);
+        }
+    }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::replaceIt(const std::string& word, std::vector<std::string>& sugs) const
+{
+  for(std::size_t i = 0; i < word.length(); i += Utf8::sequenceLength(word, i))
+    {
+      std::size_t len = Utf8::sequenceLength(word, i);
+      for(const std::string& letter : alphabet.letters())
+        {
+          std::string temp = word;
+          temp.replace(i, len, letter);
+          if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+            {
+              sugs.push_back(temp);
+            }
+        }
+    }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::splitIt(const std::string& word, std::vector<std::string>& sugs) const
+{
+  int len = word.length()-1;
+  for(std::size_t i = 0; i < word.length() && i + Utf8::sequenceLength(word, i) < word.length();
+      i += Utf8::sequenceLength(word, i))
+    {
+      std::string temp = word;
+      std::string t1 = temp.substr(0, i);
+      std::string t2 = temp.substr(i, len);
+      if(wordExists(t1) && wordExists(t2) && std::find(sugs.begin(), sugs.end(), t1) == sugs.end() &&
+         std::find(sugs.begin(), sugs.end(), t2) == sugs.end())
+        {
+          sugs.push_back(t1 + " " + t2);
+        }
+    }
+}
+
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::likelyReplaceIt(
+    const std::string& word, std::vector<std::string>& sugs, EditTier tier) const
+{
+    std::string temp = word;
+
+    for (std::size_t i = 0; i < word.size(); i += Utf8::sequenceLength(word, i))
+    {
+        std::size_t length = Utf8::sequenceLength(word, i);
+
+        auto tryLetter = [&](std::string_view letter)
+        {
+            temp.replace(i, length, letter);
+            if (wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+            {
+                sugs.push_back(temp);
+            }
+            temp.replace(i, letter.size(), word, i, length);
+        };
+
+        for (char letter : LikelyEdits::replacements(word[i], tier))
+        {
+            tryLetter(std::string_view{&letter, 1});
+        }
+
+        // The tiers only know 'A' through 'Z'; the rest of the Alphabet's
+        // letters are as unlikely as any.
+        if (tier == EditTier::Other)
+        {
+            for (const std::string& letter : alphabet.letters())
+            {
+                if (impl_::BasicWordChecker__beyondEnglish(letter))
+                {
+                    tryLetter(letter);
+                }
+            }
+        }
+    }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::likelyInsertIt(
+    const std::string& word, std::vector<std::string>& sugs, EditTier tier) const
+{
+    std::string letters;
+    std::size_t previous = 0;
+
+    for (std::size_t i = 0; i <= word.size(); i += i < word.size() ? Utf8::sequenceLength(word, i) : 1)
+    {
+        char before = i > 0 ? word[previous] : '\0';
+        char after = i < word.size() ? word[i] : '\0';
+        LikelyEdits::insertions(before, after, tier, letters);
+
+        for (char letter : letters)
+        {
+            std::string temp = word;
+            temp.insert(i, 1, letter);
+            if (wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+            {
+                sugs.push_back(temp);
+            }
+        }
+
+        if (tier == EditTier::Other)
+        {
+            for (const std::string& letter : alphabet.letters())
+            {
+                std::string temp = word;
+                temp.insert(i, letter);
+                if (impl_::BasicWordChecker__beyondEnglish(letter) && wordExists(temp)
+                    && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
+                {
+                    sugs.push_back(temp);
+                }
+            }
+        }
+
+        previous = i;
+    }
+}
+
+
+template <typename SetT>
+void BasicWordChecker<SetT>::soundsLikeIt(
+    const std::string& word, std::vector<std::string>& sugs, const PhoneticIndex& phonetic) const
+{
+    std::string upper = Utf8::toUpper(word);
+    std::size_t wordLength = Utf8::length(word);
+
+    const std::vector<std::string>& alike = phonetic.wordsLike(word);
+
+    for (std::size_t difference = 0; difference <= 2; ++difference)
+    {
+        for (const std::string& candidate : alike)
+        {
+            std::size_t length = Utf8::length(candidate);
+            std::size_t lengthDifference = length > wordLength ? length - wordLength : wordLength - length;
+
+            if (lengthDifference == difference && candidate != upper && wordExists(candidate)
+                && std::find(sugs.begin(), sugs.end(), candidate) == sugs.end())
+            {
+                sugs.push_back(candidate);
+            }
+        }
+    }
+}
+
+
+
+#endif // BASICWORDCHECKER_HPP
@@ -0,0 +1,184 @@
+// BatchChecker.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "BatchChecker.hpp"
+#include "DocumentTokenizer.hpp"
+#include "Utf8.hpp"
+
+
+namespace
+{
+    // formatNumber() writes the decimal digits of the given number at the
+    // end of the given buffer, returning them.
+    std::string_view formatNumber(char (&digits)[20], std::size_t number)
+    {
+        char* p = digits + sizeof(digits);
+
+        do
+        {
+            *--p = static_cast<char>('0' + number % 10);
+            number /= 10;
+        }
+        while (number > 0);
+
+        return std::string_view{p, static_cast<std::size_t>(digits + sizeof(digits) - p)};
+    }
+
+
+    void appendNumber(std::string& out, std::size_t number)
+    {
+        char digits[20];
+        out += formatNumber(digits, number);
+    }
+}
+
+
+BatchOutput::BatchOutput(std::ostream& out)
+    : out{out}
+{
+    buffer.reserve(BUFFER_SIZE);
+}
+
+
+BatchOutput::~BatchOutput() noexcept
+{
+    try
+    {
+        flush();
+    }
+    catch (...)
+    {
+    }
+}
+
+
+void BatchOutput::append(std::string_view text)
+{
+    if (buffer.size() + text.size() > BUFFER_SIZE)
+    {
+        writeBuffer();
+    }
+
+    buffer.append(text.data(), text.size());
+}
+
+
+void BatchOutput::append(char c)
+{
+    if (buffer.size() == BUFFER_SIZE)
+    {
+        writeBuffer();
+    }
+
+    buffer.push_back(c);
+}
+
+
+void BatchOutput::append(std::size_t number)
+{
+    char digits[20];
+    append(formatNumber(digits, number));
+}
+
+
+bool BatchOutput::flush()
+{
+    writeBuffer();
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+
+void BatchOutput::writeBuffer()
+{
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+
+std::vector<std::string> suggestionsFor(const WordChecker& checker, const std::string& upper)
+{
+    return checker.hasFrequencies()
+        ? checker.findTopSuggestions(upper, TOP_SUGGESTIONS)
+        : checker.findSuggestions(upper);
+}
+
+
+void formatMisspelling(
+    std::string& out, std::size_t offset, std::size_t line, std::size_t column,
+    std::string_view word, const std::vector<std::string>& suggestions)
+{
+    appendNumber(out, offset);
+    out += '\t';
+    appendNumber(out, line);
+    out += ':';
+    appendNumber(out, column);
+    out += '\t';
+    out += word;
+    out += '\t';
+
+    // The same suggestion can be generated more than one way (e.g., by
+    // swapping and by replacing), but is only written once.
+    for (std::size_t i = 0; i < suggestions.size(); ++i)
+    {
+        auto previous = suggestions.begin() + i;
+        if (std::find(suggestions.begin(), previous, suggestions[i]) != previous)
+        {
+            continue;
+        }
+        if (i > 0)
+        {
+            out += ' ';
+        }
+        out += suggestions[i];
+    }
+
+    out += '\n';
+}
+
+
+double BatchStatistics::megabytesPerSecond() const noexcept
+{
+    return seconds > 0.0 ? bytes / seconds / 1e6 : 0.0;
+}
+
+
+BatchStatistics checkText(const WordChecker& checker, std::string_view text, BatchOutput& output)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    BatchStatistics stats;
+    stats.bytes = text.size();
+
+    DocumentTokenizer tokenizer{text};
+    DocumentToken token;
+    std::string upper;
+    std::string misspelling;
+
+    while (tokenizer.next(token))
+    {
+        upper.assign(token.word.data(), token.word.size());
+        Utf8::foldToUpper(upper);
+        ++stats.words;
+
+        if (!checker.wordExists(upper))
+        {
+            ++stats.misspellings;
+            misspelling.clear();
+            formatMisspelling(
+                misspelling, token.offset, token.line, token.column, token.word,
+                suggestionsFor(checker, upper));
+            output.append(misspelling);
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.seconds = elapsed.count();
+
+    return stats;
+}
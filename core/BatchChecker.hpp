@@ -0,0 +1,115 @@
+// BatchChecker.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// checkText() spell-checks a whole text at once, rather than one word at a
+// time as the interactive shell does.  Each word in the text is looked up
+// with a WordChecker, and for each one that's misspelled, one line is
+// written, giving where the word is and what might have been meant:
+//
+//     OFFSET <tab> LINE:COLUMN <tab> WORD <tab> SUGGESTION SUGGESTION ...
+//
+// where OFFSET is the byte offset of the word from the start of the text,
+// LINE and COLUMN count from 1, and the suggestions are separated by
+// spaces.  Words are found by a DocumentTokenizer; they're looked up, and
+// suggestions generated, in upper case, but written as they appear in the
+// text.  When the WordChecker has a table of word frequencies, only the
+// best TOP_SUGGESTIONS suggestions are written, best first; otherwise,
+// every suggestion is, in the order they were generated.
+//
+// Output is collected in a BatchOutput, a large buffer that is written to
+// the underlying stream only when it fills, so that each line of output
+// costs a copy into memory rather than a write (or a flush) of its own.
+
+#ifndef BATCHCHECKER_HPP
+#define BATCHCHECKER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WordChecker.hpp"
+
+
+
+class BatchOutput
+{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+public:
+    explicit BatchOutput(std::ostream& out);
+
+    // Flushes whatever is left in the buffer.  Since a destructor can't
+    // report failure, call flush() first when failure matters.
+    ~BatchOutput() noexcept;
+
+    BatchOutput(const BatchOutput& o) = delete;
+    BatchOutput& operator=(const BatchOutput& o) = delete;
+
+    // append() adds the given text or number to the buffer, writing the
+    // buffer out first if there isn't room.
+    void append(std::string_view text);
+    void append(char c);
+    void append(std::size_t number);
+
+    // flush() writes out the buffer and flushes the underlying stream,
+    // returning false if the stream has failed.
+    bool flush();
+
+private:
+    std::ostream& out;
+    std::string buffer;
+
+    void writeBuffer();
+};
+
+
+
+// BatchStatistics summarize one call to checkText().
+struct BatchStatistics
+{
+    std::size_t bytes = 0;
+    std::size_t words = 0;
+    std::size_t misspellings = 0;
+    double seconds = 0.0;
+
+    // megabytesPerSecond() returns the rate at which the text was checked,
+    // in millions of bytes per second.
+    double megabytesPerSecond() const noexcept;
+};
+
+
+
+// TOP_SUGGESTIONS is how many suggestions are written for a misspelled
+// word when they're ranked.
+constexpr std::size_t TOP_SUGGESTIONS = 10;
+
+
+// suggestionsFor() returns the suggestions to be written for the given
+// misspelled word, which is already in upper case: the best
+// TOP_SUGGESTIONS of them, from findTopSuggestions(), if the WordChecker
+// has a table of word frequencies, or else all of them, from
+// findSuggestions().
+std::vector<std::string> suggestionsFor(const WordChecker& checker, const std::string& upper);
+
+
+
+// formatMisspelling() appends the line of output describing one misspelled
+// word, as laid out above, to the given string.
+void formatMisspelling(
+    std::string& out, std::size_t offset, std::size_t line, std::size_t column,
+    std::string_view word, const std::vector<std::string>& suggestions);
+
+
+
+// checkText() checks every word in the given text, appending a line to the
+// given output for each one that's misspelled, and returns statistics
+// about the work it did.
+BatchStatistics checkText(const WordChecker& checker, std::string_view text, BatchOutput& output);
+
+
+
+#endif // BATCHCHECKER_HPP
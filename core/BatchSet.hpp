@@ -0,0 +1,161 @@
+// BatchSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BatchSet is a Set that can also add or look up many elements in one
+// call.  Doing a whole batch at once saves a virtual call per element and,
+// more importantly, lets each kind of set organize the work to suit
+// itself: a hash table can size itself once and fetch buckets ahead of
+// time, while the ordered sets can sort the batch and handle it in one
+// pass.  The versions here simply loop over the elements; HashSet, AVLSet
+// and SkipListSet override them.
+//
+// The free functions addMany() and containsMany() at the bottom accept any
+// Set, using the batch operations when the set is a BatchSet and looping
+// otherwise.
+
+#ifndef BATCHSET_HPP
+#define BATCHSET_HPP
+
+#include <algorithm>
+#include <vector>
+#include "Set.hpp"
+
+
+
+template <typename ElementType>
+class BatchSet : public Set<ElementType>
+{
+public:
+    // addMany() adds the given number of elements, starting at the given
+    // one, to the set, as though add() were called on each of them.
+    virtual void addMany(const ElementType* elements, unsigned int count);
+
+
+    // containsMany() looks up the given number of elements, starting at the
+    // given one, and stores into "found" a bitmap with one bit per element,
+    // where found[i] is true if elements[i] is in the set.
+    virtual void containsMany(
+        const ElementType* elements, unsigned int count, std::vector<bool>& found) const;
+
+
+    // These overloads accept any container whose elements are stored
+    // contiguously, such as a std::vector.
+    template <typename Container>
+    void addMany(const Container& elements);
+
+    template <typename Container>
+    std::vector<bool> containsMany(const Container& elements) const;
+};
+
+
+
+template <typename ElementType>
+void BatchSet<ElementType>::addMany(const ElementType* elements, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        this->add(elements[i]);
+    }
+}
+
+
+template <typename ElementType>
+void BatchSet<ElementType>::containsMany(
+    const ElementType* elements, unsigned int count, std::vector<bool>& found) const
+{
+    found.assign(count, false);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        found[i] = this->contains(elements[i]);
+    }
+}
+
+
+template <typename ElementType>
+template <typename Container>
+void BatchSet<ElementType>::addMany(const Container& elements)
+{
+    addMany(elements.data(), static_cast<unsigned int>(elements.size()));
+}
+
+
+template <typename ElementType>
+template <typename Container>
+std::vector<bool> BatchSet<ElementType>::containsMany(const Container& elements) const
+{
+    std::vector<bool> found;
+    containsMany(elements.data(), static_cast<unsigned int>(elements.size()), found);
+    return found;
+}
+
+
+
+namespace impl_
+{
+    // batchSortedOrder() returns the indexes of the given elements in the
+    // order that sorts the elements ascending, which the ordered sets use
+    // to work through a batch in one pass without copying the elements.
+    template <typename ElementType>
+    std::vector<unsigned int> batchSortedOrder(const ElementType* elements, unsigned int count)
+    {
+        std::vector<unsigned int> order(count);
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            order[i] = i;
+        }
+
+        std::sort(
+            order.begin(), order.end(),
+            [elements](unsigned int a, unsigned int b)
+            {
+                return elements[a] < elements[b];
+            });
+
+        return order;
+    }
+}
+
+
+
+template <typename ElementType>
+void addMany(Set<ElementType>& set, const ElementType* elements, unsigned int count)
+{
+    if (BatchSet<ElementType>* batchSet = dynamic_cast<BatchSet<ElementType>*>(&set))
+    {
+        batchSet->addMany(elements, count);
+        return;
+    }
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        set.add(elements[i]);
+    }
+}
+
+
+template <typename ElementType>
+void containsMany(
+    const Set<ElementType>& set, const ElementType* elements, unsigned int count,
+    std::vector<bool>& found)
+{
+    if (const BatchSet<ElementType>* batchSet = dynamic_cast<const BatchSet<ElementType>*>(&set))
+    {
+        batchSet->containsMany(elements, count, found);
+        return;
+    }
+
+    found.assign(count, false);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        found[i] = set.contains(elements[i]);
+    }
+}
+
+
+
+#endif // BATCHSET_HPP
@@ -0,0 +1,397 @@
+// ConcurrentQueue.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Bounded, lock-free queues for passing work between threads.
+//
+//   * An SpscQueue connects exactly one producing thread to exactly one
+//     consuming thread.  It's a ring buffer with one index written by each
+//     side, so neither side ever has to compete with another to claim a
+//     slot.
+//   * An MpmcQueue can be shared by any number of producers and consumers.
+//     Each slot carries a sequence number saying whether it's ready to be
+//     written or read, and the next slot to write (or read) is claimed with
+//     a compare-and-swap; this is Dmitry Vyukov's bounded MPMC queue.
+//
+// Both have a capacity fixed when they're created, rounded up to a power
+// of two.  tryPush() and tryPop() never wait: they return false if the
+// queue is full or empty, respectively.  push() and pop() wait until they
+// can succeed, or until the queue is closed: first spinning briefly, then
+// yielding the processor, and then sleeping with an exponential back-off
+// of up to about a millisecond, so a thread waiting on an idle queue
+// costs almost nothing but may take that long to notice new work.  After
+// close(), push() fails immediately, and pop() fails once the queue has
+// been emptied, which is how a consumer learns that there's no more work
+// coming.
+
+#ifndef CONCURRENTQUEUE_HPP
+#define CONCURRENTQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+
+
+namespace impl_
+{
+    // Indexes written by different threads are kept on separate cache
+    // lines, so that one thread's writes don't keep invalidating the line
+    // the other is reading.
+    constexpr std::size_t ConcurrentQueue__CACHE_LINE = 64;
+
+
+    inline std::size_t ConcurrentQueue__roundCapacity(std::size_t capacity)
+    {
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+
+    // ConcurrentQueue__wait() is called each time a blocking operation
+    // finds it can't proceed yet.  A short wait is usually over within a
+    // few spins, which is cheaper than giving up the processor; a longer
+    // one yields, letting other threads (perhaps the one being waited
+    // for) run.  A wait that outlasts that too, such as a consumer with no
+    // work coming, sleeps for longer and longer, up to about a
+    // millisecond at a time, so an idle thread stops burning a core.
+    constexpr unsigned int ConcurrentQueue__SPINS = 64;
+    constexpr unsigned int ConcurrentQueue__YIELDS = 64;
+    constexpr unsigned int ConcurrentQueue__MAX_SLEEP_SHIFT = 10;
+
+    inline void ConcurrentQueue__wait(unsigned int& attempts)
+    {
+        constexpr unsigned int sleepFrom = ConcurrentQueue__SPINS + ConcurrentQueue__YIELDS;
+
+        if (attempts < sleepFrom + ConcurrentQueue__MAX_SLEEP_SHIFT)
+        {
+            ++attempts;
+        }
+
+        if (attempts < ConcurrentQueue__SPINS)
+        {
+            return;
+        }
+        else if (attempts < sleepFrom)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds{1u << (attempts - sleepFrom)});
+        }
+    }
+}
+
+
+
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity);
+
+    SpscQueue(const SpscQueue& q) = delete;
+    SpscQueue& operator=(const SpscQueue& q) = delete;
+
+    std::size_t capacity() const noexcept;
+
+    // tryPush() and push() may only be called by the producing thread,
+    // tryPop() and pop() only by the consuming one.
+    bool tryPush(T& value);
+    bool push(T value);
+    bool tryPop(T& value);
+    bool pop(T& value);
+
+    // close() can be called by any thread.
+    void close() noexcept;
+    bool isClosed() const noexcept;
+
+private:
+    std::unique_ptr<T[]> slots;
+    std::size_t mask;
+
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<std::size_t> head;
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<std::size_t> tail;
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<bool> closed;
+};
+
+
+
+template <typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(std::size_t capacity);
+
+    MpmcQueue(const MpmcQueue& q) = delete;
+    MpmcQueue& operator=(const MpmcQueue& q) = delete;
+
+    std::size_t capacity() const noexcept;
+
+    // All of these can be called by any number of threads at once.
+    bool tryPush(T& value);
+    bool push(T value);
+    bool tryPop(T& value);
+    bool pop(T& value);
+
+    void close() noexcept;
+    bool isClosed() const noexcept;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<std::size_t> enqueuePosition;
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<std::size_t> dequeuePosition;
+    alignas(impl_::ConcurrentQueue__CACHE_LINE) std::atomic<bool> closed;
+};
+
+
+
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity)
+    : slots{new T[impl_::ConcurrentQueue__roundCapacity(capacity)]},
+      mask{impl_::ConcurrentQueue__roundCapacity(capacity) - 1},
+      head{0}, tail{0}, closed{false}
+{
+}
+
+
+template <typename T>
+std::size_t SpscQueue<T>::capacity() const noexcept
+{
+    return mask + 1;
+}
+
+
+template <typename T>
+bool SpscQueue<T>::tryPush(T& value)
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) > mask)
+    {
+        return false;
+    }
+
+    slots[t & mask] = std::move(value);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+
+template <typename T>
+bool SpscQueue<T>::push(T value)
+{
+    for (unsigned int attempts = 0; !isClosed(); impl_::ConcurrentQueue__wait(attempts))
+    {
+        if (tryPush(value))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename T>
+bool SpscQueue<T>::tryPop(T& value)
+{
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    value = std::move(slots[h & mask]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    for (unsigned int attempts = 0; ; impl_::ConcurrentQueue__wait(attempts))
+    {
+        // The queue is checked once more after it's seen to be closed,
+        // since it may have been pushed onto just before it was closed.
+        bool wasClosed = isClosed();
+        if (tryPop(value))
+        {
+            return true;
+        }
+        else if (wasClosed)
+        {
+            return false;
+        }
+    }
+}
+
+
+template <typename T>
+void SpscQueue<T>::close() noexcept
+{
+    closed.store(true, std::memory_order_release);
+}
+
+
+template <typename T>
+bool SpscQueue<T>::isClosed() const noexcept
+{
+    return closed.load(std::memory_order_acquire);
+}
+
+
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity)
+    : slots{new Slot[impl_::ConcurrentQueue__roundCapacity(capacity)]},
+      mask{impl_::ConcurrentQueue__roundCapacity(capacity) - 1},
+      enqueuePosition{0}, dequeuePosition{0}, closed{false}
+{
+    for (std::size_t i = 0; i <= mask; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+template <typename T>
+std::size_t MpmcQueue<T>::capacity() const noexcept
+{
+    return mask + 1;
+}
+
+
+template <typename T>
+bool MpmcQueue<T>::tryPush(T& value)
+{
+    // A slot is ready to be written at position p when its sequence number
+    // is p, and ready to be read when it's p + 1; reading it sets it to
+    // p + capacity, ready for the write a full lap later.
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        Slot& slot = slots[position & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.value = std::move(value);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+template <typename T>
+bool MpmcQueue<T>::push(T value)
+{
+    for (unsigned int attempts = 0; !isClosed(); impl_::ConcurrentQueue__wait(attempts))
+    {
+        if (tryPush(value))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename T>
+bool MpmcQueue<T>::tryPop(T& value)
+{
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        Slot& slot = slots[position & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                value = std::move(slot.value);
+                slot.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+template <typename T>
+bool MpmcQueue<T>::pop(T& value)
+{
+    for (unsigned int attempts = 0; ; impl_::ConcurrentQueue__wait(attempts))
+    {
+        bool wasClosed = isClosed();
+        if (tryPop(value))
+        {
+            return true;
+        }
+        else if (wasClosed)
+        {
+            return false;
+        }
+    }
+}
+
+
+template <typename T>
+void MpmcQueue<T>::close() noexcept
+{
+    closed.store(true, std::memory_order_release);
+}
+
+
+template <typename T>
+bool MpmcQueue<T>::isClosed() const noexcept
+{
+    return closed.load(std::memory_order_acquire);
+}
+
+
+
+#endif // CONCURRENTQUEUE_HPP
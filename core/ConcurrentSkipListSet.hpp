@@ -0,0 +1,423 @@
+// ConcurrentSkipListSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentSkipListSet is an implementation of a Set that is a skip list,
+// laid out in towers like SkipListSet, that many threads can use at once:
+// any number of threads can call add() and contains() concurrently without
+// any locking.
+//
+// Towers are linked in with compare-and-swap.  A tower is added to the set
+// the moment it's linked into level 0; after that, it's linked into its
+// higher levels one at a time, each of which only makes searches faster.
+// contains() never writes anything and never waits for another thread; it
+// simply follows forward pointers, which always lead to fully constructed
+// towers.
+//
+// Because a Set never has elements removed from it, a tower, once linked
+// in, stays linked in until the set is destroyed, so no thread can ever be
+// left holding a pointer to a tower that has been freed.  That makes the
+// usual deferred reclamation schemes (epochs, hazard pointers) unnecessary:
+// the only towers ever freed early are ones that lost a race to add the
+// same element, and those were never visible to any other thread.
+//
+// Tower heights are chosen by a fast random generator private to each
+// thread, rather than by a SkipListLevelTester, since level testers are
+// not safe to share between threads.
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "Set.hpp"
+#include "SkipListSet.hpp"
+
+
+
+template <typename ElementType>
+class ConcurrentSkipListSet : public Set<ElementType>
+{
+public:
+    // MAX_LEVELS is the most levels the skip list will ever have.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+public:
+    // Initializes a ConcurrentSkipListSet to be empty.
+    ConcurrentSkipListSet();
+
+    // Cleans up the ConcurrentSkipListSet so that it leaks no memory.  No
+    // other thread may be using the set while it's destroyed.
+    virtual ~ConcurrentSkipListSet() noexcept;
+
+    // A ConcurrentSkipListSet is shared by reference between the threads
+    // using it, so it can be neither copied nor moved.
+    ConcurrentSkipListSet(const ConcurrentSkipListSet& s) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet& s) = delete;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  It can be called from any number
+    // of threads at once, and it runs in an expected time of O(log n),
+    // plus any retries needed when other threads add elements nearby.
+    virtual void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  It can be called from any number of threads at
+    // once, including while other threads are adding; it never blocks and
+    // runs in an expected time of O(log n).
+    virtual bool contains(const ElementType& element) const override;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding, the result may lag slightly behind contains().
+    virtual unsigned int size() const noexcept override;
+
+
+    // levelCount() returns the number of levels in the skip list.
+    unsigned int levelCount() const noexcept;
+
+
+    // elementsOnLevel() returns the number of elements that are stored
+    // on the given level of the skip list, or 0 if the given level doesn't
+    // exist.  While other threads are adding, the result is approximate.
+    unsigned int elementsOnLevel(unsigned int level) const noexcept;
+
+
+    // heightOf() returns the number of levels that the given element's
+    // tower was built to occupy, or 0 if the element isn't in the set.
+    // Once every add() has finished, elementsOnLevel() for each level
+    // should count exactly the towers that are taller than that level.
+    unsigned int heightOf(const ElementType& element) const;
+
+
+private:
+    // A Tower is one element of the skip list, with its forward pointers,
+    // one per level it occupies, stored immediately after it in the same
+    // block of memory.
+    struct Tower
+    {
+        ElementType key;
+        unsigned int height;
+
+        std::atomic<Tower*>* forward() noexcept;
+        const std::atomic<Tower*>* forward() const noexcept;
+    };
+
+    using Link = std::atomic<Tower*>;
+
+    static constexpr std::size_t FORWARD_OFFSET =
+        (sizeof(Tower) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+
+    static constexpr std::size_t TOWER_ALIGNMENT =
+        alignof(Tower) > alignof(Link) ? alignof(Tower) : alignof(Link);
+
+    Link head[MAX_LEVELS];
+    std::atomic<unsigned int> levels;
+    std::atomic<unsigned int> sz;
+
+    bool findPath(const ElementType& element, unsigned int top, Link** preds, Tower** succs) const;
+    Tower* newTower(const ElementType& element, unsigned int height);
+    static void deleteTower(Tower* tower) noexcept;
+    static unsigned int randomHeight() noexcept;
+};
+
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet()
+    : levels{1}, sz{0}
+{
+    for (Link& link : head)
+    {
+        link.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::~ConcurrentSkipListSet() noexcept
+{
+    Tower* tower = head[0].load(std::memory_order_acquire);
+
+    while (tower != nullptr)
+    {
+        Tower* next = tower->forward()[0].load(std::memory_order_relaxed);
+        deleteTower(tower);
+        tower = next;
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::add(const ElementType& element)
+{
+    Link* preds[MAX_LEVELS];
+    Tower* succs[MAX_LEVELS];
+
+    unsigned int height = randomHeight();
+    unsigned int top = std::max(height, levels.load(std::memory_order_acquire));
+    Tower* tower = nullptr;
+
+    // Link the tower into level 0 first; once that succeeds, the element is
+    // in the set.  If another thread changed the spot in the meantime,
+    // search again, which also catches another thread adding the same
+    // element first.
+    while (true)
+    {
+        if (findPath(element, top, preds, succs))
+        {
+            if (tower != nullptr)
+            {
+                deleteTower(tower);
+            }
+
+            return;
+        }
+
+        if (tower == nullptr)
+        {
+            tower = newTower(element, height);
+        }
+
+        for (unsigned int level = 0; level < height; ++level)
+        {
+            tower->forward()[level].store(succs[level], std::memory_order_relaxed);
+        }
+
+        Tower* expected = succs[0];
+
+        if (preds[0][0].compare_exchange_strong(
+                expected, tower, std::memory_order_release, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    sz.fetch_add(1, std::memory_order_relaxed);
+
+    // Now link the higher levels.  The tower's forward pointer on a level
+    // can still be changed here, because no other thread can reach the
+    // tower on that level until it's linked in; it's stored again before
+    // every attempt, since a search after a failed attempt may have found
+    // new successors on this level and every level above it.
+    for (unsigned int level = 1; level < height; ++level)
+    {
+        while (true)
+        {
+            Tower* expected = succs[level];
+            tower->forward()[level].store(expected, std::memory_order_relaxed);
+
+            if (preds[level][level].compare_exchange_strong(
+                    expected, tower, std::memory_order_release, std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            findPath(element, top, preds, succs);
+        }
+    }
+
+    unsigned int currentLevels = levels.load(std::memory_order_relaxed);
+
+    while (currentLevels < height
+           && !levels.compare_exchange_weak(currentLevels, height, std::memory_order_release))
+    {
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    const Link* fwd = head;
+
+    for (unsigned int level = levels.load(std::memory_order_acquire); level-- > 0; )
+    {
+        Tower* next = fwd[level].load(std::memory_order_acquire);
+
+        while (next != nullptr && next->key < element)
+        {
+            fwd = next->forward();
+            next = fwd[level].load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr && next->key == element)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::size() const noexcept
+{
+    return sz.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::levelCount() const noexcept
+{
+    return levels.load(std::memory_order_acquire);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+{
+    if (level >= MAX_LEVELS)
+    {
+        return 0;
+    }
+
+    unsigned int count = 0;
+
+    for (Tower* tower = head[level].load(std::memory_order_acquire); tower != nullptr;
+         tower = tower->forward()[level].load(std::memory_order_acquire))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::heightOf(const ElementType& element) const
+{
+    const Link* fwd = head;
+
+    for (unsigned int level = levels.load(std::memory_order_acquire); level-- > 0; )
+    {
+        Tower* next = fwd[level].load(std::memory_order_acquire);
+
+        while (next != nullptr && next->key < element)
+        {
+            fwd = next->forward();
+            next = fwd[level].load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr && next->key == element)
+        {
+            return next->height;
+        }
+    }
+
+    return 0;
+}
+
+
+template <typename ElementType>
+std::atomic<typename ConcurrentSkipListSet<ElementType>::Tower*>*
+ConcurrentSkipListSet<ElementType>::Tower::forward() noexcept
+{
+    return reinterpret_cast<Link*>(reinterpret_cast<char*>(this) + FORWARD_OFFSET);
+}
+
+
+template <typename ElementType>
+const std::atomic<typename ConcurrentSkipListSet<ElementType>::Tower*>*
+ConcurrentSkipListSet<ElementType>::Tower::forward() const noexcept
+{
+    return reinterpret_cast<const Link*>(reinterpret_cast<const char*>(this) + FORWARD_OFFSET);
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::findPath(
+    const ElementType& element, unsigned int top, Link** preds, Tower** succs) const
+{
+    // preds[level] is the forward array holding the link that a new tower
+    // would replace on that level, and succs[level] is the tower that link
+    // pointed to when we looked.
+    Link* fwd = const_cast<Link*>(head);
+
+    for (unsigned int level = top; level-- > 0; )
+    {
+        Tower* next = fwd[level].load(std::memory_order_acquire);
+
+        while (next != nullptr && next->key < element)
+        {
+            fwd = next->forward();
+            next = fwd[level].load(std::memory_order_acquire);
+        }
+
+        preds[level] = fwd;
+        succs[level] = next;
+    }
+
+    return succs[0] != nullptr && succs[0]->key == element;
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Tower* ConcurrentSkipListSet<ElementType>::newTower(
+    const ElementType& element, unsigned int height)
+{
+    void* block = ::operator new(FORWARD_OFFSET + height * sizeof(Link), std::align_val_t{TOWER_ALIGNMENT});
+    Tower* tower;
+
+    try
+    {
+        tower = new (block) Tower{element, height};
+    }
+    catch (...)
+    {
+        ::operator delete(block, std::align_val_t{TOWER_ALIGNMENT});
+        throw;
+    }
+
+    Link* towerForward = tower->forward();
+
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        new (&towerForward[level]) Link{nullptr};
+    }
+
+    return tower;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::deleteTower(Tower* tower) noexcept
+{
+    tower->~Tower();
+    ::operator delete(static_cast<void*>(tower), std::align_val_t{TOWER_ALIGNMENT});
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::randomHeight() noexcept
+{
+    // Each thread runs its own generator, the same one used by
+    // FastRandomSkipListLevelTester, seeded differently by drawing from a
+    // shared counter once per thread.
+    static std::atomic<std::uint64_t> seeds{0};
+    thread_local std::uint64_t state =
+        impl_::skipListMix(seeds.fetch_add(1, std::memory_order_relaxed));
+
+    return impl_::skipListHeightFromBits(impl_::skipListNextRandom(state), MAX_LEVELS);
+}
+
+
+
+#endif // CONCURRENTSKIPLISTSET_HPP
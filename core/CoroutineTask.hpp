@@ -0,0 +1,379 @@
+// CoroutineTask.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A Task<T> is a C++20 coroutine that computes a T a piece at a time,
+// giving control back to whoever is running it at each "co_await
+// yieldNow()", so that one thread can interleave many long computations
+// (say, generating suggestions for many requests) rather than finishing
+// each before starting the next.  A TaskScheduler does that interleaving,
+// resuming each of its tasks in turn until all of them are finished.
+//
+// Tasks can await other tasks.  The awaited task runs as part of the one
+// awaiting it, and its yields are yields of the whole chain: the scheduler
+// sees one task, and resuming it resumes whichever coroutine in the chain
+// yielded last.  (Each task records the outermost task of its chain, its
+// "root", and the root records the innermost coroutine that's suspended,
+// its "leaf".)
+//
+// A task doesn't start running until it's first resumed, either by a
+// scheduler or by being awaited.  Exceptions thrown by a task are rethrown
+// where it's awaited, or by result().
+//
+// All of this requires compiler support for coroutines; in a build
+// without it (e.g., one compiled as C++17), this header declares nothing,
+// and ICS46_HAS_COROUTINES is left undefined.
+
+#ifndef COROUTINETASK_HPP
+#define COROUTINETASK_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define ICS46_HAS_COROUTINES 1
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+
+namespace impl_
+{
+    struct Task__PromiseBase
+    {
+        // The coroutine to resume when this one finishes, if it was
+        // awaited by one.
+        std::coroutine_handle<> continuation;
+
+        // The outermost task of the chain this one belongs to, and, on
+        // that task only, the coroutine to resume next.
+        Task__PromiseBase* root = this;
+        std::coroutine_handle<> leaf;
+
+        std::exception_ptr exception;
+
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept
+            {
+                Task__PromiseBase& promise = finished.promise();
+                if (promise.continuation)
+                {
+                    promise.root->leaf = promise.continuation;
+                    return promise.continuation;
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() noexcept
+            {
+            }
+        };
+
+
+        FinalAwaiter final_suspend() noexcept
+        {
+            return {};
+        }
+
+
+        void unhandled_exception() noexcept
+        {
+            exception = std::current_exception();
+        }
+    };
+}
+
+
+
+// yieldNow() returns an awaitable that suspends the task awaiting it,
+// along with every task awaiting that one, until it's next resumed.
+struct YieldAwaiter
+{
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> yielding) noexcept
+    {
+        yielding.promise().root->leaf = yielding;
+    }
+
+    void await_resume() noexcept
+    {
+    }
+};
+
+
+inline YieldAwaiter yieldNow() noexcept
+{
+    return {};
+}
+
+
+
+template <typename T>
+class Task
+{
+public:
+    struct promise_type : impl_::Task__PromiseBase
+    {
+        std::optional<T> value;
+
+        Task get_return_object()
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        template <typename U>
+        void return_value(U&& u)
+        {
+            value.emplace(std::forward<U>(u));
+        }
+    };
+
+public:
+    Task() noexcept = default;
+    ~Task() noexcept;
+
+    // A Task owns its coroutine, so it can be moved, but not copied.
+    Task(const Task& t) = delete;
+    Task(Task&& t) noexcept;
+    Task& operator=(const Task& t) = delete;
+    Task& operator=(Task&& t) noexcept;
+
+    // done() returns true once the task has finished.
+    bool done() const noexcept;
+
+    // resume() runs the task until it next yields or finishes.  It may
+    // only be called on a task that isn't being awaited by another.
+    void resume();
+
+    // result() returns the task's value once it's finished, or rethrows
+    // the exception that finished it.
+    T& result();
+
+    // Awaiting a task runs it (as part of the awaiting task) until it's
+    // finished, then gives its value.
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> awaited;
+
+        bool await_ready() noexcept;
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept;
+
+        T& await_resume();
+    };
+
+    Awaiter operator co_await() noexcept;
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+
+    std::coroutine_handle<promise_type> handle;
+
+    friend class TaskScheduler;
+};
+
+
+
+// A TaskScheduler runs any number of tasks, of any types, round-robin:
+// each is resumed in turn, yielding back to the scheduler, until all are
+// finished.  The tasks aren't owned by the scheduler, and must outlive
+// their run.
+class TaskScheduler
+{
+public:
+    template <typename T>
+    void schedule(Task<T>& task);
+
+    // runOnce() resumes each unfinished task once, returning the number
+    // still unfinished.
+    std::size_t runOnce();
+
+    // run() resumes the tasks until they're all finished.
+    void run();
+
+private:
+    struct Entry
+    {
+        std::coroutine_handle<> handle;
+        impl_::Task__PromiseBase* promise;
+    };
+
+    std::vector<Entry> tasks;
+};
+
+
+
+template <typename T>
+Task<T>::Task(std::coroutine_handle<promise_type> handle) noexcept
+    : handle{handle}
+{
+}
+
+
+template <typename T>
+Task<T>::~Task() noexcept
+{
+    if (handle)
+    {
+        handle.destroy();
+    }
+}
+
+
+template <typename T>
+Task<T>::Task(Task&& t) noexcept
+    : handle{std::exchange(t.handle, nullptr)}
+{
+}
+
+
+template <typename T>
+Task<T>& Task<T>::operator=(Task&& t) noexcept
+{
+    std::swap(handle, t.handle);
+    return *this;
+}
+
+
+template <typename T>
+bool Task<T>::done() const noexcept
+{
+    return !handle || handle.done();
+}
+
+
+template <typename T>
+void Task<T>::resume()
+{
+    if (done())
+    {
+        return;
+    }
+
+    impl_::Task__PromiseBase& promise = handle.promise();
+    std::coroutine_handle<> next = promise.leaf ? promise.leaf : handle;
+    next.resume();
+}
+
+
+template <typename T>
+T& Task<T>::result()
+{
+    promise_type& promise = handle.promise();
+    if (promise.exception)
+    {
+        std::rethrow_exception(promise.exception);
+    }
+    return *promise.value;
+}
+
+
+template <typename T>
+typename Task<T>::Awaiter Task<T>::operator co_await() noexcept
+{
+    return Awaiter{handle};
+}
+
+
+template <typename T>
+bool Task<T>::Awaiter::await_ready() noexcept
+{
+    return awaited.done();
+}
+
+
+template <typename T>
+template <typename Promise>
+std::coroutine_handle<> Task<T>::Awaiter::await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+{
+    impl_::Task__PromiseBase& promise = awaited.promise();
+    promise.continuation = awaiting;
+    promise.root = awaiting.promise().root;
+    promise.root->leaf = awaited;
+    return awaited;
+}
+
+
+template <typename T>
+T& Task<T>::Awaiter::await_resume()
+{
+    promise_type& promise = awaited.promise();
+    if (promise.exception)
+    {
+        std::rethrow_exception(promise.exception);
+    }
+    return *promise.value;
+}
+
+
+
+template <typename T>
+void TaskScheduler::schedule(Task<T>& task)
+{
+    if (!task.done())
+    {
+        tasks.push_back(Entry{task.handle, &task.handle.promise()});
+    }
+}
+
+
+inline std::size_t TaskScheduler::runOnce()
+{
+    std::size_t unfinished = 0;
+
+    for (Entry& entry : tasks)
+    {
+        if (entry.handle.done())
+        {
+            continue;
+        }
+
+        std::coroutine_handle<> next = entry.promise->leaf ? entry.promise->leaf : entry.handle;
+        next.resume();
+
+        if (!entry.handle.done())
+        {
+            tasks[unfinished++] = entry;
+        }
+    }
+
+    tasks.resize(unfinished);
+    return unfinished;
+}
+
+
+inline void TaskScheduler::run()
+{
+    while (runOnce() > 0)
+    {
+    }
+}
+
+
+
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif // COROUTINETASK_HPP
@@ -0,0 +1,233 @@
+// DocumentTokenizer.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DocumentTokenizer.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+    std::string describeError(const std::string& what, const std::string& path)
+    {
+        return what + " " + path + ": " + std::strerror(errno);
+    }
+
+
+    // Every byte of a multi-byte UTF-8 sequence is at least 0x80, so
+    // counting those as letters keeps accented and non-Latin letters in
+    // their words.
+    bool isLetter(char c)
+    {
+        return static_cast<unsigned char>((c | 0x20) - 'a') < 26 || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+
+    // classify() builds the letter, apostrophe and newline masks for the
+    // 64 bytes beginning at p.
+    void classify(
+        const char* p, std::uint64_t& letters, std::uint64_t& apostrophes,
+        std::uint64_t& newlines)
+    {
+        letters = 0;
+        apostrophes = 0;
+        newlines = 0;
+
+#if defined(__SSE2__)
+        // A byte is a letter if, once its 0x20 bit is set (folding upper
+        // case onto lower), it's between 'a' and 'z'.  SSE2 only compares
+        // signed bytes, so the range is shifted to begin at -128, after
+        // which one "less than" comparison tests both ends of it.  A byte
+        // of 0x80 or more is also a letter, and its high bit is exactly
+        // what _mm_movemask_epi8() collects.
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i shift = _mm_set1_epi8(static_cast<char>(0x80 - 'a'));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i apostrophe = _mm_set1_epi8('\'');
+        const __m128i newline = _mm_set1_epi8('\n');
+
+        for (unsigned int i = 0; i < 64; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i shifted = _mm_add_epi8(_mm_or_si128(bytes, caseBit), shift);
+
+            letters |= std::uint64_t{static_cast<std::uint16_t>(
+                _mm_movemask_epi8(_mm_or_si128(_mm_cmplt_epi8(shifted, limit), bytes)))} << i;
+            apostrophes |= std::uint64_t{static_cast<std::uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, apostrophe)))} << i;
+            newlines |= std::uint64_t{static_cast<std::uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))} << i;
+        }
+#else
+        for (unsigned int i = 0; i < 64; ++i)
+        {
+            letters |= std::uint64_t{isLetter(p[i])} << i;
+            apostrophes |= std::uint64_t{p[i] == '\''} << i;
+            newlines |= std::uint64_t{p[i] == '\n'} << i;
+        }
+#endif
+    }
+}
+
+
+MappedDocument::DocumentException::DocumentException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& MappedDocument::DocumentException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+MappedDocument::MappedDocument(const std::string& path)
+    : mapping{nullptr}, mappingSize{0}
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw DocumentException{describeError("Cannot open", path)};
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0)
+    {
+        std::string reason = describeError("Cannot examine", path);
+        ::close(fd);
+        throw DocumentException{reason};
+    }
+
+    // An empty file can't be mapped, but there's nothing in it to map.
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size == 0)
+    {
+        ::close(fd);
+        return;
+    }
+
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    std::string reason = describeError("Cannot map", path);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        throw DocumentException{reason};
+    }
+
+    mapping = p;
+    mappingSize = size;
+
+    // A document is read once from beginning to end, so the kernel can
+    // read well ahead of where it's being tokenized.
+    ::madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+}
+
+
+MappedDocument::~MappedDocument() noexcept
+{
+    unmap();
+}
+
+
+MappedDocument::MappedDocument(MappedDocument&& d) noexcept
+    : mapping{d.mapping}, mappingSize{d.mappingSize}
+{
+    d.mapping = nullptr;
+    d.mappingSize = 0;
+}
+
+
+MappedDocument& MappedDocument::operator=(MappedDocument&& d) noexcept
+{
+    std::swap(mapping, d.mapping);
+    std::swap(mappingSize, d.mappingSize);
+    return *this;
+}
+
+
+std::string_view MappedDocument::text() const noexcept
+{
+    return std::string_view{static_cast<const char*>(mapping), mappingSize};
+}
+
+
+void MappedDocument::unmap() noexcept
+{
+    if (mapping)
+    {
+        ::munmap(mapping, mappingSize);
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+
+DocumentTokenizer::DocumentTokenizer(std::string_view text) noexcept
+    : text{text}, line{1}, lineStart{0},
+      blockBase{0}, starts{0}, ends{0}, newlines{0},
+      previousLetter{0}, previousWord{0}, wordStart{std::string_view::npos}
+{
+    loadBlock(0);
+}
+
+
+bool DocumentTokenizer::loadBlock(std::size_t base) noexcept
+{
+    if (base >= text.size())
+    {
+        return false;
+    }
+
+    blockBase = base;
+
+    // The last block is usually short; rather than reading past the end of
+    // the text, it's copied into a buffer padded with zeroes, which are
+    // neither letters, apostrophes nor newlines.
+    std::uint64_t letters;
+    std::uint64_t apostrophes;
+
+    if (text.size() - base >= BLOCK_SIZE)
+    {
+        classify(text.data() + base, letters, apostrophes, newlines);
+    }
+    else
+    {
+        char padded[BLOCK_SIZE] = {};
+        std::memcpy(padded, text.data() + base, text.size() - base);
+        classify(padded, letters, apostrophes, newlines);
+    }
+
+    // An apostrophe is part of a word when there are letters on both
+    // sides of it, which, at the edges of the block, means looking at the
+    // blocks on either side.
+    std::uint64_t nextLetter =
+        base + BLOCK_SIZE < text.size() && isLetter(text[base + BLOCK_SIZE]);
+    std::uint64_t letterBefore = (letters << 1) | previousLetter;
+    std::uint64_t letterAfter = (letters >> 1) | (nextLetter << 63);
+    std::uint64_t word = letters | (apostrophes & letterBefore & letterAfter);
+
+    // A word starts where a byte is part of one and the byte before it
+    // isn't, and ends (just past its last byte) where the reverse is true.
+    std::uint64_t wordBefore = (word << 1) | previousWord;
+    starts = word & ~wordBefore;
+    ends = ~word & wordBefore;
+
+    previousLetter = letters >> 63;
+    previousWord = word >> 63;
+
+    return true;
+}
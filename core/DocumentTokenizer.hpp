@@ -0,0 +1,247 @@
+// DocumentTokenizer.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DocumentTokenizer splits a text into words, yielding each one as a
+// std::string_view into the text itself, along with where it was found,
+// so that nothing is copied as a document is read.  A word is a run of
+// letters, possibly with apostrophes between them (as in "DON'T").  Any
+// byte of a multi-byte UTF-8 character counts as a letter, so "CAFÉ" is
+// one word; punctuation outside ASCII, such as a dash, does too, so
+// words joined by one are taken as a single word.
+//
+// Rather than examining the text one character at a time, the tokenizer
+// classifies it 64 bytes at a time (using SSE2 where it's available),
+// building bit masks of which bytes are letters, apostrophes and newlines.
+// From those, a few shifts and logical operations give a mask of where
+// words start and another of where they end, after which each word is
+// found by clearing the lowest set bit of each; there's no branching on
+// the text's individual characters, whose outcome a processor could only
+// guess at.
+//
+// A MappedDocument maps a file into memory, so that a DocumentTokenizer
+// can read it where it lies, without it first being read into a buffer.
+
+#ifndef DOCUMENTTOKENIZER_HPP
+#define DOCUMENTTOKENIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+
+class MappedDocument
+{
+public:
+    // A DocumentException is thrown when a document can't be opened or
+    // mapped.
+    class DocumentException
+    {
+    public:
+        explicit DocumentException(const std::string& reason);
+
+        const std::string& reason() const noexcept;
+
+    private:
+        std::string reason_;
+    };
+
+public:
+    // Opens and maps the file with the given path, throwing a
+    // DocumentException if that fails.
+    explicit MappedDocument(const std::string& path);
+
+    // Unmaps the file.
+    ~MappedDocument() noexcept;
+
+    // A MappedDocument can be moved, but not copied; a moved-from one is
+    // empty.
+    MappedDocument(const MappedDocument& d) = delete;
+    MappedDocument(MappedDocument&& d) noexcept;
+    MappedDocument& operator=(const MappedDocument& d) = delete;
+    MappedDocument& operator=(MappedDocument&& d) noexcept;
+
+    // text() returns the contents of the file.  It remains valid for as
+    // long as the MappedDocument does.
+    std::string_view text() const noexcept;
+
+private:
+    void* mapping;
+    std::size_t mappingSize;
+
+    void unmap() noexcept;
+};
+
+
+
+// A DocumentToken is one word found by a DocumentTokenizer.  The offset
+// is in bytes from the start of the text; line and column count from 1.
+struct DocumentToken
+{
+    std::string_view word;
+    std::size_t offset;
+    std::size_t line;
+    std::size_t column;
+};
+
+
+
+class DocumentTokenizer
+{
+public:
+    static constexpr std::size_t BLOCK_SIZE = 64;
+
+public:
+    // Prepares to tokenize the given text, which must outlive the
+    // tokenizer (and the tokens it yields).
+    explicit DocumentTokenizer(std::string_view text) noexcept;
+
+    // next() stores the next word in the text into "token" and returns
+    // true, or returns false if there are no more words.
+    bool next(DocumentToken& token) noexcept;
+
+private:
+    std::string_view text;
+    std::size_t line;
+    std::size_t lineStart;
+
+    // The block of text most recently classified, in whose masks bit i
+    // describes the byte at blockBase + i.  The bits of starts, ends and
+    // newlines are cleared as they're used.
+    std::size_t blockBase;
+    std::uint64_t starts;
+    std::uint64_t ends;
+    std::uint64_t newlines;
+
+    // Whether the last byte of the previous block was a letter, and
+    // whether it was part of a word, as 0 or 1.
+    std::uint64_t previousLetter;
+    std::uint64_t previousWord;
+
+    // Where the word being found began, or npos if none has.
+    std::size_t wordStart;
+
+    bool loadBlock(std::size_t base) noexcept;
+    void countLines(std::uint64_t mask) noexcept;
+    void makeToken(DocumentToken& token, std::size_t end) noexcept;
+};
+
+
+
+namespace impl_
+{
+    inline unsigned int DocumentTokenizer__lowestBit(std::uint64_t mask)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(mask);
+#else
+        unsigned int i = 0;
+        for (; (mask & 1) == 0; mask >>= 1)
+        {
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+
+    inline unsigned int DocumentTokenizer__highestBit(std::uint64_t mask)
+    {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(mask);
+#else
+        unsigned int i = 0;
+        for (; mask > 1; mask >>= 1)
+        {
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+
+    inline unsigned int DocumentTokenizer__countBits(std::uint64_t mask)
+    {
+#if defined(__GNUC__)
+        return __builtin_popcountll(mask);
+#else
+        unsigned int count = 0;
+        for (; mask != 0; mask &= mask - 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+}
+
+
+inline bool DocumentTokenizer::next(DocumentToken& token) noexcept
+{
+    for (;;)
+    {
+        if (wordStart == std::string_view::npos && starts != 0)
+        {
+            // Newlines are counted as they're passed over, which they only
+            // ever are between words.
+            unsigned int start = impl_::DocumentTokenizer__lowestBit(starts);
+            std::uint64_t before = (std::uint64_t{1} << start) - 1;
+            countLines(newlines & before);
+            newlines &= ~before;
+
+            wordStart = blockBase + start;
+            starts &= starts - 1;
+        }
+
+        if (wordStart != std::string_view::npos && ends != 0)
+        {
+            makeToken(token, blockBase + impl_::DocumentTokenizer__lowestBit(ends));
+            ends &= ends - 1;
+            return true;
+        }
+
+        countLines(newlines);
+
+        if (!loadBlock(blockBase + BLOCK_SIZE))
+        {
+            // A word only runs into the end of the text when the text's
+            // length is a multiple of the block size; otherwise, the
+            // padding after it ends the word.
+            if (wordStart == std::string_view::npos)
+            {
+                return false;
+            }
+
+            makeToken(token, text.size());
+            return true;
+        }
+    }
+}
+
+
+inline void DocumentTokenizer::countLines(std::uint64_t mask) noexcept
+{
+    if (mask != 0)
+    {
+        line += impl_::DocumentTokenizer__countBits(mask);
+        lineStart = blockBase + impl_::DocumentTokenizer__highestBit(mask) + 1;
+    }
+}
+
+
+inline void DocumentTokenizer::makeToken(DocumentToken& token, std::size_t end) noexcept
+{
+    token.word = text.substr(wordStart, end - wordStart);
+    token.offset = wordStart;
+    token.line = line;
+    token.column = wordStart - lineStart + 1;
+
+    wordStart = std::string_view::npos;
+}
+
+
+
+#endif // DOCUMENTTOKENIZER_HPP
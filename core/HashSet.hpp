@@ -14,6 +14,22 @@
 // elements as there are array cells), the HashSet should be resized so
 // that it is twice as large as it was before.
 //
+// The 0.8 is only a default: a HashSet can be given a different maximum
+// load factor, trading memory for shorter lists or vice versa.  When the
+// number of elements is known ahead of time, as it is when a dictionary is
+// loaded, a HashSet can be created with (or reserve()) enough capacity for
+// all of them, so that it never resizes while they are added.
+//
+// statistics() reports how well the elements are spread across the array,
+// which is the quickest way to spot a poor hash function.  Counting how
+// many nodes each lookup actually visits costs a little on every add() and
+// contains(), so it's only done by a HashSet whose second template
+// argument is HashSetCountedLookups; otherwise those counts are always zero.
+//
+// Each node remembers its element's hash, so resizing never calls the hash
+// function, and save() writes those hashes along with the elements, so
+// that load() can rebuild the array exactly as it was without hashing.
+//
 // You are not permitted to use the containers in the C++ Standard Library
 // (such as std::set, std::map, or std::vector) to store the information
 // in your data structure.  Instead, you'll need to use a dynamically-
@@ -23,28 +39,122 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <functional>
-#include "Set.hpp"
+#include <limits>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "BatchSet.hpp"
+#include "SetSerialization.hpp"
+
+
+
+// A HashSet's LookupStats decides whether add() and contains() count their
+// lookups and the nodes those lookups visit.  The default counts nothing
+// and costs nothing.  Because the choice is part of the HashSet's type
+// rather than a preprocessor switch, sets that count and sets that don't
+// have the same layout everywhere, and can be used side by side.
+
+class HashSetUncountedLookups
+{
+public:
+    void countLookup() const noexcept;
+    void countProbe() const noexcept;
+
+    unsigned long long lookups() const noexcept;
+    unsigned long long probes() const noexcept;
+};
+
+
+class HashSetCountedLookups
+{
+public:
+    void countLookup() const noexcept;
+    void countProbe() const noexcept;
+
+    unsigned long long lookups() const noexcept;
+    unsigned long long probes() const noexcept;
 
+private:
+    // These are atomic so that concurrent calls to contains() remain safe.
+    mutable std::atomic<unsigned long long> lookupCount{0};
+    mutable std::atomic<unsigned long long> probeCount{0};
+};
 
 
-template <typename ElementType>
-class HashSet : public Set<ElementType>
+
+template <typename ElementType, typename LookupStats = HashSetUncountedLookups>
+class HashSet : public BatchSet<ElementType>
 {
 public:
     // The default capacity of the HashSet before anything has been
     // added to it.
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
+    // The default maximum ratio of size to capacity, beyond which the
+    // array is resized.
+    static constexpr double DEFAULT_MAX_LOAD_FACTOR = 0.8;
+
     // A HashFunction is a function that takes a reference to a const
     // ElementType and returns an unsigned int.
     using HashFunction = std::function<unsigned int(const ElementType&)>;
 
+    // When adding or looking up a batch of elements, the HashSet hashes
+    // this many elements ahead of the one it's working on, so that their
+    // buckets can be fetched into the cache in the meantime.
+    static constexpr unsigned int BATCH_LOOKAHEAD = 8;
+
+    // Statistics describe the shape of a HashSet's array at one moment,
+    // along with a history of its resizing and (when its LookupStats is
+    // HashSetCountedLookups) of its lookups.
+    struct Statistics
+    {
+        unsigned int size = 0;
+        unsigned int capacity = 0;
+        double loadFactor = 0.0;
+
+        // chainLengths[k] is the number of indexes in the array whose
+        // list has exactly k elements.
+        std::vector<unsigned int> chainLengths;
+
+        // The longest list, and the average number of nodes a successful
+        // lookup visits, assuming every element is looked up equally often.
+        unsigned int maxProbeLength = 0;
+        double meanProbeLength = 0.0;
+
+        // How many times the array has been resized, and how long those
+        // resizes took altogether.
+        unsigned int resizeCount = 0;
+        std::chrono::steady_clock::duration resizeTime{};
+
+        // The memory taken by the array and the nodes, not counting any
+        // that the elements allocate for themselves.
+        std::size_t allocatedBytes = 0;
+
+        // The number of lookups made by add() and contains(), and the
+        // number of nodes they visited in total.  These are only counted
+        // when the HashSet's LookupStats is HashSetCountedLookups.
+        unsigned long long lookups = 0;
+        unsigned long long probes = 0;
+    };
+
 public:
     // Initializes a HashSet to be empty, so that it will use the given
     // hash function whenever it needs to hash an element.
     explicit HashSet(HashFunction hashFunction);
 
+    // Initializes a HashSet to be empty, with enough capacity to hold the
+    // given number of elements without resizing, and with the given
+    // maximum load factor.
+    HashSet(
+        HashFunction hashFunction, unsigned int expectedSize,
+        double maxLoadFactor = DEFAULT_MAX_LOAD_FACTOR);
+
     // Cleans up the HashSet so that it leaks no memory.
     virtual ~HashSet() noexcept;
 
@@ -69,7 +179,8 @@ public:
 
     // add() adds an element to the set.  If the element is already in the set,
     // this function has no effect.  This function triggers a resizing of the
-    // array when the ratio of size to capacity would exceed 0.8.  In the case
+    // array when the ratio of size to capacity would exceed the maximum load
+    // factor (0.8, unless another was chosen).  In the case
     // where the array is resized, this function runs in linear time (with
     // respect to the number of elements, assuming a good hash function);
     // otherwise, it runs in constant time (again, assuming a good hash
@@ -83,6 +194,24 @@ public:
     virtual bool contains(const ElementType& element) const override;
 
 
+    // addMany() adds a batch of elements to the set.  Rather than growing
+    // the array one doubling at a time, it is resized at most once, up
+    // front, to a capacity large enough for all of the elements (counting
+    // duplicates, so the array may end up larger than adding them one at a
+    // time would have made it).  Buckets are prefetched ahead of use.
+    virtual void addMany(const ElementType* elements, unsigned int count) override;
+
+
+    // containsMany() looks up a batch of elements, prefetching their
+    // buckets ahead of use.
+    virtual void containsMany(
+        const ElementType* elements, unsigned int count,
+        std::vector<bool>& found) const override;
+
+    using BatchSet<ElementType>::addMany;
+    using BatchSet<ElementType>::containsMany;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept override;
 
@@ -99,20 +228,148 @@ public:
     bool isElementAtIndex(const ElementType& element, unsigned int index) const;
 
 
+    // capacity() returns the size of the array.
+    unsigned int capacity() const noexcept;
+
+
+    // reserve() makes the array large enough to hold the given number of
+    // elements without exceeding the maximum load factor, so that adding
+    // that many won't cause a resize.  It never makes the array smaller.
+    void reserve(unsigned int expectedSize);
+
+
+    // shrinkToFit() makes the array as small as it can be while holding
+    // the current elements within the maximum load factor, though never
+    // smaller than DEFAULT_CAPACITY.
+    void shrinkToFit();
+
+
+    // maxLoadFactor() returns the ratio of size to capacity beyond which
+    // the array is resized.  setMaxLoadFactor() changes it, growing the
+    // array right away if the current elements would exceed the new one.
+    // A maximum load factor that isn't positive is replaced by the default.
+    double maxLoadFactor() const noexcept;
+    void setMaxLoadFactor(double maxLoadFactor);
+
+
+    // statistics() walks the array to describe how the elements are
+    // spread across it.  It runs in linear time.  Copies start with no
+    // resize history and no lookups counted; moves carry the resize
+    // history along but leave the lookup counts behind.
+    Statistics statistics() const;
+
+
+    // save() writes a snapshot of the set to the given stream: its
+    // capacity, maximum load factor, and each list, in order, with the
+    // hash of each element.  It throws a SnapshotException if the stream
+    // fails.  Elements are written by SnapshotCodec<ElementType>.
+    void save(std::ostream& out) const;
+
+
+    // load() replaces the contents of the set with a snapshot read from
+    // the given stream, rebuilding the array exactly as it was saved
+    // without calling the hash function.  The snapshot must have been
+    // saved by a HashSet with the same hash function as this one.  If the
+    // snapshot can't be read, this function throws a SnapshotException
+    // and the set is left unchanged.
+    void load(std::istream& in);
+
+
 private:
     HashFunction hashFunction;
      struct ListNode
      {
        ElementType key;
        ListNode* next = nullptr;       
+       unsigned int hash = 0;
      };
   ListNode** head;
   int cap = 0;
   int sz = 0;
+  double maxLoad = DEFAULT_MAX_LOAD_FACTOR;
+  unsigned int resizes = 0;
+  std::chrono::steady_clock::duration resizeTime{};
+
+  LookupStats lookupStats;
+
+  // capacityFor() returns the smallest capacity, but no less than
+  // DEFAULT_CAPACITY, that holds the given number of elements within the
+  // maximum load factor.
+  int capacityFor(unsigned int count) const;
+
+  // insertAt() links the element, whose hash is given, into its list
+  // unless it's already there, returning true if it was added.  It never
+  // resizes.
+  bool insertAt(const ElementType& element, unsigned int hash);
+
+  // containsAt() returns true if the element, whose hash is given, is in
+  // its list.
+  bool containsAt(const ElementType& element, unsigned int hash) const;
+
+  // destroyLists() deletes every node in the given array of the given
+  // capacity, then the array itself.
+  static void destroyLists(ListNode** lists, int capacity) noexcept;
+
+  // rehash() changes the capacity, relinking the existing nodes into a
+  // new array rather than copying them.
+  void rehash(int newCap);
+
+  // prefetchAhead() hashes elements[i] and prefetches its bucket, and
+  // prefetches the first node of the bucket hashed half a lookahead ago.
+  void prefetchAhead(
+      const ElementType* elements, unsigned int count, unsigned int i,
+      unsigned int* hashes) const;
 };
 
 
 
+inline void HashSetUncountedLookups::countLookup() const noexcept
+{
+}
+
+
+inline void HashSetUncountedLookups::countProbe() const noexcept
+{
+}
+
+
+inline unsigned long long HashSetUncountedLookups::lookups() const noexcept
+{
+    return 0;
+}
+
+
+inline unsigned long long HashSetUncountedLookups::probes() const noexcept
+{
+    return 0;
+}
+
+
+inline void HashSetCountedLookups::countLookup() const noexcept
+{
+    lookupCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+inline void HashSetCountedLookups::countProbe() const noexcept
+{
+    probeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+inline unsigned long long HashSetCountedLookups::lookups() const noexcept
+{
+    return lookupCount.load(std::memory_order_relaxed);
+}
+
+
+inline unsigned long long HashSetCountedLookups::probes() const noexcept
+{
+    return probeCount.load(std::memory_order_relaxed);
+}
+
+
+
 namespace impl_
 {
     template <typename ElementType>
@@ -120,11 +377,19 @@ namespace impl_
     {
         return 0;
     }
+
+
+    inline void HashSet__prefetch(const void* address)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#endif
+    }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashFunction hashFunction)
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>::HashSet(HashFunction hashFunction)
     : hashFunction{hashFunction}
 {
   cap = DEFAULT_CAPACITY;
@@ -137,8 +402,26 @@ HashSet<ElementType>::HashSet(HashFunction hashFunction)
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::~HashSet() noexcept
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>::HashSet(
+    HashFunction hashFunction, unsigned int expectedSize, double maxLoadFactor)
+    : hashFunction{hashFunction},
+      maxLoad{maxLoadFactor > 0.0 ? maxLoadFactor : DEFAULT_MAX_LOAD_FACTOR}
+{
+  // The array is allocated at its final size right away, rather than at
+  // DEFAULT_CAPACITY and then resized.
+  cap = capacityFor(expectedSize);
+  sz = 0;
+  head = new ListNode*[cap];
+  for(int i = 0; i < cap; ++i)
+    {
+      head[i] = nullptr;
+    }
+}
+
+
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>::~HashSet() noexcept
 {
   ListNode* temp;
   for(int i = 0; i < cap; ++i)
@@ -155,13 +438,14 @@ HashSet<ElementType>::~HashSet() noexcept
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(const HashSet& s)
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>::HashSet(const HashSet& s)
     : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}
 {
   cap = s.cap;
   hashFunction = s.hashFunction;
   sz = s.sz;
+  maxLoad = s.maxLoad;
   head = new ListNode*[cap];
   for (int i = 0; i < cap; ++i)
     {
@@ -169,7 +453,7 @@ HashSet<ElementType>::HashSet(const HashSet& s)
       ListNode* temp = nullptr;
       while (start)
         {
-          temp = new ListNode{start->key, temp};
+          temp = new ListNode{start->key, temp, start->hash};
           start = start->next;
         }
       head[i] = temp;
@@ -177,8 +461,8 @@ HashSet<ElementType>::HashSet(const HashSet& s)
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashSet&& s) noexcept
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>::HashSet(HashSet&& s) noexcept
     : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}
 {
   cap = DEFAULT_CAPACITY;
@@ -190,13 +474,16 @@ HashSet<ElementType>::HashSet(HashSet&& s) noexcept
     }
   std::swap(hashFunction, s.hashFunction);
   std::swap(sz, s.sz);
+  std::swap(maxLoad, s.maxLoad);
+  std::swap(resizes, s.resizes);
+  std::swap(resizeTime, s.resizeTime);
   std::swap(cap, s.cap);
   std::swap(head, s.head);
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>& HashSet<ElementType, LookupStats>::operator=(const HashSet& s)
 {
    if(this != &s)
      {
@@ -216,6 +503,7 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
        cap = s.cap;
        sz = s.sz;
        hashFunction = s.hashFunction;
+       maxLoad = s.maxLoad;
        head = new ListNode*[cap];
        for (int i = 0; i < cap; ++i)
          {
@@ -223,7 +511,7 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
            ListNode* temp = nullptr;
            while(start)
              {
-               temp = new ListNode{start->key, temp};
+               temp = new ListNode{start->key, temp, start->hash};
                start = start->next;
              }
            head[i] = temp;
@@ -233,8 +521,8 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
+template <typename ElementType, typename LookupStats>
+HashSet<ElementType, LookupStats>& HashSet<ElementType, LookupStats>::operator=(HashSet&& s) noexcept
 {
    if(this != &s)
      {
@@ -242,111 +530,84 @@ HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
        std::swap(cap, s.cap);
        std::swap(sz, s.sz);
        std::swap(hashFunction, s.hashFunction);
+       std::swap(maxLoad, s.maxLoad);
+       std::swap(resizes, s.resizes);
+       std::swap(resizeTime, s.resizeTime);
      }
   return *this;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename LookupStats>
+bool HashSet<ElementType, LookupStats>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-void HashSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::add(const ElementType& element)
 {
-  int i = hashFunction(element) % cap;
-  ListNode* item = head[i];
-  while (item)
+  if (insertAt(element, hashFunction(element)) && maxLoad*cap < sz) // resize if ratios over the max
     {
-      if (item->key == element)
-        return;
-      item = item->next;
+      rehash(cap * 2);
     }
-  
-  head[i] = new ListNode{element, head[i]};
-  sz++;
-  if(0.8*cap < sz) // resize if ratios over 0.8
+}
+
+
+template <typename ElementType, typename LookupStats>
+bool HashSet<ElementType, LookupStats>::contains(const ElementType& element) const
+{
+  return containsAt(element, hashFunction(element));
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::addMany(const ElementType* elements, unsigned int count)
+{
+  reserve(sz + count);
+
+  unsigned int hashes[BATCH_LOOKAHEAD];
+  for (unsigned int i = 0; i < count + BATCH_LOOKAHEAD; ++i)
     {
-      ListNode** temp = new ListNode* [cap];
-      for (int j = 0; j < cap; ++j)
-        {
-          ListNode* curr = head[j];
-          ListNode* a = nullptr;
-          while (curr)
-            {
-              a = new ListNode{curr->key, a};
-              curr = curr->next;
-            }
-          temp[j] = a;
-        }
-      ListNode* b;
-      for(int k  = 0; k < cap; ++k)
-        {
-          b = head[k];
-          while(b)
-            {
-              ListNode* prev = b;
-              b = b->next;
-              delete prev;
-            }
-        }
-      delete [] head;
-      
-      int old_cap = cap;
-      cap *=2;
-      head = new ListNode* [cap];
-      for(int p = 0;  p < cap; ++p)
+      if (i >= BATCH_LOOKAHEAD)
         {
-          head[p] = nullptr;
+          unsigned int j = i - BATCH_LOOKAHEAD;
+          insertAt(elements[j], hashes[j % BATCH_LOOKAHEAD]);
         }
-      for(int q = 0; q < old_cap; ++q)
-        {
-          ListNode* temp1 = temp[q];
-          while(temp1)
-            {
-              ElementType k = temp1->key;
-              int index = hashFunction(k) % cap;
-              head[index] = new ListNode{k, head[index]};
-              temp1 = temp1->next;
-            }
-        }
-      
+      prefetchAhead(elements, count, i, hashes);
     }
- 
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::containsMany(
+    const ElementType* elements, unsigned int count, std::vector<bool>& found) const
 {
-  ListNode* curr = head[hashFunction(element) % cap];
-  while(curr)
+  found.assign(count, false);
+
+  unsigned int hashes[BATCH_LOOKAHEAD];
+  for (unsigned int i = 0; i < count + BATCH_LOOKAHEAD; ++i)
     {
-      if(curr->key == element)
+      if (i >= BATCH_LOOKAHEAD)
         {
-          return true;
-        }
-      else
-        {
-          curr = curr->next;
+          unsigned int j = i - BATCH_LOOKAHEAD;
+          found[j] = containsAt(elements[j], hashes[j % BATCH_LOOKAHEAD]);
         }
+      prefetchAhead(elements, count, i, hashes);
     }
-  return false;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::size() const noexcept
+template <typename ElementType, typename LookupStats>
+unsigned int HashSet<ElementType, LookupStats>::size() const noexcept
 {
   return static_cast<unsigned int> (sz);
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
+template <typename ElementType, typename LookupStats>
+unsigned int HashSet<ElementType, LookupStats>::elementsAtIndex(unsigned int index) const
 {
   if(index < 0 || index >= cap)
     {
@@ -366,8 +627,8 @@ unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+template <typename ElementType, typename LookupStats>
+bool HashSet<ElementType, LookupStats>::isElementAtIndex(const ElementType& element, unsigned int index) const
 {
   if (index < 0 || index >= cap)
     {
@@ -386,6 +647,308 @@ bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned
 }
 
 
+template <typename ElementType, typename LookupStats>
+unsigned int HashSet<ElementType, LookupStats>::capacity() const noexcept
+{
+  return static_cast<unsigned int>(cap);
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::reserve(unsigned int expectedSize)
+{
+  int newCap = capacityFor(expectedSize);
+  if (newCap > cap)
+    {
+      rehash(newCap);
+    }
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::shrinkToFit()
+{
+  int newCap = capacityFor(sz);
+  if (newCap < cap)
+    {
+      rehash(newCap);
+    }
+}
+
+
+template <typename ElementType, typename LookupStats>
+double HashSet<ElementType, LookupStats>::maxLoadFactor() const noexcept
+{
+  return maxLoad;
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::setMaxLoadFactor(double maxLoadFactor)
+{
+  maxLoad = maxLoadFactor > 0.0 ? maxLoadFactor : DEFAULT_MAX_LOAD_FACTOR;
+  reserve(sz);
+}
+
+
+template <typename ElementType, typename LookupStats>
+typename HashSet<ElementType, LookupStats>::Statistics HashSet<ElementType, LookupStats>::statistics() const
+{
+  Statistics stats;
+  stats.size = sz;
+  stats.capacity = cap;
+  stats.loadFactor = static_cast<double>(sz) / cap;
+
+  // A successful lookup of the k-th element of a list visits k nodes, so
+  // a list of length n contributes 1 + 2 + ... + n to the total.
+  unsigned long long totalProbes = 0;
+  for (int i = 0; i < cap; ++i)
+    {
+      unsigned int length = 0;
+      for (ListNode* curr = head[i]; curr; curr = curr->next)
+        {
+          length++;
+        }
+      if (length >= stats.chainLengths.size())
+        {
+          stats.chainLengths.resize(length + 1, 0);
+        }
+      stats.chainLengths[length]++;
+      stats.maxProbeLength = std::max(stats.maxProbeLength, length);
+      totalProbes += static_cast<unsigned long long>(length) * (length + 1) / 2;
+    }
+  stats.meanProbeLength = sz == 0 ? 0.0 : static_cast<double>(totalProbes) / sz;
+
+  stats.resizeCount = resizes;
+  stats.resizeTime = resizeTime;
+  stats.allocatedBytes = cap * sizeof(ListNode*) + sz * sizeof(ListNode);
+
+  stats.lookups = lookupStats.lookups();
+  stats.probes = lookupStats.probes();
+
+  return stats;
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::save(std::ostream& out) const
+{
+  SnapshotWriter writer{out};
+  writer.writeHeader("HSET", 1);
+  writer.writeValue(static_cast<std::uint32_t>(cap));
+  writer.writeValue(static_cast<std::uint32_t>(sz));
+  writer.writeValue(maxLoad);
+
+  for (int i = 0; i < cap; ++i)
+    {
+      std::uint32_t length = 0;
+      for (ListNode* curr = head[i]; curr; curr = curr->next)
+        {
+          length++;
+        }
+      writer.writeValue(length);
+      for (ListNode* curr = head[i]; curr; curr = curr->next)
+        {
+          writer.writeValue(static_cast<std::uint32_t>(curr->hash));
+          SnapshotCodec<ElementType>::write(writer, curr->key);
+        }
+    }
+
+  writer.flush();
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::load(std::istream& in)
+{
+  SnapshotReader reader{in};
+  reader.readHeader("HSET", 1);
+  int newCap = static_cast<int>(reader.readValue<std::uint32_t>());
+  std::uint32_t newSz = reader.readValue<std::uint32_t>();
+  double newMaxLoad = reader.readValue<double>();
+
+  // A set never holds more elements than its maximum load factor allows
+  // for its capacity, since add() grows the array as soon as it would.
+  if (newCap <= 0 || !(newMaxLoad > 0.0) || newMaxLoad*newCap < newSz)
+    {
+      throw SnapshotException{"Snapshot of a HashSet is damaged"};
+    }
+
+  // The lists are built into a new array, which only replaces the old
+  // one once the whole snapshot has been read.  Neither the capacity nor
+  // the size can be trusted until the lists have been read (a set can
+  // have far more room than its size calls for, after reserve(), say), so
+  // the array starts small and doubles whenever another list turns up for
+  // it.  That way, a damaged capacity fails as soon as the lists run out,
+  // rather than asking for an enormous array first.
+  int allocated = std::min(newCap, static_cast<int>(DEFAULT_CAPACITY));
+  ListNode** newHead = new ListNode*[allocated];
+  for (int i = 0; i < allocated; ++i)
+    {
+      newHead[i] = nullptr;
+    }
+
+  try
+    {
+      std::uint32_t total = 0;
+      for (int i = 0; i < newCap; ++i)
+        {
+          if (i == allocated)
+            {
+              int grown = allocated > newCap / 2 ? newCap : allocated * 2;
+              ListNode** bigger = new ListNode*[grown];
+              for (int j = 0; j < grown; ++j)
+                {
+                  bigger[j] = j < allocated ? newHead[j] : nullptr;
+                }
+              delete[] newHead;
+              newHead = bigger;
+              allocated = grown;
+            }
+          std::uint32_t length = reader.readValue<std::uint32_t>();
+          ListNode** tail = &newHead[i];
+          for (std::uint32_t k = 0; k < length; ++k)
+            {
+              unsigned int hash = reader.readValue<std::uint32_t>();
+              *tail = new ListNode{SnapshotCodec<ElementType>::read(reader), nullptr, hash};
+              tail = &(*tail)->next;
+            }
+          total += length;
+        }
+      if (total != newSz)
+        {
+          throw SnapshotException{"Snapshot of a HashSet is damaged"};
+        }
+      reader.finish();
+    }
+  catch (...)
+    {
+      destroyLists(newHead, allocated);
+      throw;
+    }
+
+  destroyLists(head, cap);
+  head = newHead;
+  cap = newCap;
+  sz = static_cast<int>(newSz);
+  maxLoad = newMaxLoad;
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::destroyLists(ListNode** lists, int capacity) noexcept
+{
+  for (int i = 0; i < capacity; ++i)
+    {
+      ListNode* curr = lists[i];
+      while (curr)
+        {
+          ListNode* prev = curr;
+          curr = curr->next;
+          delete prev;
+        }
+    }
+  delete[] lists;
+}
+
+
+template <typename ElementType, typename LookupStats>
+int HashSet<ElementType, LookupStats>::capacityFor(unsigned int count) const
+{
+  double needed = std::ceil(count / maxLoad);
+  if (needed > std::numeric_limits<int>::max() / 2)
+    {
+      return std::numeric_limits<int>::max() / 2;
+    }
+  int newCap = static_cast<int>(needed);
+  while (maxLoad*newCap < count)
+    {
+      newCap++;
+    }
+  return std::max(newCap, static_cast<int>(DEFAULT_CAPACITY));
+}
+
+
+template <typename ElementType, typename LookupStats>
+bool HashSet<ElementType, LookupStats>::insertAt(const ElementType& element, unsigned int hash)
+{
+  if (containsAt(element, hash))
+    {
+      return false;
+    }
+  unsigned int index = hash % cap;
+  head[index] = new ListNode{element, head[index], hash};
+  sz++;
+  return true;
+}
+
+
+template <typename ElementType, typename LookupStats>
+bool HashSet<ElementType, LookupStats>::containsAt(const ElementType& element, unsigned int hash) const
+{
+  lookupStats.countLookup();
+  ListNode* curr = head[hash % cap];
+  while(curr)
+    {
+      lookupStats.countProbe();
+      if(curr->hash == hash && curr->key == element)
+        {
+          return true;
+        }
+      curr = curr->next;
+    }
+  return false;
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::rehash(int newCap)
+{
+  auto start = std::chrono::steady_clock::now();
+  ListNode** newHead = new ListNode*[newCap];
+  for (int p = 0; p < newCap; ++p)
+    {
+      newHead[p] = nullptr;
+    }
+  for (int q = 0; q < cap; ++q)
+    {
+      ListNode* curr = head[q];
+      while (curr)
+        {
+          ListNode* next = curr->next;
+          unsigned int index = curr->hash % newCap;
+          curr->next = newHead[index];
+          newHead[index] = curr;
+          curr = next;
+        }
+    }
+  delete[] head;
+  head = newHead;
+  cap = newCap;
+  resizes++;
+  resizeTime += std::chrono::steady_clock::now() - start;
+}
+
+
+template <typename ElementType, typename LookupStats>
+void HashSet<ElementType, LookupStats>::prefetchAhead(
+    const ElementType* elements, unsigned int count, unsigned int i,
+    unsigned int* hashes) const
+{
+  if (i < count)
+    {
+      unsigned int hash = hashFunction(elements[i]);
+      hashes[i % BATCH_LOOKAHEAD] = hash;
+      impl_::HashSet__prefetch(head + hash % cap);
+    }
+  unsigned int half = BATCH_LOOKAHEAD / 2;
+  if (i >= half && i - half < count)
+    {
+      impl_::HashSet__prefetch(head[hashes[(i - half) % BATCH_LOOKAHEAD] % cap]);
+    }
+}
+
+
 
 #endif // HASHSET_HPP
 
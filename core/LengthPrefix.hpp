@@ -0,0 +1,65 @@
+// LengthPrefix.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Strings stored back to back, in a StringPool or a MappedDictionary, are
+// each preceded by their length, written in 7-bit groups from the lowest
+// up, with the high bit of each byte set when another byte follows.  Any
+// length under 128 takes a single byte.
+
+#ifndef LENGTHPREFIX_HPP
+#define LENGTHPREFIX_HPP
+
+#include <cstddef>
+
+
+
+namespace impl_
+{
+    // lengthPrefixSize() returns the number of bytes the given length
+    // takes when written as a prefix.
+    inline std::size_t lengthPrefixSize(std::size_t length)
+    {
+        std::size_t bytes = 1;
+        for (; length >= 0x80; length >>= 7)
+        {
+            ++bytes;
+        }
+        return bytes;
+    }
+
+
+    // writeLengthPrefix() writes the given length at p and returns a
+    // pointer just past it.
+    inline char* writeLengthPrefix(char* p, std::size_t length)
+    {
+        for (; length >= 0x80; length >>= 7)
+        {
+            *p++ = static_cast<char>((length & 0x7f) | 0x80);
+        }
+        *p++ = static_cast<char>(length);
+        return p;
+    }
+
+
+    // readLengthPrefix() reads the length written at p into "length" and
+    // returns a pointer to the characters that follow it.
+    inline const char* readLengthPrefix(const char* p, std::size_t& length)
+    {
+        length = 0;
+        for (unsigned int shift = 0; ; shift += 7)
+        {
+            unsigned char byte = static_cast<unsigned char>(*p++);
+            length |= static_cast<std::size_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return p;
+            }
+        }
+    }
+}
+
+
+
+#endif // LENGTHPREFIX_HPP
@@ -0,0 +1,265 @@
+// LikelyEdits.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <cctype>
+#include "LikelyEdits.hpp"
+
+
+namespace
+{
+    const char* const KEYBOARD_ROWS[] = {"QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"};
+
+    const char* const SOUND_GROUPS[] = {"BFPV", "CGJKQSXZ", "DT", "MN", "AEIOUY"};
+
+
+    // Soundex codes for 'A' through 'Z': '0' for letters that separate
+    // consonants (the vowels and Y), '-' for letters that don't (H and W).
+    const char SOUNDEX_CODES[] = "0123012-02245501262301-202";
+
+
+    int letterIndex(char c)
+    {
+        unsigned char u = static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c)));
+        return u >= 'A' && u <= 'Z' ? u - 'A' : -1;
+    }
+
+
+    // LetterTiers holds, for each letter, the letters in each tier for
+    // replacing it: those adjacent to it, those that sound like it (and
+    // aren't adjacent), and the rest.
+    struct LetterTiers
+    {
+        std::string adjacent[26];
+        std::string soundAlike[26];
+        std::string other[26];
+        std::string allLetters;
+
+        LetterTiers()
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                std::string_view keys = KEYBOARD_ROWS[row];
+                for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+                {
+                    std::string& adjacentKeys = adjacent[keys[i] - 'A'];
+
+                    // The rows are staggered, so key i of a row touches keys
+                    // i and i + 1 of the row above and i - 1 and i below.
+                    addKey(adjacentKeys, row, i - 1);
+                    addKey(adjacentKeys, row, i + 1);
+                    addKey(adjacentKeys, row - 1, i);
+                    addKey(adjacentKeys, row - 1, i + 1);
+                    addKey(adjacentKeys, row + 1, i - 1);
+                    addKey(adjacentKeys, row + 1, i);
+                }
+            }
+
+            for (std::string_view group : SOUND_GROUPS)
+            {
+                for (char letter : group)
+                {
+                    for (char alike : group)
+                    {
+                        if (alike != letter && adjacent[letter - 'A'].find(alike) == std::string::npos)
+                        {
+                            soundAlike[letter - 'A'] += alike;
+                        }
+                    }
+                }
+            }
+
+            for (char letter = 'A'; letter <= 'Z'; ++letter)
+            {
+                allLetters += letter;
+
+                for (char c = 'A'; c <= 'Z'; ++c)
+                {
+                    int i = letter - 'A';
+                    if (adjacent[i].find(c) == std::string::npos && soundAlike[i].find(c) == std::string::npos)
+                    {
+                        other[i] += c;
+                    }
+                }
+            }
+        }
+
+        static void addKey(std::string& keys, int row, int i)
+        {
+            if (row >= 0 && row < 3 && i >= 0 && i < static_cast<int>(std::string_view{KEYBOARD_ROWS[row]}.size()))
+            {
+                keys += KEYBOARD_ROWS[row][i];
+            }
+        }
+    };
+
+
+    const LetterTiers& letterTiers()
+    {
+        static const LetterTiers tiers;
+        return tiers;
+    }
+
+
+    // addLetters() appends to "letters" each of the given letters that
+    // hasn't been chosen yet, marking it chosen.
+    void addLetters(std::string_view candidates, bool (&chosen)[26], std::string& letters)
+    {
+        for (char c : candidates)
+        {
+            if (!chosen[c - 'A'])
+            {
+                chosen[c - 'A'] = true;
+                letters += c;
+            }
+        }
+    }
+}
+
+
+std::string_view LikelyEdits::replacements(char c, EditTier tier)
+{
+    const LetterTiers& tiers = letterTiers();
+    int i = letterIndex(c);
+
+    if (i < 0)
+    {
+        return tier == EditTier::Other ? std::string_view{tiers.allLetters} : std::string_view{};
+    }
+
+    switch (tier)
+    {
+    case EditTier::Adjacent:
+        return tiers.adjacent[i];
+    case EditTier::SoundAlike:
+        return tiers.soundAlike[i];
+    default:
+        return tiers.other[i];
+    }
+}
+
+
+void LikelyEdits::insertions(char before, char after, EditTier tier, std::string& letters)
+{
+    const LetterTiers& tiers = letterTiers();
+    int b = letterIndex(before);
+    int a = letterIndex(after);
+
+    bool chosen[26] = {};
+    letters.clear();
+
+    // Each tier is made of the letters not already in an earlier one, so
+    // the earlier tiers are chosen first and then thrown away.
+    for (EditTier t : {EditTier::Adjacent, EditTier::SoundAlike, EditTier::Other})
+    {
+        letters.clear();
+
+        if (t == EditTier::Adjacent)
+        {
+            for (int i : {b, a})
+            {
+                if (i >= 0)
+                {
+                    addLetters(std::string_view{&tiers.allLetters[i], 1}, chosen, letters);
+                }
+            }
+            for (int i : {b, a})
+            {
+                if (i >= 0)
+                {
+                    addLetters(tiers.adjacent[i], chosen, letters);
+                }
+            }
+        }
+        else if (t == EditTier::SoundAlike)
+        {
+            for (int i : {b, a})
+            {
+                if (i >= 0)
+                {
+                    addLetters(tiers.soundAlike[i], chosen, letters);
+                }
+            }
+        }
+        else
+        {
+            addLetters(tiers.allLetters, chosen, letters);
+        }
+
+        if (t == tier)
+        {
+            return;
+        }
+    }
+}
+
+
+std::string soundexKey(std::string_view word)
+{
+    std::string key;
+    char previous = '\0';
+
+    for (char c : word)
+    {
+        int i = letterIndex(c);
+        if (i < 0)
+        {
+            continue;
+        }
+
+        char code = SOUNDEX_CODES[i];
+
+        if (key.empty())
+        {
+            key += static_cast<char>('A' + i);
+        }
+        else if (code != '0' && code != '-' && code != previous)
+        {
+            key += code;
+            if (key.size() == 4)
+            {
+                break;
+            }
+        }
+
+        // H and W don't separate consonants with the same code; vowels do.
+        if (code != '-')
+        {
+            previous = code;
+        }
+    }
+
+    if (!key.empty())
+    {
+        key.resize(4, '0');
+    }
+
+    return key;
+}
+
+
+void PhoneticIndex::add(const std::string& word)
+{
+    std::string key = soundexKey(word);
+    if (!key.empty())
+    {
+        wordsByKey[key].push_back(word);
+        ++count;
+    }
+}
+
+
+const std::vector<std::string>& PhoneticIndex::wordsLike(const std::string& word) const
+{
+    static const std::vector<std::string> none;
+
+    auto found = wordsByKey.find(soundexKey(word));
+    return found != wordsByKey.end() ? found->second : none;
+}
+
+
+std::size_t PhoneticIndex::size() const noexcept
+{
+    return count;
+}
@@ -0,0 +1,92 @@
+// LikelyEdits.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Not every letter is equally likely to be mistyped for every other.  A
+// letter is most often mistyped as one whose key is next to it on a
+// QWERTY keyboard, and next most often as one that sounds like it (by the
+// groups Soundex uses: B F P V, C G J K Q S X Z, D T, M N, and the
+// vowels).  LikelyEdits divides the letters to try, when replacing a
+// letter or inserting one, into three tiers by how likely they are, so
+// that the likeliest candidates can be looked up first:
+//
+//   * Adjacent: keys next to the letter being replaced; or, for an
+//     insertion, the letters on either side (a doubled key) and the keys
+//     next to them.
+//   * SoundAlike: letters in the same sound group, not already adjacent.
+//   * Other: every other letter from 'A' through 'Z'.
+//
+// Together, the three tiers are exactly the letters the original replace
+// and insert algorithms try, so trying all of them finds the same words.
+// (A BasicWordChecker whose Alphabet has letters besides 'A' through 'Z'
+// tries those, too, along with the Other tier.)
+//
+// A PhoneticIndex finds words that sound alike without being a single edit
+// apart (e.g., "RITHM" and "RHYTHM", which share the Soundex key R350), by
+// grouping a dictionary's words by their Soundex keys, computed once as the
+// index is built.
+
+#ifndef LIKELYEDITS_HPP
+#define LIKELYEDITS_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+
+enum class EditTier
+{
+    Adjacent,
+    SoundAlike,
+    Other
+};
+
+
+
+class LikelyEdits
+{
+public:
+    // replacements() returns the letters in the given tier for replacing
+    // the given character, in upper case.
+    static std::string_view replacements(char c, EditTier tier);
+
+    // insertions() stores into "letters" the letters in the given tier for
+    // inserting between the given characters, in upper case.  Either may
+    // be '\0', for an insertion at the start or end of a word.
+    static void insertions(char before, char after, EditTier tier, std::string& letters);
+};
+
+
+
+// soundexKey() returns the American Soundex key of the given word: its
+// first letter, in upper case, followed by three digits coding the sounds
+// of the consonants after it.  Characters other than letters are skipped;
+// a word with no letters has an empty key.
+std::string soundexKey(std::string_view word);
+
+
+
+class PhoneticIndex
+{
+public:
+    // add() adds the given word to the index.
+    void add(const std::string& word);
+
+    // wordsLike() returns the words in the index with the same Soundex
+    // key as the given word, in the order they were added.
+    const std::vector<std::string>& wordsLike(const std::string& word) const;
+
+    // size() returns the number of words that have been added.
+    std::size_t size() const noexcept;
+
+private:
+    std::unordered_map<std::string, std::vector<std::string>> wordsByKey;
+    std::size_t count = 0;
+};
+
+
+
+#endif // LIKELYEDITS_HPP
@@ -0,0 +1,352 @@
+// MappedDictionary.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedDictionary.hpp"
+
+
+namespace
+{
+    constexpr char MAGIC[8] = {'I', 'C', 'S', '4', '6', 'D', 'I', 'C'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t EMPTY_SLOT = 0xffffffff;
+    constexpr std::uint32_t MIN_SLOTS = 16;
+
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t byteOrder;
+        std::uint32_t version;
+        std::uint32_t wordCount;
+        std::uint32_t slotCount;
+        std::uint64_t slotsOffset;
+        std::uint64_t wordsOffset;
+        std::uint64_t wordsSize;
+    };
+
+
+    std::uint64_t hashWord(std::string_view word)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : word)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+
+    std::string describeError(const std::string& what, const std::string& path)
+    {
+        return what + " " + path + ": " + std::strerror(errno);
+    }
+}
+
+
+MappedDictionary::DictionaryException::DictionaryException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& MappedDictionary::DictionaryException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+MappedDictionary::MappedDictionary(const std::string& path)
+    : mapping{nullptr}, mappingSize{0}, wordCount{0}, slotMask{0},
+      slots{nullptr}, words{nullptr}, wordsSize{0}
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw DictionaryException{describeError("Cannot open", path)};
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0)
+    {
+        std::string reason = describeError("Cannot examine", path);
+        ::close(fd);
+        throw DictionaryException{reason};
+    }
+
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size < sizeof(Header))
+    {
+        ::close(fd);
+        throw DictionaryException{
+            path + (isMappedDictionaryFile(path) ? " is damaged" : " is not a dictionary file")};
+    }
+
+    // The mapping holds its own reference to the file, so the descriptor
+    // can be closed as soon as it's made.
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    std::string reason = describeError("Cannot map", path);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        throw DictionaryException{reason};
+    }
+
+    mapping = p;
+    mappingSize = size;
+
+    Header header;
+    std::memcpy(&header, mapping, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        unmap();
+        throw DictionaryException{path + " is not a dictionary file"};
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK)
+    {
+        unmap();
+        throw DictionaryException{path + " was written on a machine with a different byte order"};
+    }
+    if (header.version != VERSION)
+    {
+        unmap();
+        throw DictionaryException{path + " is in an unsupported dictionary format"};
+    }
+
+    std::uint64_t slotsSize = std::uint64_t{header.slotCount} * 2 * sizeof(std::uint32_t);
+    bool slotCountValid = header.slotCount >= MIN_SLOTS
+        && (header.slotCount & (header.slotCount - 1)) == 0
+        && header.wordCount <= header.slotCount / 2;
+
+    if (!slotCountValid
+        || header.slotsOffset % alignof(std::uint32_t) != 0
+        || header.slotsOffset > size || slotsSize > size - header.slotsOffset
+        || header.wordsOffset > size || header.wordsSize > size - header.wordsOffset)
+    {
+        unmap();
+        throw DictionaryException{path + " is damaged"};
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    wordCount = header.wordCount;
+    slotMask = header.slotCount - 1;
+    slots = reinterpret_cast<const std::uint32_t*>(base + header.slotsOffset);
+    words = base + header.wordsOffset;
+    wordsSize = header.wordsSize;
+
+    // Lookups jump around the index, so reading ahead of them would only
+    // bring in pages that aren't needed.
+    ::madvise(mapping, mappingSize, MADV_RANDOM);
+}
+
+
+MappedDictionary::~MappedDictionary() noexcept
+{
+    unmap();
+}
+
+
+MappedDictionary::MappedDictionary(MappedDictionary&& d) noexcept
+    : mapping{nullptr}, mappingSize{0}, wordCount{0}, slotMask{0},
+      slots{nullptr}, words{nullptr}, wordsSize{0}
+{
+    *this = std::move(d);
+}
+
+
+MappedDictionary& MappedDictionary::operator=(MappedDictionary&& d) noexcept
+{
+    if (this != &d)
+    {
+        std::swap(mapping, d.mapping);
+        std::swap(mappingSize, d.mappingSize);
+        std::swap(wordCount, d.wordCount);
+        std::swap(slotMask, d.slotMask);
+        std::swap(slots, d.slots);
+        std::swap(words, d.words);
+        std::swap(wordsSize, d.wordsSize);
+    }
+
+    return *this;
+}
+
+
+bool MappedDictionary::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void MappedDictionary::add(const std::string& element)
+{
+    throw DictionaryException{"Cannot add \"" + element + "\" to a read-only dictionary"};
+}
+
+
+bool MappedDictionary::contains(const std::string& element) const
+{
+    return contains(std::string_view{element});
+}
+
+
+bool MappedDictionary::contains(std::string_view word) const
+{
+    if (wordCount == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t hash = hashWord(word);
+    std::uint32_t tag = static_cast<std::uint32_t>(hash >> 32);
+
+    // The index is never more than half full, but a damaged file could
+    // have no empty slots, so the search gives up after visiting them all.
+    std::uint32_t slot = hash & slotMask;
+    for (std::uint32_t probes = 0; probes <= slotMask; ++probes, slot = (slot + 1) & slotMask)
+    {
+        std::uint32_t offset = slots[2 * slot];
+        if (offset == EMPTY_SLOT)
+        {
+            return false;
+        }
+        if (slots[2 * slot + 1] == tag && offset < wordsSize)
+        {
+            std::size_t length;
+            const char* p = impl_::readLengthPrefix(words + offset, length);
+            if (length == word.size() && length <= wordsSize - (p - words)
+                && std::string_view{p, length} == word)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+unsigned int MappedDictionary::size() const noexcept
+{
+    return wordCount;
+}
+
+
+void MappedDictionary::unmap() noexcept
+{
+    if (mapping)
+    {
+        ::munmap(mapping, mappingSize);
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+    wordCount = 0;
+    slotMask = 0;
+    slots = nullptr;
+    words = nullptr;
+    wordsSize = 0;
+}
+
+
+bool isMappedDictionaryFile(const std::string& path)
+{
+    std::ifstream in{path, std::ios::binary};
+
+    char magic[sizeof(MAGIC)];
+    return in.read(magic, sizeof(magic))
+        && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+
+void writeMappedDictionary(const std::string& path, std::vector<std::string> words)
+{
+    using DictionaryException = MappedDictionary::DictionaryException;
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    if (words.size() > EMPTY_SLOT / 2)
+    {
+        throw DictionaryException{"Too many words for one dictionary file"};
+    }
+
+    std::uint32_t slotCount = MIN_SLOTS;
+    while (slotCount / 2 < words.size())
+    {
+        slotCount *= 2;
+    }
+
+    std::vector<char> area;
+    std::vector<std::uint32_t> slots(std::size_t{slotCount} * 2, EMPTY_SLOT);
+    std::uint32_t mask = slotCount - 1;
+
+    for (const std::string& word : words)
+    {
+        if (area.size() >= EMPTY_SLOT)
+        {
+            throw DictionaryException{"Too many characters for one dictionary file"};
+        }
+
+        std::uint32_t offset = static_cast<std::uint32_t>(area.size());
+        area.resize(area.size() + impl_::lengthPrefixSize(word.size()) + word.size());
+        char* p = impl_::writeLengthPrefix(area.data() + offset, word.size());
+        std::memcpy(p, word.data(), word.size());
+
+        std::uint64_t hash = hashWord(word);
+        std::uint32_t slot = hash & mask;
+        while (slots[2 * slot] != EMPTY_SLOT)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[2 * slot] = offset;
+        slots[2 * slot + 1] = static_cast<std::uint32_t>(hash >> 32);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = VERSION;
+    header.wordCount = static_cast<std::uint32_t>(words.size());
+    header.slotCount = slotCount;
+    header.slotsOffset = sizeof(Header);
+    header.wordsOffset = header.slotsOffset + slots.size() * sizeof(std::uint32_t);
+    header.wordsSize = area.size();
+
+    std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream out{temporaryPath, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(std::uint32_t));
+        out.write(area.data(), area.size());
+        out.close();
+
+        if (!out)
+        {
+            std::remove(temporaryPath.c_str());
+            throw DictionaryException{"Cannot write " + temporaryPath};
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::string reason = describeError("Cannot rename " + temporaryPath + " to", path);
+        std::remove(temporaryPath.c_str());
+        throw DictionaryException{reason};
+    }
+}
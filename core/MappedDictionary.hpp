@@ -0,0 +1,151 @@
+// MappedDictionary.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A MappedDictionary is a read-only Set of words that lives in a file,
+// written ahead of time by writeMappedDictionary() (or the dict tool),
+// which is mapped into memory and searched where it lies.  Opening one
+// takes the same time no matter how many words it has, since nothing is
+// parsed or copied; pages of the file are read as lookups touch them, and
+// every process that opens the same file shares one copy of those pages.
+//
+// The file is laid out as follows, with every number in the byte order of
+// the machine that wrote it (which the header records, so a file written
+// on a machine with the other byte order is rejected rather than misread):
+//
+//   * A header, giving the number of words and where the other parts are.
+//   * A hash index: a power-of-two number of slots, each holding the
+//     offset of a word within the word area (or all ones if empty) along
+//     with the upper 32 bits of the word's 64-bit FNV-1a hash.  Words are
+//     placed by linear probing from the slot chosen by the hash's lower
+//     bits, with at most half of the slots in use.
+//   * The word area: each distinct word, in ascending order, preceded by
+//     its length (see LengthPrefix.hpp).
+//
+// Since the hash function is fixed by the format, rather than left to the
+// standard library, a file can be shared by programs built with different
+// compilers.
+
+#ifndef MAPPEDDICTIONARY_HPP
+#define MAPPEDDICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LengthPrefix.hpp"
+#include "Set.hpp"
+
+
+
+class MappedDictionary : public Set<std::string>
+{
+public:
+    // A DictionaryException is thrown when a dictionary file can't be
+    // opened, mapped, written or understood, and when a word is added to
+    // a MappedDictionary.
+    class DictionaryException
+    {
+    public:
+        explicit DictionaryException(const std::string& reason);
+
+        const std::string& reason() const noexcept;
+
+    private:
+        std::string reason_;
+    };
+
+public:
+    // Opens and maps the dictionary file with the given path, throwing a
+    // DictionaryException if that fails or if it's not a dictionary file.
+    explicit MappedDictionary(const std::string& path);
+
+    // Unmaps the dictionary file.
+    virtual ~MappedDictionary() noexcept;
+
+    // A MappedDictionary can be moved, but not copied; a moved-from one is
+    // empty.
+    MappedDictionary(const MappedDictionary& d) = delete;
+    MappedDictionary(MappedDictionary&& d) noexcept;
+    MappedDictionary& operator=(const MappedDictionary& d) = delete;
+    MappedDictionary& operator=(MappedDictionary&& d) noexcept;
+
+
+    // isImplemented() returns true.
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() always throws a DictionaryException, since a MappedDictionary
+    // can't be changed.
+    virtual void add(const std::string& element) override;
+
+
+    // contains() returns true if the given word is in the dictionary.  It
+    // runs in constant time, on average.
+    virtual bool contains(const std::string& element) const override;
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of words in the dictionary.
+    virtual unsigned int size() const noexcept override;
+
+
+    // forEachWord() calls the given "visit" function with each word in
+    // the dictionary, as a std::string_view, in ascending order.
+    template <typename Visitor>
+    void forEachWord(Visitor visit) const;
+
+
+private:
+    void* mapping;
+    std::size_t mappingSize;
+
+    std::uint32_t wordCount;
+    std::uint32_t slotMask;
+    const std::uint32_t* slots;
+    const char* words;
+    std::size_t wordsSize;
+
+    void unmap() noexcept;
+};
+
+
+
+// isMappedDictionaryFile() returns true if the file with the given path
+// begins the way every dictionary file does, whether or not the rest of it
+// can be opened as one, and false if it doesn't or can't be read.  A file
+// that it accepts but MappedDictionary rejects is a dictionary file that
+// is damaged, or is from another machine or a newer version of the format,
+// rather than some other kind of file.
+bool isMappedDictionaryFile(const std::string& path);
+
+
+// writeMappedDictionary() writes the given words, less any duplicates, to
+// a dictionary file with the given path, throwing a DictionaryException if
+// that fails.  The file is written under a temporary name and then renamed,
+// so that a process that already has the old file mapped keeps seeing it
+// as it was.
+void writeMappedDictionary(const std::string& path, std::vector<std::string> words);
+
+
+
+template <typename Visitor>
+void MappedDictionary::forEachWord(Visitor visit) const
+{
+    const char* p = words;
+    const char* end = words + wordsSize;
+
+    while (p < end)
+    {
+        std::size_t length;
+        p = impl_::readLengthPrefix(p, length);
+        visit(std::string_view{p, length});
+        p += length;
+    }
+}
+
+
+
+#endif // MAPPEDDICTIONARY_HPP
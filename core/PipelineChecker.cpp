@@ -0,0 +1,478 @@
+// PipelineChecker.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentQueue.hpp"
+#include "DocumentTokenizer.hpp"
+#include "PipelineChecker.hpp"
+#include "Utf8.hpp"
+
+
+namespace
+{
+    constexpr std::size_t CHUNK_QUEUE_CAPACITY = 4;
+    constexpr std::size_t JOB_QUEUE_CAPACITY = 1024;
+    constexpr std::size_t RESULT_QUEUE_CAPACITY = 1024;
+
+
+    // A Chunk is a piece of the input, along with where it begins: its
+    // offset from the start of the input, the line it begins on, and how
+    // many bytes of that line come before it.  A chunk cut from a text in
+    // memory refers to it; one read from a stream holds its own copy.
+    struct Chunk
+    {
+        std::string storage;
+        std::string_view external;
+        std::size_t offset = 0;
+        std::size_t line = 1;
+        std::size_t column = 0;
+
+        std::string_view text() const noexcept
+        {
+            return storage.empty() ? external : std::string_view{storage};
+        }
+    };
+
+
+    // A Job is a misspelled word waiting for suggestions; its sequence
+    // number gives its place in the output.
+    struct Job
+    {
+        std::size_t sequence = 0;
+        std::string upper;
+        std::string word;
+        std::size_t offset = 0;
+        std::size_t line = 0;
+        std::size_t column = 0;
+    };
+
+
+    // A Result is the line of output for one Job.
+    struct Result
+    {
+        std::size_t sequence = 0;
+        std::string text;
+    };
+
+
+    // isWordByte() agrees with DocumentTokenizer about which bytes can be
+    // part of a word, including every byte of a multi-byte character.
+    bool isWordByte(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '\''
+            || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+
+    // cutPoint() returns where the given text can be cut without cutting
+    // a word in two: just past the last byte that can't be part of a word,
+    // or 0 if every byte can.
+    std::size_t cutPoint(std::string_view text)
+    {
+        for (std::size_t i = text.size(); i > 0; --i)
+        {
+            if (!isWordByte(text[i - 1]))
+            {
+                return i;
+            }
+        }
+
+        return 0;
+    }
+}
+
+
+
+class PipelineChecker::Run
+{
+public:
+    explicit Run(const PipelineChecker& pipeline);
+
+    // run() runs the pipeline, with its reader calling readChunk() for
+    // each chunk of input until it returns false.
+    template <typename ReadChunk>
+    BatchStatistics run(ReadChunk readChunk, BatchOutput& output);
+
+private:
+    const PipelineChecker& pipeline;
+
+    SpscQueue<Chunk> chunks;
+    MpmcQueue<Job> jobs;
+    MpmcQueue<Result> results;
+
+    // The number of lines the writer has written, which the tokenizer
+    // keeps within WINDOW of the number of misspelled words it's found.
+    std::atomic<std::size_t> written;
+    std::atomic<unsigned int> activeWorkers;
+
+    std::atomic<bool> failed;
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+    // Each of these is only touched by one stage until the threads are
+    // joined.
+    std::size_t bytes;
+    std::size_t words;
+    std::size_t misspellings;
+
+    template <typename ReadChunk>
+    void read(ReadChunk& readChunk);
+    void tokenize();
+    void suggest();
+    void write(BatchOutput& output);
+
+    void fail() noexcept;
+};
+
+
+PipelineChecker::Run::Run(const PipelineChecker& pipeline)
+    : pipeline{pipeline},
+      chunks{CHUNK_QUEUE_CAPACITY}, jobs{JOB_QUEUE_CAPACITY}, results{RESULT_QUEUE_CAPACITY},
+      written{0}, activeWorkers{pipeline.workers}, failed{false},
+      bytes{0}, words{0}, misspellings{0}
+{
+}
+
+
+template <typename ReadChunk>
+BatchStatistics PipelineChecker::Run::run(ReadChunk readChunk, BatchOutput& output)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    try
+    {
+        threads.emplace_back([&] { read(readChunk); });
+        threads.emplace_back([&] { tokenize(); });
+        for (unsigned int i = 0; i < pipeline.workers; ++i)
+        {
+            threads.emplace_back([&] { suggest(); });
+        }
+
+        write(output);
+    }
+    catch (...)
+    {
+        fail();
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    BatchStatistics stats;
+    stats.bytes = bytes;
+    stats.words = words;
+    stats.misspellings = misspellings;
+    stats.seconds = elapsed.count();
+    return stats;
+}
+
+
+template <typename ReadChunk>
+void PipelineChecker::Run::read(ReadChunk& readChunk)
+{
+    try
+    {
+        std::size_t line = 1;
+        std::size_t column = 0;
+
+        for (Chunk chunk; readChunk(chunk); chunk = Chunk{})
+        {
+            std::string_view text = chunk.text();
+
+            chunk.offset = bytes;
+            chunk.line = line;
+            chunk.column = column;
+
+            bytes += text.size();
+
+            std::size_t lastNewline = text.rfind('\n');
+            if (lastNewline == std::string_view::npos)
+            {
+                column += text.size();
+            }
+            else
+            {
+                line += std::count(text.begin(), text.end(), '\n');
+                column = text.size() - lastNewline - 1;
+            }
+
+            if (!chunks.push(std::move(chunk)))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+
+    chunks.close();
+}
+
+
+void PipelineChecker::Run::tokenize()
+{
+    try
+    {
+        Chunk chunk;
+        DocumentToken token;
+        std::string upper;
+        std::size_t sequence = 0;
+
+        while (chunks.pop(chunk))
+        {
+            DocumentTokenizer tokenizer{chunk.text()};
+
+            while (tokenizer.next(token))
+            {
+                upper.assign(token.word.data(), token.word.size());
+                Utf8::foldToUpper(upper);
+                ++words;
+
+                if (pipeline.checker.wordExists(upper))
+                {
+                    continue;
+                }
+
+                ++misspellings;
+
+                for (unsigned int attempts = 0;
+                     sequence - written.load(std::memory_order_acquire) >= WINDOW;
+                     impl_::ConcurrentQueue__wait(attempts))
+                {
+                    if (failed.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+
+                Job job;
+                job.sequence = sequence++;
+                job.upper = upper;
+                job.word.assign(token.word.data(), token.word.size());
+                job.offset = chunk.offset + token.offset;
+                job.line = chunk.line + token.line - 1;
+                job.column = token.line == 1 ? chunk.column + token.column : token.column;
+
+                if (!jobs.push(std::move(job)))
+                {
+                    return;
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+
+    jobs.close();
+}
+
+
+void PipelineChecker::Run::suggest()
+{
+    try
+    {
+        Job job;
+
+        while (!failed.load(std::memory_order_relaxed) && jobs.pop(job))
+        {
+            Result result;
+            result.sequence = job.sequence;
+            formatMisspelling(
+                result.text, job.offset, job.line, job.column, job.word,
+                suggestionsFor(pipeline.checker, job.upper));
+
+            if (!results.push(std::move(result)))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+
+    // The last worker to finish tells the writer there's nothing more.
+    if (activeWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        results.close();
+    }
+}
+
+
+void PipelineChecker::Run::write(BatchOutput& output)
+{
+    // Results arrive in whatever order the workers finish them, so each is
+    // held in its place in a ring of WINDOW slots until every line before
+    // it has been written.  The tokenizer never gets more than WINDOW
+    // lines ahead, so no two lines waiting at once share a slot.
+    std::vector<std::string> waiting(WINDOW);
+    std::vector<bool> ready(WINDOW, false);
+    std::size_t next = 0;
+
+    Result result;
+
+    while (results.pop(result))
+    {
+        std::size_t slot = result.sequence % WINDOW;
+        waiting[slot] = std::move(result.text);
+        ready[slot] = true;
+
+        while (ready[next % WINDOW])
+        {
+            output.append(waiting[next % WINDOW]);
+            ready[next % WINDOW] = false;
+            ++next;
+        }
+
+        written.store(next, std::memory_order_release);
+    }
+}
+
+
+void PipelineChecker::Run::fail() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{failureMutex};
+        if (!failure)
+        {
+            failure = std::current_exception();
+        }
+    }
+
+    failed.store(true, std::memory_order_relaxed);
+    chunks.close();
+    jobs.close();
+    results.close();
+}
+
+
+
+PipelineChecker::PipelineChecker(
+    const WordChecker& checker, unsigned int workerCount, std::size_t chunkSize)
+    : checker{checker}, workers{workerCount}, chunkSize{std::max<std::size_t>(chunkSize, 1)}
+{
+    if (workers == 0)
+    {
+        unsigned int processors = std::thread::hardware_concurrency();
+        workers = processors > 2 ? processors - 1 : 1;
+    }
+}
+
+
+unsigned int PipelineChecker::workerCount() const noexcept
+{
+    return workers;
+}
+
+
+BatchStatistics PipelineChecker::check(std::string_view text, BatchOutput& output) const
+{
+    std::size_t position = 0;
+
+    auto readChunk = [&](Chunk& chunk)
+    {
+        if (position == text.size())
+        {
+            return false;
+        }
+
+        std::size_t end = std::min(position + chunkSize, text.size());
+        std::size_t cut = cutPoint(text.substr(position, end - position));
+
+        if (end == text.size())
+        {
+            // The last chunk can end anywhere.
+        }
+        else if (cut > 0)
+        {
+            end = position + cut;
+        }
+        else
+        {
+            // This chunk is all one long word; it runs to the next byte
+            // that can't be part of a word.
+            while (end < text.size() && isWordByte(text[end]))
+            {
+                ++end;
+            }
+        }
+
+        chunk.external = text.substr(position, end - position);
+        position = end;
+        return true;
+    };
+
+    Run run{*this};
+    return run.run(readChunk, output);
+}
+
+
+BatchStatistics PipelineChecker::check(std::istream& in, BatchOutput& output) const
+{
+    std::string carried;
+
+    auto readChunk = [&](Chunk& chunk)
+    {
+        std::string buffer = std::move(carried);
+        carried.clear();
+
+        for (;;)
+        {
+            std::size_t size = buffer.size();
+            buffer.resize(size + chunkSize);
+            in.read(&buffer[size], chunkSize);
+            buffer.resize(size + static_cast<std::size_t>(in.gcount()));
+
+            if (!in)
+            {
+                break;
+            }
+
+            // Whatever follows the last place the buffer can be cut is
+            // carried into the next chunk, so no word is split in two.
+            std::size_t cut = cutPoint(buffer);
+            if (cut > 0)
+            {
+                carried.assign(buffer, cut, std::string::npos);
+                buffer.resize(cut);
+                break;
+            }
+        }
+
+        if (buffer.empty())
+        {
+            return false;
+        }
+
+        chunk.storage = std::move(buffer);
+        return true;
+    };
+
+    Run run{*this};
+    return run.run(readChunk, output);
+}
@@ -0,0 +1,79 @@
+// PipelineChecker.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A PipelineChecker spell-checks a text, or a stream of unknown length,
+// producing the same output as checkText() (see BatchChecker.hpp), but
+// with the work split into stages that run on separate threads:
+//
+//     read --> tokenize and look up --> suggest (many threads) --> write
+//
+//   * The reader cuts the input into chunks, never in the middle of a word,
+//     reading them from the stream if there is one.
+//   * The tokenizer splits each chunk into words and looks each one up.
+//     Lookups are cheap, so they're done here, and only misspelled words,
+//     numbered in the order they appear, are passed on.
+//   * Suggestions are far more expensive than lookups, so a number of
+//     worker threads generate them, each taking the next misspelled word
+//     from a shared queue and formatting its line of output.
+//   * The writer (the calling thread) puts the workers' lines back into
+//     order and appends them to the output.
+//
+// The stages are connected by bounded lock-free queues (see
+// ConcurrentQueue.hpp): an SpscQueue from the reader to the tokenizer, and
+// MpmcQueues to and from the workers.  Since the queues are bounded, and
+// the tokenizer is never allowed to get more than WINDOW misspelled words
+// ahead of the writer, memory use stays fixed however long the input is,
+// and a stage that falls behind slows the ones feeding it rather than
+// letting work pile up.
+//
+// The WordChecker's set must support contains() from many threads at once,
+// which every Set that isn't being changed does.
+
+#ifndef PIPELINECHECKER_HPP
+#define PIPELINECHECKER_HPP
+
+#include <cstddef>
+#include <istream>
+#include <string_view>
+#include "BatchChecker.hpp"
+#include "WordChecker.hpp"
+
+
+
+class PipelineChecker
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 18;
+    static constexpr std::size_t WINDOW = 4096;
+
+public:
+    // Prepares to check words with the given WordChecker, generating
+    // suggestions on the given number of worker threads (or, if it's 0,
+    // on one fewer than the number of processors, but at least one), and
+    // handing the tokenizer chunks of about the given size.
+    explicit PipelineChecker(
+        const WordChecker& checker, unsigned int workerCount = 0,
+        std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    unsigned int workerCount() const noexcept;
+
+    // check() checks every word in the given text or stream, appending
+    // a line to the given output for each one that's misspelled, in the
+    // order they appear, and returns statistics about the work it did.
+    // An exception thrown by any stage stops the others and is rethrown.
+    BatchStatistics check(std::string_view text, BatchOutput& output) const;
+    BatchStatistics check(std::istream& in, BatchOutput& output) const;
+
+private:
+    const WordChecker& checker;
+    unsigned int workers;
+    std::size_t chunkSize;
+
+    class Run;
+};
+
+
+
+#endif // PIPELINECHECKER_HPP
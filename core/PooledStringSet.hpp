@@ -0,0 +1,124 @@
+// PooledStringSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A PooledStringSet is a Set of strings that keeps the strings themselves
+// in a StringPool and stores only their 32-bit Handles in another kind of
+// set, such as HashSet<StringPool::Handle> or AVLSet<StringPool::Handle>.
+// Since the pool stores each distinct string once, the same dictionary can
+// be kept in several sets sharing one pool without storing its words more
+// than once, and each element costs the set only a Handle rather than a
+// std::string (and the memory it allocates for longer strings).
+//
+// Because the pool gives equal strings equal Handles, a set of Handles
+// answers membership questions for the strings correctly.  Note, though,
+// that the Handles are ordered by where their strings were stored, not
+// alphabetically, so an ordered set of Handles doesn't order the strings.
+//
+// A lookup of a string that was never interned fails in the pool, without
+// searching the set at all.
+
+#ifndef POOLEDSTRINGSET_HPP
+#define POOLEDSTRINGSET_HPP
+
+#include <string>
+#include <utility>
+#include "Set.hpp"
+#include "StringPool.hpp"
+
+
+
+template <typename HandleSet>
+class PooledStringSet : public Set<std::string>
+{
+public:
+    // Initializes a PooledStringSet that stores its strings in the given
+    // pool, which must outlive it, and their Handles in the given set
+    // (which is usually empty to begin with).
+    explicit PooledStringSet(StringPool& pool, HandleSet handles = HandleSet{});
+
+
+    // isImplemented() returns true.
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() interns the given string into the pool and adds its Handle to
+    // the set.
+    virtual void add(const std::string& element) override;
+
+
+    // contains() returns true if the given string is in the pool and its
+    // Handle is in the set.
+    virtual bool contains(const std::string& element) const override;
+
+
+    // size() returns the number of strings in the set, which can be fewer
+    // than the number in the pool when the pool is shared.
+    virtual unsigned int size() const noexcept override;
+
+
+    // pool() and handles() return the pool and the set of Handles.
+    StringPool& pool() const noexcept;
+    const HandleSet& handles() const noexcept;
+
+
+private:
+    StringPool* stringPool;
+    HandleSet handleSet;
+};
+
+
+
+template <typename HandleSet>
+PooledStringSet<HandleSet>::PooledStringSet(StringPool& pool, HandleSet handles)
+    : stringPool{&pool}, handleSet{std::move(handles)}
+{
+}
+
+
+template <typename HandleSet>
+bool PooledStringSet<HandleSet>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename HandleSet>
+void PooledStringSet<HandleSet>::add(const std::string& element)
+{
+    handleSet.add(stringPool->intern(element));
+}
+
+
+template <typename HandleSet>
+bool PooledStringSet<HandleSet>::contains(const std::string& element) const
+{
+    StringPool::Handle handle;
+    return stringPool->find(element, handle) && handleSet.contains(handle);
+}
+
+
+template <typename HandleSet>
+unsigned int PooledStringSet<HandleSet>::size() const noexcept
+{
+    return handleSet.size();
+}
+
+
+template <typename HandleSet>
+StringPool& PooledStringSet<HandleSet>::pool() const noexcept
+{
+    return *stringPool;
+}
+
+
+template <typename HandleSet>
+const HandleSet& PooledStringSet<HandleSet>::handles() const noexcept
+{
+    return handleSet;
+}
+
+
+
+#endif // POOLEDSTRINGSET_HPP
@@ -0,0 +1,54 @@
+// PrefixBound.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Helpers shared by the ordered sets (AVLSet, SkipListSet) when they answer
+// "every element starting with this prefix" queries.  In an ordered set of
+// strings, the elements with a given prefix form one contiguous run that
+// starts at the prefix itself and ends just before the smallest string that
+// is greater than all of them; these functions compute those boundaries.
+
+#ifndef PREFIXBOUND_HPP
+#define PREFIXBOUND_HPP
+
+#include <string>
+
+
+
+namespace impl_
+{
+    // startsWith() returns true if the given string begins with the given
+    // prefix, false otherwise.
+    inline bool startsWith(const std::string& s, const std::string& prefix)
+    {
+        return s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+
+    // prefixUpperBound() stores into "bound" the smallest string that is
+    // greater than every string starting with the given prefix, which is
+    // the prefix with its last non-0xFF byte incremented and everything
+    // after it dropped.  It returns false when there is no such string
+    // (the prefix is empty or made up entirely of 0xFF bytes), in which
+    // case the run of matching strings extends to the end of the set.
+    inline bool prefixUpperBound(const std::string& prefix, std::string& bound)
+    {
+        bound = prefix;
+        while (!bound.empty())
+        {
+            unsigned char last = static_cast<unsigned char>(bound.back());
+            if (last != 0xFF)
+            {
+                bound.back() = static_cast<char>(last + 1);
+                return true;
+            }
+            bound.pop_back();
+        }
+        return false;
+    }
+}
+
+
+
+#endif // PREFIXBOUND_HPP
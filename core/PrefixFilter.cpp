@@ -0,0 +1,130 @@
+// PrefixFilter.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "PrefixFilter.hpp"
+#include "Utf8.hpp"
+
+
+namespace
+{
+    // characterAt() returns the character at the given position of the
+    // given word, as an int, or -1 if the word isn't that long, which
+    // sorts a word before every longer word starting with it, as
+    // std::string's own ordering does.
+    int characterAt(const std::string& word, std::size_t depth)
+    {
+        return depth < word.size() ? static_cast<unsigned char>(word[depth]) : -1;
+    }
+
+
+    // Ranges at least this long are narrowed by binary search; shorter
+    // ones, which most are once a prefix is a few characters long, are
+    // scanned instead.
+    constexpr std::size_t SEARCH_THRESHOLD = 16;
+
+
+    // endOfRun() returns the end of the run of words, starting at "first",
+    // whose character at the given depth is "target".
+    std::vector<std::string>::const_iterator endOfRun(
+        std::vector<std::string>::const_iterator first, std::vector<std::string>::const_iterator end,
+        std::size_t depth, int target)
+    {
+        auto matches = [&](const std::string& word) { return characterAt(word, depth) == target; };
+
+        if (static_cast<std::size_t>(end - first) < SEARCH_THRESHOLD)
+        {
+            return std::find_if_not(first, end, matches);
+        }
+
+        return std::partition_point(first, end, matches);
+    }
+}
+
+
+PrefixFilter::PrefixFilter(std::vector<std::string> words)
+    : words{std::move(words)}
+{
+    for (std::string& word : this->words)
+    {
+        Utf8::foldToUpper(word);
+    }
+
+    std::sort(this->words.begin(), this->words.end());
+    this->words.erase(std::unique(this->words.begin(), this->words.end()), this->words.end());
+}
+
+
+PrefixFilter::Range PrefixFilter::all() const noexcept
+{
+    return Range{0, words.size()};
+}
+
+
+PrefixFilter::Range PrefixFilter::narrow(Range range, std::size_t depth, char c) const
+{
+    int target = static_cast<unsigned char>(c);
+    auto begin = words.begin() + range.first;
+    auto end = words.begin() + range.last;
+
+    auto before = [&](const std::string& word) { return characterAt(word, depth) < target; };
+
+    auto first = static_cast<std::size_t>(end - begin) < SEARCH_THRESHOLD
+        ? std::find_if_not(begin, end, before)
+        : std::partition_point(begin, end, before);
+    auto last = endOfRun(first, end, depth, target);
+
+    return Range{
+        static_cast<std::size_t>(first - words.begin()),
+        static_cast<std::size_t>(last - words.begin())};
+}
+
+
+void PrefixFilter::branches(Range range, std::size_t depth, std::vector<Branch>& out) const
+{
+    out.clear();
+
+    auto first = words.begin() + range.first;
+    auto end = words.begin() + range.last;
+
+    // A word that's only "depth" characters long has nothing next, and
+    // sorts before the rest.
+    if (first != end && characterAt(*first, depth) < 0)
+    {
+        ++first;
+    }
+
+    while (first != end)
+    {
+        int c = characterAt(*first, depth);
+        auto last = endOfRun(first, end, depth, c);
+
+        out.push_back(Branch{
+            static_cast<char>(c),
+            Range{static_cast<std::size_t>(first - words.begin()), static_cast<std::size_t>(last - words.begin())}});
+
+        first = last;
+    }
+}
+
+
+bool PrefixFilter::hasPrefix(std::string_view prefix) const
+{
+    Range range = all();
+
+    for (std::size_t depth = 0; depth < prefix.size() && !range.empty(); ++depth)
+    {
+        range = narrow(range, depth, prefix[depth]);
+    }
+
+    return !range.empty();
+}
+
+
+std::size_t PrefixFilter::size() const noexcept
+{
+    return words.size();
+}
@@ -0,0 +1,96 @@
+// PrefixFilter.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A PrefixFilter answers "does any word in the dictionary start with this
+// prefix?", which lets a search for suggestions give up on a candidate as
+// soon as the part of it that's been decided can't begin any word.
+//
+// The words are kept in one sorted array, which serves as a trie without
+// the pointers: the words starting with a given prefix form one contiguous
+// Range of it, and the words starting with that prefix followed by one more
+// character form a smaller Range within that one, found by binary search.
+// Extending a prefix one character at a time, as the search does, narrows a
+// Range it already has rather than searching the whole array again.
+//
+// Words are stored in upper case, as the dictionary's are; prefixes are
+// compared exactly, so they should be too.  The "characters" here are
+// bytes: a letter that takes more than one byte of UTF-8 is as many steps
+// down the trie, and since UTF-8 sorts in the same order as the letters it
+// encodes, the words are still in order.
+
+#ifndef PREFIXFILTER_HPP
+#define PREFIXFILTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class PrefixFilter
+{
+public:
+    // A Range is a run of the sorted words, from "first" up to but not
+    // including "last".
+    struct Range
+    {
+        std::size_t first;
+        std::size_t last;
+
+        bool empty() const noexcept
+        {
+            return first == last;
+        }
+    };
+
+    // A Branch is one of the characters that follows a prefix in some
+    // word, along with the Range of words in which it does.
+    struct Branch
+    {
+        char c;
+        Range range;
+    };
+
+public:
+    // Initializes a PrefixFilter holding the given words, less any
+    // duplicates, in upper case.
+    explicit PrefixFilter(std::vector<std::string> words);
+
+
+    // all() returns the Range of every word, i.e., those starting with
+    // the empty prefix.
+    Range all() const noexcept;
+
+
+    // narrow() returns the part of the given Range, whose words all share
+    // their first "depth" characters, whose words have the given character
+    // next.
+    Range narrow(Range range, std::size_t depth, char c) const;
+
+
+    // branches() fills "out" with the characters that come next in the
+    // words of the given Range, whose words all share their first "depth"
+    // characters, in order, each with the part of the Range having it
+    // next.  This takes a search per character that's there, rather than
+    // one per character that might be.
+    void branches(Range range, std::size_t depth, std::vector<Branch>& out) const;
+
+
+    // hasPrefix() returns true if any word starts with the given prefix.
+    bool hasPrefix(std::string_view prefix) const;
+
+
+    // size() returns the number of words.
+    std::size_t size() const noexcept;
+
+
+private:
+    std::vector<std::string> words;
+};
+
+
+
+#endif // PREFIXFILTER_HPP
@@ -0,0 +1,172 @@
+// SetSerialization.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include "SetSerialization.hpp"
+
+
+namespace
+{
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::size_t KIND_SIZE = 4;
+}
+
+
+SnapshotException::SnapshotException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& SnapshotException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+SnapshotWriter::SnapshotWriter(std::ostream& out)
+    : out{out}, buffer{new char[BUFFER_SIZE]}, used{0}
+{
+}
+
+
+void SnapshotWriter::write(const void* data, std::size_t size)
+{
+    if (used + size > BUFFER_SIZE)
+    {
+        flush();
+
+        // Anything too big for the buffer goes straight to the stream.
+        if (size > BUFFER_SIZE)
+        {
+            out.write(static_cast<const char*>(data), size);
+            return;
+        }
+    }
+
+    std::memcpy(buffer.get() + used, data, size);
+    used += size;
+}
+
+
+void SnapshotWriter::writeHeader(const char* kind, std::uint32_t version)
+{
+    write(kind, KIND_SIZE);
+    writeValue(BYTE_ORDER_MARK);
+    writeValue(version);
+}
+
+
+void SnapshotWriter::flush()
+{
+    out.write(buffer.get(), used);
+    used = 0;
+
+    if (!out)
+    {
+        throw SnapshotException{"Cannot write snapshot"};
+    }
+}
+
+
+SnapshotReader::SnapshotReader(std::istream& in)
+    : in{in}, buffer{new char[BUFFER_SIZE]}, position{0}, available{0}
+{
+}
+
+
+void SnapshotReader::read(void* data, std::size_t size)
+{
+    char* p = static_cast<char*>(data);
+
+    while (size > 0)
+    {
+        if (position == available)
+        {
+            // Anything too big for the buffer is read straight from the
+            // stream.
+            if (size >= BUFFER_SIZE)
+            {
+                in.read(p, size);
+                if (static_cast<std::size_t>(in.gcount()) != size)
+                {
+                    throw SnapshotException{"Snapshot ends unexpectedly"};
+                }
+                return;
+            }
+
+            in.read(buffer.get(), BUFFER_SIZE);
+            position = 0;
+            available = in.gcount();
+
+            if (available == 0)
+            {
+                throw SnapshotException{"Snapshot ends unexpectedly"};
+            }
+        }
+
+        std::size_t chunk = std::min(size, available - position);
+        std::memcpy(p, buffer.get() + position, chunk);
+        position += chunk;
+        p += chunk;
+        size -= chunk;
+    }
+}
+
+
+void SnapshotReader::readHeader(const char* kind, std::uint32_t version)
+{
+    char actualKind[KIND_SIZE];
+    read(actualKind, KIND_SIZE);
+
+    if (std::memcmp(actualKind, kind, KIND_SIZE) != 0)
+    {
+        throw SnapshotException{"Not a snapshot of a " + std::string(kind, KIND_SIZE)};
+    }
+    if (readValue<std::uint32_t>() != BYTE_ORDER_MARK)
+    {
+        throw SnapshotException{"Snapshot was written on a machine with a different byte order"};
+    }
+    if (readValue<std::uint32_t>() != version)
+    {
+        throw SnapshotException{"Snapshot is in an unsupported format"};
+    }
+}
+
+
+void SnapshotReader::finish()
+{
+    std::size_t unread = available - position;
+
+    // Reading ahead may have run into the end of the stream, which isn't
+    // an error as far as the stream's user is concerned.
+    if (in.eof())
+    {
+        in.clear();
+    }
+    if (unread > 0)
+    {
+        in.seekg(-static_cast<std::streamoff>(unread), std::ios::cur);
+    }
+
+    position = 0;
+    available = 0;
+}
+
+
+void SnapshotCodec<std::string>::write(SnapshotWriter& writer, const std::string& element)
+{
+    writer.writeValue(static_cast<std::uint32_t>(element.size()));
+    writer.write(element.data(), element.size());
+}
+
+
+std::string SnapshotCodec<std::string>::read(SnapshotReader& reader)
+{
+    std::string element(reader.readValue<std::uint32_t>(), '\0');
+    reader.read(&element[0], element.size());
+    return element;
+}
@@ -0,0 +1,164 @@
+// SetSerialization.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// These are the pieces shared by the save() and load() member functions of
+// HashSet and AVLSet, which write a snapshot of a set's exact structure to
+// a stream and read it back, so that loading it needn't hash or compare
+// anything.
+//
+// A SnapshotWriter and a SnapshotReader move bytes to and from a stream in
+// large blocks, through a buffer of their own, rather than one element at
+// a time.  Every snapshot starts with a header naming the kind of set it
+// holds, the version of its format and the byte order of the machine that
+// wrote it, since numbers are written as they are laid out in memory.
+//
+// A SnapshotCodec<T> writes and reads one element of type T.  Any type
+// that is trivially copyable is written as its bytes, and std::string is
+// written as its length followed by its characters; other types can be
+// saved by specializing SnapshotCodec for them.
+
+#ifndef SETSERIALIZATION_HPP
+#define SETSERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+
+
+// A SnapshotException is thrown when a snapshot can't be written, or when
+// what's being loaded isn't a snapshot of the expected kind of set.
+class SnapshotException
+{
+public:
+    explicit SnapshotException(const std::string& reason);
+
+    const std::string& reason() const noexcept;
+
+private:
+    std::string reason_;
+};
+
+
+
+class SnapshotWriter
+{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+public:
+    explicit SnapshotWriter(std::ostream& out);
+
+    // write() appends the given bytes to the snapshot.
+    void write(const void* data, std::size_t size);
+
+    // writeValue() appends the bytes of a trivially copyable value.
+    template <typename T>
+    void writeValue(const T& value);
+
+    // writeHeader() writes the header for the given kind of set, which is
+    // named by exactly four characters.
+    void writeHeader(const char* kind, std::uint32_t version);
+
+    // flush() writes out whatever is buffered, throwing a SnapshotException
+    // if the stream has failed.  It must be called once everything has
+    // been written.
+    void flush();
+
+private:
+    std::ostream& out;
+    std::unique_ptr<char[]> buffer;
+    std::size_t used;
+};
+
+
+
+class SnapshotReader
+{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+public:
+    explicit SnapshotReader(std::istream& in);
+
+    // read() fills the given bytes from the snapshot, throwing a
+    // SnapshotException if the stream ends first.
+    void read(void* data, std::size_t size);
+
+    // readValue() reads the bytes of a trivially copyable value.
+    template <typename T>
+    T readValue();
+
+    // readHeader() reads a header and throws a SnapshotException unless it
+    // names the given kind of set and version, in this machine's byte
+    // order.
+    void readHeader(const char* kind, std::uint32_t version);
+
+    // finish() gives back to the stream whatever was read ahead of the
+    // end of the snapshot, by seeking back over it, so that the stream is
+    // left just past the snapshot.  It should be called once the whole
+    // snapshot has been read.
+    void finish();
+
+private:
+    std::istream& in;
+    std::unique_ptr<char[]> buffer;
+    std::size_t position;
+    std::size_t available;
+};
+
+
+
+template <typename T, typename = void>
+struct SnapshotCodec
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Specialize SnapshotCodec to save elements that aren't trivially copyable");
+
+    static void write(SnapshotWriter& writer, const T& element)
+    {
+        writer.writeValue(element);
+    }
+
+    static T read(SnapshotReader& reader)
+    {
+        return reader.readValue<T>();
+    }
+};
+
+
+template <>
+struct SnapshotCodec<std::string>
+{
+    static void write(SnapshotWriter& writer, const std::string& element);
+    static std::string read(SnapshotReader& reader);
+};
+
+
+
+template <typename T>
+void SnapshotWriter::writeValue(const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "writeValue() copies bytes");
+    write(&value, sizeof(T));
+}
+
+
+template <typename T>
+T SnapshotReader::readValue()
+{
+    static_assert(std::is_trivially_copyable<T>::value, "readValue() copies bytes");
+    T value;
+    read(&value, sizeof(T));
+    return value;
+}
+
+
+
+#endif // SETSERIALIZATION_HPP
@@ -0,0 +1,181 @@
+// SpellCheckClient.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "SpellCheckClient.hpp"
+
+
+namespace
+{
+    std::string describeError(const std::string& what)
+    {
+        return what + ": " + std::strerror(errno);
+    }
+}
+
+
+SpellCheckClient::ClientException::ClientException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& SpellCheckClient::ClientException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+SpellCheckClient::SpellCheckClient(const std::string& socketPath)
+    : fd{-1}
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw ClientException{"Invalid socket path " + socketPath};
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        throw ClientException{describeError("Cannot create socket")};
+    }
+
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        std::string reason = describeError("Cannot connect to " + socketPath);
+        ::close(fd);
+        throw ClientException{reason};
+    }
+}
+
+
+SpellCheckClient::~SpellCheckClient() noexcept
+{
+    ::close(fd);
+}
+
+
+bool SpellCheckClient::check(const std::string& word)
+{
+    std::string response = request("CHECK " + word);
+
+    if (response.compare(0, 3, "OK ") == 0)
+    {
+        return true;
+    }
+    else if (response.compare(0, 11, "MISSPELLED ") == 0)
+    {
+        return false;
+    }
+
+    throw ClientException{"Unexpected response: " + response};
+}
+
+
+std::vector<std::string> SpellCheckClient::suggest(const std::string& word)
+{
+    std::string response = request("SUGGEST " + word);
+
+    std::istringstream in{response};
+    std::string tag;
+    std::string echoed;
+
+    if (!(in >> tag >> echoed) || tag != "SUGGESTIONS")
+    {
+        throw ClientException{"Unexpected response: " + response};
+    }
+
+    std::vector<std::string> suggestions;
+    for (std::string suggestion; in >> suggestion; )
+    {
+        suggestions.push_back(suggestion);
+    }
+    return suggestions;
+}
+
+
+std::string SpellCheckClient::request(const std::string& line)
+{
+    send(line + '\n');
+    return receiveLine();
+}
+
+
+std::vector<std::string> SpellCheckClient::requestMany(const std::vector<std::string>& lines)
+{
+    std::string requests;
+    for (const std::string& line : lines)
+    {
+        requests += line;
+        requests += '\n';
+    }
+    send(requests);
+
+    std::vector<std::string> responses;
+    responses.reserve(lines.size());
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        responses.push_back(receiveLine());
+    }
+    return responses;
+}
+
+
+void SpellCheckClient::send(const std::string& data)
+{
+    std::size_t sent = 0;
+
+    while (sent < data.size())
+    {
+        ssize_t count = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ClientException{describeError("Cannot send request")};
+        }
+        sent += static_cast<std::size_t>(count);
+    }
+}
+
+
+std::string SpellCheckClient::receiveLine()
+{
+    for (;;)
+    {
+        std::size_t newline = input.find('\n');
+        if (newline != std::string::npos)
+        {
+            std::string line = input.substr(0, newline);
+            input.erase(0, newline + 1);
+            return line;
+        }
+
+        char buffer[4096];
+        ssize_t count = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (count > 0)
+        {
+            input.append(buffer, static_cast<std::size_t>(count));
+        }
+        else if (count == 0)
+        {
+            throw ClientException{"Connection closed by server"};
+        }
+        else if (errno != EINTR)
+        {
+            throw ClientException{describeError("Cannot receive response")};
+        }
+    }
+}
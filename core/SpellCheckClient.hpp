@@ -0,0 +1,72 @@
+// SpellCheckClient.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckClient connects to a SpellCheckServer's socket and makes
+// requests of it (see SpellCheckServer.hpp for the protocol).  Each
+// request waits for its response, except for requestMany(), which sends a
+// whole list of requests before reading any of the responses, so that
+// they cost one round trip between them rather than one each.
+
+#ifndef SPELLCHECKCLIENT_HPP
+#define SPELLCHECKCLIENT_HPP
+
+#include <string>
+#include <vector>
+
+
+
+class SpellCheckClient
+{
+public:
+    // A ClientException is thrown when the server can't be reached, or
+    // when the connection to it fails.
+    class ClientException
+    {
+    public:
+        explicit ClientException(const std::string& reason);
+
+        const std::string& reason() const noexcept;
+
+    private:
+        std::string reason_;
+    };
+
+public:
+    // Connects to the server listening on the socket with the given path,
+    // throwing a ClientException if that fails.
+    explicit SpellCheckClient(const std::string& socketPath);
+
+    // Closes the connection.
+    ~SpellCheckClient() noexcept;
+
+    SpellCheckClient(const SpellCheckClient& c) = delete;
+    SpellCheckClient& operator=(const SpellCheckClient& c) = delete;
+
+    // check() returns true if the server says the given word is spelled
+    // correctly.
+    bool check(const std::string& word);
+
+    // suggest() returns the server's suggestions for the given word.
+    std::vector<std::string> suggest(const std::string& word);
+
+    // request() sends one line (without its newline) and returns the
+    // response line (without its newline).
+    std::string request(const std::string& line);
+
+    // requestMany() sends all of the given lines, then returns all of the
+    // responses, in the same order.
+    std::vector<std::string> requestMany(const std::vector<std::string>& lines);
+
+private:
+    int fd;
+    std::string input;
+
+    void send(const std::string& data);
+    std::string receiveLine();
+};
+
+
+
+#endif // SPELLCHECKCLIENT_HPP
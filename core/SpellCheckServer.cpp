@@ -0,0 +1,713 @@
+// SpellCheckServer.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "BatchChecker.hpp"
+#include "SpellCheckServer.hpp"
+#include "Utf8.hpp"
+
+
+namespace
+{
+    constexpr std::uint64_t LISTEN_ID = 0;
+    constexpr std::uint64_t WAKE_ID = 1;
+    constexpr std::uint64_t FIRST_CONNECTION_ID = 2;
+
+    constexpr int MAX_EVENTS = 64;
+    constexpr std::size_t READ_SIZE = 16384;
+
+
+    std::string describeError(const std::string& what)
+    {
+        return what + ": " + std::strerror(errno);
+    }
+
+
+    std::string_view withoutCarriageReturn(std::string_view request)
+    {
+        if (!request.empty() && request.back() == '\r')
+        {
+            request.remove_suffix(1);
+        }
+        return request;
+    }
+
+
+    // A Job is one SUGGEST request, identified by the connection it came
+    // from and its place among that connection's responses.
+    struct Job
+    {
+        std::uint64_t connection;
+        std::uint64_t sequence;
+        std::string word;
+        std::string response;
+    };
+
+
+    void writeSuggestions(const WordChecker& checker, Job& job)
+    {
+        std::vector<std::string> suggestions = suggestionsFor(checker, Utf8::toUpper(job.word));
+
+        job.response = "SUGGESTIONS ";
+        job.response += job.word;
+
+        for (std::size_t i = 0; i < suggestions.size(); ++i)
+        {
+            auto previous = suggestions.begin() + i;
+            if (std::find(suggestions.begin(), previous, suggestions[i]) == previous)
+            {
+                job.response += ' ';
+                job.response += suggestions[i];
+            }
+        }
+
+        job.response += '\n';
+    }
+}
+
+
+SpellCheckServer::ServerException::ServerException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& SpellCheckServer::ServerException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+
+// A Loop is the state of one call to run(): the epoll instance, the
+// connections, and the worker pool, none of which outlive it.
+class SpellCheckServer::Loop
+{
+public:
+    explicit Loop(SpellCheckServer& server);
+    ~Loop() noexcept;
+
+    void run();
+
+private:
+    // A Connection holds what's been read from one client but not yet
+    // handled, the responses it's owed, in order (some of which may still
+    // be with the workers), and what's waiting to be written to it.
+    struct Response
+    {
+        bool ready;
+        std::string text;
+    };
+
+    struct Connection
+    {
+        int fd;
+        std::uint64_t id;
+        std::string input;
+        std::deque<Response> responses;
+        std::uint64_t firstSequence = 0;
+        std::string output;
+        bool readClosed = false;
+        std::uint32_t watched = EPOLLIN | EPOLLRDHUP;
+    };
+
+    SpellCheckServer& server;
+    int epollFd;
+    std::uint64_t nextId;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Connection>> connections;
+
+    // Jobs gathered during the current pass through the loop, to be handed
+    // to the workers once every ready socket has been read.
+    std::vector<Job> gathered;
+
+    std::mutex jobMutex;
+    std::condition_variable jobsAvailable;
+    std::deque<std::vector<Job>> batches;
+    bool finished;
+
+    std::mutex doneMutex;
+    std::vector<Job> done;
+
+    std::vector<std::thread> threads;
+
+    void shutDown() noexcept;
+    void watch(int fd, std::uint64_t id, std::uint32_t events);
+
+    void acceptConnections();
+    void readFrom(Connection& connection);
+    void handleRequest(Connection& connection, std::string_view request);
+    void writeTo(Connection& connection);
+    void close(Connection& connection);
+
+    void dispatchJobs();
+    void collectJobs();
+    void work();
+};
+
+
+SpellCheckServer::Loop::Loop(SpellCheckServer& server)
+    : server{server}, epollFd{-1}, nextId{FIRST_CONNECTION_ID}, finished{false}
+{
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        throw ServerException{describeError("Cannot create epoll instance")};
+    }
+
+    try
+    {
+        watch(server.listenFd, LISTEN_ID, EPOLLIN);
+        watch(server.wakeFd, WAKE_ID, EPOLLIN);
+
+        for (unsigned int i = 0; i < server.workers; ++i)
+        {
+            threads.emplace_back([this] { work(); });
+        }
+    }
+    catch (...)
+    {
+        shutDown();
+        throw;
+    }
+}
+
+
+SpellCheckServer::Loop::~Loop() noexcept
+{
+    shutDown();
+}
+
+
+void SpellCheckServer::Loop::shutDown() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{jobMutex};
+        finished = true;
+    }
+    jobsAvailable.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+
+    for (auto& entry : connections)
+    {
+        ::close(entry.second->fd);
+    }
+    connections.clear();
+
+    if (epollFd >= 0)
+    {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+}
+
+
+void SpellCheckServer::Loop::run()
+{
+    epoll_event events[MAX_EVENTS];
+
+    while (!server.stopping.load(std::memory_order_acquire))
+    {
+        int count = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ServerException{describeError("Cannot wait for events")};
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            std::uint64_t id = events[i].data.u64;
+
+            if (id == LISTEN_ID)
+            {
+                acceptConnections();
+                continue;
+            }
+            else if (id == WAKE_ID)
+            {
+                std::uint64_t wakeups;
+                while (::read(server.wakeFd, &wakeups, sizeof(wakeups)) > 0)
+                {
+                }
+                collectJobs();
+                continue;
+            }
+
+            // A connection may have been closed by an earlier event in the
+            // same pass.
+            auto found = connections.find(id);
+            if (found == connections.end())
+            {
+                continue;
+            }
+
+            Connection& connection = *found->second;
+
+            if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+            {
+                close(connection);
+                continue;
+            }
+            if ((events[i].events & EPOLLIN) != 0)
+            {
+                readFrom(connection);
+            }
+            if (connections.count(id) != 0)
+            {
+                writeTo(connection);
+            }
+        }
+
+        dispatchJobs();
+    }
+}
+
+
+void SpellCheckServer::Loop::watch(int fd, std::uint64_t id, std::uint32_t events)
+{
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = id;
+
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        throw ServerException{describeError("Cannot watch socket")};
+    }
+}
+
+
+void SpellCheckServer::Loop::acceptConnections()
+{
+    for (;;)
+    {
+        int fd = ::accept4(server.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            // EAGAIN means every waiting client has been accepted; anything
+            // else (say, running out of descriptors) only affects the one
+            // client, who can try again.
+            return;
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->id = nextId++;
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = connection->id;
+
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        connections.emplace(connection->id, std::move(connection));
+    }
+}
+
+
+void SpellCheckServer::Loop::readFrom(Connection& connection)
+{
+    char buffer[READ_SIZE];
+
+    while (!connection.readClosed)
+    {
+        ssize_t count = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+
+        if (count > 0)
+        {
+            connection.input.append(buffer, static_cast<std::size_t>(count));
+        }
+        else if (count == 0)
+        {
+            // The client has sent all its requests, but it's still owed
+            // responses to them.
+            connection.readClosed = true;
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        else
+        {
+            close(connection);
+            return;
+        }
+    }
+
+    std::size_t start = 0;
+    for (std::size_t end; (end = connection.input.find('\n', start)) != std::string::npos; start = end + 1)
+    {
+        handleRequest(connection, withoutCarriageReturn({connection.input.data() + start, end - start}));
+    }
+    connection.input.erase(0, start);
+
+    // The last request needn't end with a newline; once the client has
+    // stopped sending, whatever is left over is that request.
+    if (connection.readClosed && !connection.input.empty()
+        && connection.input.size() <= MAX_REQUEST_LENGTH)
+    {
+        handleRequest(connection, withoutCarriageReturn(connection.input));
+        connection.input.clear();
+    }
+
+    if (connection.input.size() > MAX_REQUEST_LENGTH)
+    {
+        connection.responses.push_back(Response{true, "ERROR request too long\n"});
+        connection.input.clear();
+        connection.readClosed = true;
+        ::shutdown(connection.fd, SHUT_RD);
+    }
+}
+
+
+void SpellCheckServer::Loop::handleRequest(Connection& connection, std::string_view request)
+{
+    std::size_t space = request.find(' ');
+    std::string_view command = request.substr(0, space);
+    std::string_view word = space == std::string_view::npos ? std::string_view{} : request.substr(space + 1);
+
+    if (word.empty() || word.find(' ') != std::string_view::npos)
+    {
+        connection.responses.push_back(Response{true, "ERROR expected a command and one word\n"});
+    }
+    else if (command == "CHECK")
+    {
+        bool correct = server.checker.wordExists(Utf8::toUpper(word));
+
+        std::string response{correct ? "OK " : "MISSPELLED "};
+        response += word;
+        response += '\n';
+        connection.responses.push_back(Response{true, std::move(response)});
+    }
+    else if (command == "SUGGEST")
+    {
+        std::uint64_t sequence = connection.firstSequence + connection.responses.size();
+        connection.responses.push_back(Response{false, std::string{}});
+        gathered.push_back(Job{connection.id, sequence, std::string{word}, std::string{}});
+    }
+    else
+    {
+        connection.responses.push_back(Response{true, "ERROR unknown command\n"});
+    }
+}
+
+
+void SpellCheckServer::Loop::writeTo(Connection& connection)
+{
+    while (!connection.responses.empty() && connection.responses.front().ready)
+    {
+        connection.output += connection.responses.front().text;
+        connection.responses.pop_front();
+        ++connection.firstSequence;
+    }
+
+    std::size_t sent = 0;
+    while (sent < connection.output.size())
+    {
+        ssize_t count = ::send(
+            connection.fd, connection.output.data() + sent, connection.output.size() - sent,
+            MSG_NOSIGNAL);
+
+        if (count >= 0)
+        {
+            sent += static_cast<std::size_t>(count);
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        else
+        {
+            close(connection);
+            return;
+        }
+    }
+    connection.output.erase(0, sent);
+
+    if (connection.readClosed && connection.responses.empty() && connection.output.empty())
+    {
+        close(connection);
+        return;
+    }
+
+    // The socket is only watched for room to write while there's something
+    // waiting to be written, and only for more requests until the client
+    // has finished sending them; otherwise, it would always be ready.
+    std::uint32_t wanted =
+        (connection.readClosed ? 0 : std::uint32_t{EPOLLIN} | EPOLLRDHUP)
+        | (connection.output.empty() ? 0 : std::uint32_t{EPOLLOUT});
+
+    if (wanted != connection.watched)
+    {
+        epoll_event event{};
+        event.events = wanted;
+        event.data.u64 = connection.id;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.watched = wanted;
+    }
+}
+
+
+void SpellCheckServer::Loop::close(Connection& connection)
+{
+    ::close(connection.fd);
+    connections.erase(connection.id);
+}
+
+
+void SpellCheckServer::Loop::dispatchJobs()
+{
+    if (gathered.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{jobMutex};
+
+        for (std::size_t i = 0; i < gathered.size(); i += BATCH_SIZE)
+        {
+            std::size_t end = std::min(i + BATCH_SIZE, gathered.size());
+            batches.emplace_back(
+                std::make_move_iterator(gathered.begin() + i),
+                std::make_move_iterator(gathered.begin() + end));
+        }
+    }
+
+    jobsAvailable.notify_all();
+    gathered.clear();
+}
+
+
+void SpellCheckServer::Loop::collectJobs()
+{
+    std::vector<Job> finishedJobs;
+    {
+        std::lock_guard<std::mutex> lock{doneMutex};
+        finishedJobs.swap(done);
+    }
+
+    std::vector<std::uint64_t> touched;
+
+    for (Job& job : finishedJobs)
+    {
+        // The client may have disconnected while its job was being done.
+        auto found = connections.find(job.connection);
+        if (found == connections.end())
+        {
+            continue;
+        }
+
+        Connection& connection = *found->second;
+        Response& response = connection.responses[job.sequence - connection.firstSequence];
+        response.text = std::move(job.response);
+        response.ready = true;
+        touched.push_back(job.connection);
+    }
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    for (std::uint64_t id : touched)
+    {
+        auto found = connections.find(id);
+        if (found != connections.end())
+        {
+            writeTo(*found->second);
+        }
+    }
+}
+
+
+void SpellCheckServer::Loop::work()
+{
+    for (;;)
+    {
+        std::vector<Job> batch;
+        {
+            std::unique_lock<std::mutex> lock{jobMutex};
+            jobsAvailable.wait(lock, [this] { return finished || !batches.empty(); });
+
+            if (finished)
+            {
+                return;
+            }
+
+            batch = std::move(batches.front());
+            batches.pop_front();
+        }
+
+        for (Job& job : batch)
+        {
+            writeSuggestions(server.checker, job);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{doneMutex};
+            std::move(batch.begin(), batch.end(), std::back_inserter(done));
+        }
+
+        std::uint64_t one = 1;
+        ssize_t written = ::write(server.wakeFd, &one, sizeof(one));
+        static_cast<void>(written);
+    }
+}
+
+
+
+SpellCheckServer::SpellCheckServer(
+    const WordChecker& checker, const std::string& socketPath, unsigned int workerCount)
+    : checker{checker}, path{socketPath}, workers{workerCount},
+      listenFd{-1}, wakeFd{-1}, stopping{false}
+{
+    if (workers == 0)
+    {
+        unsigned int processors = std::thread::hardware_concurrency();
+        workers = processors > 2 ? processors - 1 : 1;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        throw ServerException{"Invalid socket path " + path};
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        throw ServerException{describeError("Cannot create socket")};
+    }
+
+    auto bindSocket = [&] {
+        return ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    };
+
+    bool bound = bindSocket();
+
+    if (!bound && errno == EADDRINUSE)
+    {
+        // If the path is a socket and nothing answers at it, it was left
+        // behind by a server that's gone, and can be replaced.  Anything
+        // else at the path (connecting to a regular file is refused, too)
+        // is left alone.
+        struct stat status;
+        bool isSocket = ::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode);
+
+        int probe = isSocket ? ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0) : -1;
+        bool stale = probe >= 0
+            && ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+            && errno == ECONNREFUSED;
+        if (probe >= 0)
+        {
+            ::close(probe);
+        }
+
+        if (stale)
+        {
+            ::unlink(path.c_str());
+            bound = bindSocket();
+        }
+        else
+        {
+            errno = EADDRINUSE;
+        }
+    }
+
+    if (!bound)
+    {
+        std::string reason = describeError("Cannot bind socket " + path);
+        ::close(listenFd);
+        throw ServerException{reason};
+    }
+
+    if (::listen(listenFd, SOMAXCONN) != 0)
+    {
+        std::string reason = describeError("Cannot listen on socket " + path);
+        ::close(listenFd);
+        ::unlink(path.c_str());
+        throw ServerException{reason};
+    }
+
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0)
+    {
+        std::string reason = describeError("Cannot create eventfd");
+        ::close(listenFd);
+        ::unlink(path.c_str());
+        throw ServerException{reason};
+    }
+}
+
+
+SpellCheckServer::~SpellCheckServer() noexcept
+{
+    ::close(listenFd);
+    ::close(wakeFd);
+    ::unlink(path.c_str());
+}
+
+
+const std::string& SpellCheckServer::socketPath() const noexcept
+{
+    return path;
+}
+
+
+void SpellCheckServer::run()
+{
+    Loop loop{*this};
+    loop.run();
+}
+
+
+void SpellCheckServer::stop() noexcept
+{
+    // Only async-signal-safe operations are used here: a lock-free atomic
+    // store and a write().
+    stopping.store(true, std::memory_order_release);
+
+    std::uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    static_cast<void>(written);
+}
@@ -0,0 +1,108 @@
+// SpellCheckServer.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SpellCheckServer answers spell-checking requests from other processes
+// over a Unix domain socket, so that a dictionary can be loaded once and
+// then shared by any number of short-lived clients (editors, build tools)
+// instead of being loaded again by each of them.
+//
+// Clients send requests one per line (the last of which needn't end with a
+// newline, if the client then stops sending), and may send several before
+// reading any responses; responses come back one per line in the order the
+// requests were sent:
+//
+//     CHECK WORD      -->  OK WORD                 if WORD is spelled correctly
+//                          MISSPELLED WORD         otherwise
+//     SUGGEST WORD    -->  SUGGESTIONS WORD S1 S2 ...
+//     anything else   -->  ERROR REASON
+//
+// Words are looked up, and suggestions generated (and, when the WordChecker
+// has a table of word frequencies, ranked), in upper case, as they are by
+// the batch checker.  A request longer than MAX_REQUEST_LENGTH is
+// answered with an error, after which the connection is closed.
+//
+// All of the sockets are handled by one thread running an epoll event
+// loop.  CHECK requests are cheap, so that thread answers them itself, but
+// SUGGEST requests are handed to a pool of worker threads.  Requests read
+// in one pass through the loop, from every client that sent any, are
+// gathered into batches of up to BATCH_SIZE, so that a worker's trip
+// through the shared queue is paid for once per batch rather than once per
+// request.  Workers post their results back to the loop, waking it through
+// an eventfd, and the loop puts each connection's responses back in order.
+//
+// This uses epoll and eventfd, so it's specific to Linux.
+
+#ifndef SPELLCHECKSERVER_HPP
+#define SPELLCHECKSERVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include "WordChecker.hpp"
+
+
+
+class SpellCheckServer
+{
+public:
+    // A ServerException is thrown when the server's socket can't be
+    // created, or when the event loop fails.
+    class ServerException
+    {
+    public:
+        explicit ServerException(const std::string& reason);
+
+        const std::string& reason() const noexcept;
+
+    private:
+        std::string reason_;
+    };
+
+public:
+    static constexpr std::size_t MAX_REQUEST_LENGTH = 4096;
+    static constexpr std::size_t BATCH_SIZE = 64;
+
+public:
+    // Creates a socket with the given path and begins listening on it,
+    // throwing a ServerException if that fails.  A socket left behind by
+    // a server that's no longer running is replaced, but anything else
+    // already at the path is an error.  Suggestions will be
+    // generated on the given number of worker threads (or, if it's 0, one
+    // fewer than the number of processors, but at least one).
+    SpellCheckServer(
+        const WordChecker& checker, const std::string& socketPath,
+        unsigned int workerCount = 0);
+
+    // Closes the socket and removes it from the file system.
+    ~SpellCheckServer() noexcept;
+
+    SpellCheckServer(const SpellCheckServer& s) = delete;
+    SpellCheckServer& operator=(const SpellCheckServer& s) = delete;
+
+    const std::string& socketPath() const noexcept;
+
+    // run() answers requests until stop() is called, at which point it
+    // closes every client's connection and returns.
+    void run();
+
+    // stop() asks run() to return.  It can be called from any thread, and
+    // from a signal handler.
+    void stop() noexcept;
+
+private:
+    const WordChecker& checker;
+    std::string path;
+    unsigned int workers;
+
+    int listenFd;
+    int wakeFd;
+    std::atomic<bool> stopping;
+
+    class Loop;
+};
+
+
+
+#endif // SPELLCHECKSERVER_HPP
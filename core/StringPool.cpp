@@ -0,0 +1,192 @@
+// StringPool.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "LengthPrefix.hpp"
+#include "StringPool.hpp"
+
+
+namespace
+{
+    constexpr std::size_t INITIAL_INDEX_SIZE = 1024;
+}
+
+
+StringPool::StringPool()
+    : lastChunkUsed{0}, used{0}, count{0}
+{
+}
+
+
+StringPool::StringPool(StringPool&& p) noexcept
+    : StringPool{}
+{
+    *this = std::move(p);
+}
+
+
+StringPool& StringPool::operator=(StringPool&& p) noexcept
+{
+    if (this != &p)
+    {
+        std::swap(chunks, p.chunks);
+        std::swap(chunkSizes, p.chunkSizes);
+        std::swap(lastChunkUsed, p.lastChunkUsed);
+        std::swap(used, p.used);
+        std::swap(index, p.index);
+        std::swap(count, p.count);
+    }
+
+    return *this;
+}
+
+
+StringPool::Handle StringPool::intern(std::string_view s)
+{
+    if (index.empty() || (count + 1) * 4 > index.size() * 3)
+    {
+        growIndex();
+    }
+
+    std::size_t slot = findSlot(s, std::hash<std::string_view>{}(s));
+
+    if (index[slot] == NO_HANDLE)
+    {
+        index[slot] = store(s);
+        ++count;
+    }
+
+    return index[slot];
+}
+
+
+bool StringPool::find(std::string_view s, Handle& handle) const
+{
+    if (index.empty())
+    {
+        return false;
+    }
+
+    handle = index[findSlot(s, std::hash<std::string_view>{}(s))];
+    return handle != NO_HANDLE;
+}
+
+
+std::string_view StringPool::view(Handle handle) const
+{
+    const char* p = chunks[handle >> CHUNK_OFFSET_BITS].get() + (handle & (CHUNK_SIZE - 1));
+
+    std::size_t length;
+    p = impl_::readLengthPrefix(p, length);
+
+    return std::string_view{p, length};
+}
+
+
+unsigned int StringPool::size() const noexcept
+{
+    return count;
+}
+
+
+std::size_t StringPool::bytesUsed() const noexcept
+{
+    return used;
+}
+
+
+std::size_t StringPool::bytesAllocated() const noexcept
+{
+    std::size_t total = 0;
+    for (std::size_t size : chunkSizes)
+    {
+        total += size;
+    }
+    return total;
+}
+
+
+std::size_t StringPool::indexBytes() const noexcept
+{
+    return index.size() * sizeof(Handle);
+}
+
+
+unsigned int StringPool::hashHandle(const Handle& handle) noexcept
+{
+    // Handles of neighboring strings differ only in their low bits, so
+    // they're mixed (by Knuth's multiplicative hashing) to spread them out.
+    return static_cast<unsigned int>(handle * 2654435761u);
+}
+
+
+std::size_t StringPool::findSlot(std::string_view s, std::size_t hash) const
+{
+    std::size_t mask = index.size() - 1;
+
+    for (std::size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+    {
+        if (index[slot] == NO_HANDLE || view(index[slot]) == s)
+        {
+            return slot;
+        }
+    }
+}
+
+
+void StringPool::growIndex()
+{
+    std::vector<Handle> old{std::move(index)};
+    index.assign(old.empty() ? INITIAL_INDEX_SIZE : old.size() * 2, NO_HANDLE);
+
+    std::size_t mask = index.size() - 1;
+
+    for (Handle handle : old)
+    {
+        if (handle != NO_HANDLE)
+        {
+            std::size_t slot = std::hash<std::string_view>{}(view(handle)) & mask;
+            while (index[slot] != NO_HANDLE)
+            {
+                slot = (slot + 1) & mask;
+            }
+            index[slot] = handle;
+        }
+    }
+}
+
+
+StringPool::Handle StringPool::store(std::string_view s)
+{
+    std::size_t needed = impl_::lengthPrefixSize(s.size()) + s.size();
+
+    if (chunks.empty() || lastChunkUsed + needed > chunkSizes.back())
+    {
+        if (chunks.size() >= MAX_CHUNKS)
+        {
+            throw std::length_error{"StringPool has run out of handles"};
+        }
+
+        std::size_t size = std::max(needed, CHUNK_SIZE);
+        chunks.push_back(std::unique_ptr<char[]>{new char[size]});
+        chunkSizes.push_back(size);
+        lastChunkUsed = 0;
+    }
+
+    Handle handle = static_cast<Handle>(((chunks.size() - 1) << CHUNK_OFFSET_BITS) | lastChunkUsed);
+
+    char* p = chunks.back().get() + lastChunkUsed;
+    p = impl_::writeLengthPrefix(p, s.size());
+    std::memcpy(p, s.data(), s.size());
+
+    lastChunkUsed += needed;
+    used += needed;
+
+    return handle;
+}
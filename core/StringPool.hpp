@@ -0,0 +1,120 @@
+// StringPool.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A StringPool stores strings back to back in large chunks of memory and
+// hands out a 32-bit Handle for each one.  Each distinct string is stored
+// only once: interning a string that's already in the pool returns the
+// Handle it was given the first time, so two Handles are equal exactly
+// when the strings they stand for are equal.
+//
+// Each string is stored as its length, encoded in 7-bit groups (one byte
+// for any length under 128), followed by its characters, so a dictionary
+// of short words takes little more than the total length of the words.
+// Chunks are never moved or freed until the pool is destroyed, so the
+// std::string_view returned by view() stays valid as long as the pool
+// does.
+//
+// A Handle is the index of a chunk in its upper CHUNK_INDEX_BITS bits and
+// the offset of the string within that chunk in its lower CHUNK_OFFSET_BITS
+// bits.  A string too long to fit in one chunk is given a chunk of its own.
+//
+// A StringPool is not safe to intern() into from more than one thread at
+// once, though any number of threads can call view() and find().
+
+#ifndef STRINGPOOL_HPP
+#define STRINGPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+
+class StringPool
+{
+public:
+    using Handle = std::uint32_t;
+
+    static constexpr unsigned int CHUNK_OFFSET_BITS = 20;
+    static constexpr unsigned int CHUNK_INDEX_BITS = 32 - CHUNK_OFFSET_BITS;
+    static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_OFFSET_BITS;
+
+    // The all-ones Handle is never given out, so it can mark an empty slot.
+    static constexpr unsigned int MAX_CHUNKS = (1u << CHUNK_INDEX_BITS) - 1;
+    static constexpr Handle NO_HANDLE = ~Handle{0};
+
+public:
+    // Initializes a StringPool to be empty.  No memory is allocated until
+    // the first string is interned.
+    StringPool();
+
+    // A StringPool can be moved, but not copied, since the Handles and
+    // views it has given out refer to its chunks.  A moved-from pool is
+    // empty; the views given out before the move remain valid, since the
+    // chunks themselves move to the new pool.
+    StringPool(const StringPool& p) = delete;
+    StringPool(StringPool&& p) noexcept;
+    StringPool& operator=(const StringPool& p) = delete;
+    StringPool& operator=(StringPool&& p) noexcept;
+
+
+    // intern() returns the Handle of the given string, storing a copy of
+    // it in the pool first if it isn't there already.  It throws a
+    // std::length_error if the pool has run out of Handles.
+    Handle intern(std::string_view s);
+
+
+    // find() sets "handle" to the Handle of the given string and returns
+    // true if the string is in the pool, and returns false otherwise,
+    // without changing the pool.
+    bool find(std::string_view s, Handle& handle) const;
+
+
+    // view() returns the string that the given Handle stands for.  The
+    // Handle must have come from this pool.
+    std::string_view view(Handle handle) const;
+
+
+    // size() returns the number of distinct strings in the pool.
+    unsigned int size() const noexcept;
+
+
+    // bytesUsed() returns the number of bytes the strings and their
+    // lengths take up; bytesAllocated() returns the size of all of the
+    // chunks, including the unused space at the end of each one; and
+    // indexBytes() returns the size of the table used to find strings
+    // that are already in the pool.
+    std::size_t bytesUsed() const noexcept;
+    std::size_t bytesAllocated() const noexcept;
+    std::size_t indexBytes() const noexcept;
+
+
+    // hashHandle() is a hash function for Handles, suitable for a
+    // HashSet<StringPool::Handle>.  Since equal strings always have the
+    // same Handle, a set of Handles needs only to hash the Handle itself.
+    static unsigned int hashHandle(const Handle& handle) noexcept;
+
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::vector<std::size_t> chunkSizes;
+    std::size_t lastChunkUsed;
+    std::size_t used;
+
+    // The index is an open-addressed table of Handles, with NO_HANDLE in
+    // the empty slots, whose size is always a power of two.
+    std::vector<Handle> index;
+    unsigned int count;
+
+    std::size_t findSlot(std::string_view s, std::size_t hash) const;
+    void growIndex();
+    Handle store(std::string_view s);
+};
+
+
+
+#endif // STRINGPOOL_HPP
@@ -0,0 +1,305 @@
+// Utf8.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <array>
+#include <utility>
+#include "Utf8.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+    // The characters whose upper case is in the table are those below
+    // TABLE_SIZE, all of which are one or two bytes long.
+    constexpr char32_t TABLE_SIZE = 0x0500;
+
+
+    constexpr std::array<unsigned char, 128> ASCII_UPPER = [] {
+        std::array<unsigned char, 128> upper{};
+        for (unsigned int c = 0; c < 128; ++c)
+        {
+            upper[c] = static_cast<unsigned char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        }
+        return upper;
+    }();
+
+
+    // UpperCaseTable holds the upper case of every character below
+    // TABLE_SIZE; most are themselves.
+    struct UpperCaseTable
+    {
+        char16_t upper[TABLE_SIZE];
+
+        UpperCaseTable()
+        {
+            for (char32_t c = 0; c < TABLE_SIZE; ++c)
+            {
+                upper[c] = static_cast<char16_t>(c);
+            }
+
+            shift('a', 'z', -0x20);
+
+            // Latin-1: the lower-case letters are 0x20 past the upper-case
+            // ones, except for the division sign in the middle of them.
+            shift(0x00E0, 0x00FE, -0x20);
+            upper[0x00F7] = 0x00F7;
+            upper[0x00FF] = 0x0178;
+            upper[0x00B5] = 0x039C;
+
+            // Latin Extended-A, and the parts of Latin Extended-B used by
+            // Romanian and by Pinyin, mostly in pairs of upper case then
+            // lower case.
+            pairs(0x0100, 0x012F);
+            upper[0x0131] = 'I';
+            pairs(0x0132, 0x0137);
+            pairs(0x0139, 0x0148);
+            pairs(0x014A, 0x0177);
+            pairs(0x0179, 0x017E);
+            upper[0x017F] = 'S';
+            pairs(0x01CD, 0x01DC);
+            pairs(0x0218, 0x021B);
+
+            // Greek, whose accented vowels are scattered, and whose final
+            // sigma has the same upper case as any other.
+            upper[0x03AC] = 0x0386;
+            shift(0x03AD, 0x03AF, -0x25);
+            shift(0x03B1, 0x03CB, -0x20);
+            upper[0x03C2] = 0x03A3;
+            upper[0x03CC] = 0x038C;
+            shift(0x03CD, 0x03CE, -0x3F);
+
+            // Cyrillic.
+            shift(0x0430, 0x044F, -0x20);
+            shift(0x0450, 0x045F, -0x50);
+            pairs(0x0460, 0x0481);
+            pairs(0x048A, 0x04BF);
+            pairs(0x04C1, 0x04CE);
+            upper[0x04CF] = 0x04C0;
+            pairs(0x04D0, 0x04FF);
+        }
+
+        // shift() makes the upper case of each character from "first"
+        // through "last" the one "by" away from it.
+        void shift(char32_t first, char32_t last, int by)
+        {
+            for (char32_t c = first; c <= last; ++c)
+            {
+                upper[c] = static_cast<char16_t>(static_cast<int>(c) + by);
+            }
+        }
+
+        // pairs() makes the upper case of every second character from
+        // "first" through "last" the one just before it.
+        void pairs(char32_t first, char32_t last)
+        {
+            for (char32_t c = first + 1; c <= last; c += 2)
+            {
+                upper[c] = static_cast<char16_t>(c - 1);
+            }
+        }
+    };
+
+
+    const UpperCaseTable& upperCaseTable()
+    {
+        static const UpperCaseTable table;
+        return table;
+    }
+
+
+    // foldAscii() converts the bytes at p to upper case until it reaches
+    // one that isn't ASCII, returning how many it converted.
+    std::size_t foldAscii(char* p, std::size_t size) noexcept
+    {
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        // As in DocumentTokenizer, the range 'a' through 'z' is shifted to
+        // begin at -128, so that one signed comparison tests both ends.
+        const __m128i shift = _mm_set1_epi8(static_cast<char>(0x80 - 'a'));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+            {
+                break;
+            }
+
+            __m128i lower = _mm_cmplt_epi8(_mm_add_epi8(bytes, shift), limit);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), _mm_sub_epi8(bytes, _mm_and_si128(lower, caseBit)));
+        }
+#endif
+
+        for (; i < size; ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(p[i]);
+            if (c >= 0x80)
+            {
+                break;
+            }
+            p[i] = static_cast<char>(ASCII_UPPER[c]);
+        }
+
+        return i;
+    }
+
+
+    bool isContinuation(unsigned char c) noexcept
+    {
+        return (c & 0xC0) == 0x80;
+    }
+}
+
+
+std::size_t Utf8::longSequenceLength(std::string_view text, std::size_t i) noexcept
+{
+    unsigned char lead = static_cast<unsigned char>(text[i]);
+
+    // The second byte's range is narrower after some leads, which rules out
+    // overlong forms, surrogates and characters past U+10FFFF.
+    std::size_t length;
+    unsigned char secondMin = 0x80;
+    unsigned char secondMax = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        length = 3;
+        secondMin = lead == 0xE0 ? 0xA0 : 0x80;
+        secondMax = lead == 0xED ? 0x9F : 0xBF;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        length = 4;
+        secondMin = lead == 0xF0 ? 0x90 : 0x80;
+        secondMax = lead == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (text.size() - i < length)
+    {
+        return 1;
+    }
+
+    unsigned char second = static_cast<unsigned char>(text[i + 1]);
+    if (second < secondMin || second > secondMax)
+    {
+        return 1;
+    }
+
+    for (std::size_t j = 2; j < length; ++j)
+    {
+        if (!isContinuation(static_cast<unsigned char>(text[i + j])))
+        {
+            return 1;
+        }
+    }
+
+    return length;
+}
+
+
+std::size_t Utf8::length(std::string_view text) noexcept
+{
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < text.size(); i += sequenceLength(text, i))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+
+void Utf8::foldToUpper(std::string& text)
+{
+    std::size_t i = foldAscii(text.data(), text.size());
+    if (i == text.size())
+    {
+        return;
+    }
+
+    // A few characters' upper case is shorter than they are (e.g., dotless
+    // 'ı' becomes 'I'), so the rest is folded into a new string.
+    const UpperCaseTable& table = upperCaseTable();
+
+    std::string folded;
+    folded.reserve(text.size());
+    folded.append(text, 0, i);
+
+    while (i < text.size())
+    {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        std::size_t length = sequenceLength(text, i);
+
+        if (lead < 0x80)
+        {
+            folded += static_cast<char>(ASCII_UPPER[lead]);
+        }
+        else if (length == 2 && lead < 0xC0 + (TABLE_SIZE >> 6))
+        {
+            char32_t c = table.upper[((lead & 0x1F) << 6) | (static_cast<unsigned char>(text[i + 1]) & 0x3F)];
+
+            if (c < 0x80)
+            {
+                folded += static_cast<char>(c);
+            }
+            else
+            {
+                folded += static_cast<char>(0xC0 | (c >> 6));
+                folded += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        else
+        {
+            folded.append(text, i, length);
+        }
+
+        i += length;
+    }
+
+    text = std::move(folded);
+}
+
+
+std::string Utf8::toUpper(std::string_view text)
+{
+    std::string upper{text};
+    foldToUpper(upper);
+    return upper;
+}
+
+
+bool Utf8::isUpper(std::string_view text)
+{
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+
+        if (c >= 0x80)
+        {
+            return toUpper(text.substr(i)) == text.substr(i);
+        }
+        else if (ASCII_UPPER[c] != c)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+// Utf8.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Words are stored as UTF-8, in which a character takes from one to four
+// bytes: one for ASCII, two for the accented Latin letters and the Greek
+// and Cyrillic alphabets.  Utf8 finds where each character begins, so that
+// an edit swaps, deletes or replaces a whole character rather than one
+// byte of it, and folds words to upper case, as the dictionary's are.
+//
+// Case folding is table-driven.  Each character from U+0000 through U+04FF
+// (ASCII, the Latin letters of the European languages, Greek and Cyrillic)
+// has its upper-case form looked up in a table built once, the first time
+// it's needed; characters past the table are left as they are, as are
+// those (like 'ß') whose upper case is more than one character.  Since
+// most words are ASCII, though, folding begins by converting 16 bytes at a
+// time (using SSE2 where it's available) for as long as they're all ASCII,
+// and only falls back to decoding characters once they aren't.
+//
+// A byte that doesn't begin a well-formed UTF-8 sequence is treated as a
+// character by itself and left as it is, so malformed text is never made
+// worse by folding it.
+
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+class Utf8
+{
+public:
+    // sequenceLength() returns the number of bytes in the character that
+    // begins at byte i of the given text, which must be in range.
+    static std::size_t sequenceLength(std::string_view text, std::size_t i) noexcept;
+
+    // length() returns the number of characters in the given text.
+    static std::size_t length(std::string_view text) noexcept;
+
+
+    // foldToUpper() converts the given text to upper case in place.
+    static void foldToUpper(std::string& text);
+
+    // toUpper() returns the given text in upper case.
+    static std::string toUpper(std::string_view text);
+
+    // isUpper() returns true if the given text is already in upper case,
+    // i.e., if toUpper() would leave it unchanged.
+    static bool isUpper(std::string_view text);
+
+
+private:
+    static std::size_t longSequenceLength(std::string_view text, std::size_t i) noexcept;
+};
+
+
+
+inline std::size_t Utf8::sequenceLength(std::string_view text, std::size_t i) noexcept
+{
+    return static_cast<unsigned char>(text[i]) < 0x80 ? 1 : longSequenceLength(text, i);
+}
+
+
+
+#endif // UTF8_HPP
@@ -5,114 +5,142 @@
 //
 // Replace and/or augment the implementations below as needed to meet
 // the requirements.
+//
+// Each of these forwards to the BasicWordChecker<Set<std::string>> that
+// implements the algorithms for any kind of Set.
 
 #include "WordChecker.hpp"
-#include <iostream>
-#include <algorithm>
+
+
+namespace
+{
+    const WordFrequencies noFrequencies;
+}
+
 
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : checker{words}, frequencies{noFrequencies}
+{
+}
+
+
+WordChecker::WordChecker(const Set<std::string>& words, const WordFrequencies& frequencies)
+    : checker{words}, frequencies{frequencies}
+{
+}
+
+
+WordChecker::WordChecker(const Set<std::string>& words, const Alphabet& alphabet)
+    : checker{words, alphabet}, frequencies{noFrequencies}
+{
+}
+
+
+WordChecker::WordChecker(
+    const Set<std::string>& words, const WordFrequencies& frequencies, const Alphabet& alphabet)
+    : checker{words, alphabet}, frequencies{frequencies}
 {
 }
 
 
 bool WordChecker::wordExists(const std::string& word) const
 {
-    std::string temp = word;
-    std::transform(temp.begin(), temp.end(), temp.begin(), ::toupper);
-    //std::transform(words.begin(), words.end(), words.begin(), ::toupper);
-    //std::cout<< word << std::endl;
-    return words.contains(temp);
+    return checker.wordExists(word);
 }
 
 
 std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
-   std::vector<std::string> sug;
-   swapIt(word, sug);
-   insertIt(word, sug);
-   deleteIt(word, sug);
-   replaceIt(word, sug);
-   splitIt(word, sug);
-   return sug;
+   return checker.findSuggestions(word);
+}
+
+
+std::vector<std::string> WordChecker::findTopSuggestions(const std::string& word, std::size_t k) const
+{
+    return checker.findTopSuggestions(word, k, frequencies);
+}
+
+
+bool WordChecker::hasFrequencies() const noexcept
+{
+    return &frequencies != &noFrequencies;
+}
+
+
+std::vector<std::string> WordChecker::findLikelySuggestions(
+    const std::string& word, std::size_t k, const PhoneticIndex* phonetic, EditTier widest) const
+{
+    return checker.findLikelySuggestions(word, k, phonetic, widest);
+}
+
+
+SuggestionResult WordChecker::findDistance2Suggestions(
+    const std::string& word, const PrefixFilter& prefixes, std::size_t candidateBudget) const
+{
+    return checker.findDistance2Suggestions(word, prefixes, candidateBudget);
 }
 
 
 void WordChecker::swapIt(const std::string& word, std::vector<std::string>& sugs) const
 {
-  int len = word.length()-1;
-  for(int i = 0; i < len; ++i)
-     {
-       std::string temp = word;
-       std::swap(temp[i], temp[i+1]);
-       if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
-         {
-           sugs.push_back(temp);
-         }
-     }
+  checker.swapIt(word, sugs);
 }
 
 void WordChecker::insertIt(const std::string& word, std::vector<std::string>& sugs) const
 {
-  int len = word.length();
-  for(int i = 0; i <= len; ++i)
-    {
-      for(char letter = 'A'; letter <= 'Z'; ++letter)
-      {
-        std::string temp = word; 
-        temp.insert(i, 1, letter);
-        if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
-          {
-            sugs.push_back(temp);
-          }
-      }
-    }
+  checker.insertIt(word, sugs);
 }
 
 void WordChecker::deleteIt(const std::string& word, std::vector<std::string>& sugs) const
 {
-  int len = word.length()-1;
-  for(int i = 0; i <= len; ++i)
-    {
-      std::string temp = word;
-      temp.erase(i, 1);
-      if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
-        {
-          sugs.push_back(temp);
-        }
-    }
+  checker.deleteIt(word, sugs);
 }
 
 void WordChecker::replaceIt(const std::string& word, std::vector<std::string>& sugs) const
 {
-  int len = word.length()-1;
-  for(int i = 0; i <= len; ++i)
-    {
-      for(char letter = 'A'; letter <= 'Z'; ++letter)
-        {
-          std::string temp = word;
-          temp[i] = letter;
-          if(wordExists(temp) && std::find(sugs.begin(), sugs.end(), temp) == sugs.end())
-            {
-              sugs.push_back(temp);
-            }
-        }
-    }
+  checker.replaceIt(word, sugs);
 }
 
 void WordChecker::splitIt(const std::string& word, std::vector<std::string>& sugs) const
 {
-  int len = word.length()-1;
-  for(int i = 0; i < len; ++i)
+  checker.splitIt(word, sugs);
+}
+
+
+#ifdef ICS46_HAS_COROUTINES
+
+Task<SuggestionResult> WordChecker::suggestAsync(
+    std::string word, std::chrono::steady_clock::time_point deadline) const
+{
+    using Family = void (WordChecker::*)(const std::string&, std::vector<std::string>&) const;
+
+    static constexpr Family families[] = {
+        &WordChecker::swapIt,
+        &WordChecker::insertIt,
+        &WordChecker::deleteIt,
+        &WordChecker::replaceIt,
+        &WordChecker::splitIt
+    };
+
+    SuggestionResult result;
+
+    for (Family family : families)
     {
-      std::string temp = word;
-      std::string t1 = temp.substr(0, i);
-      std::string t2 = temp.substr(i, len);
-      if(wordExists(t1) && wordExists(t2) && std::find(sugs.begin(), sugs.end(), t1) == sugs.end() &&
-         std::find(sugs.begin(), sugs.end(), t2) == sugs.end())
+        if (family != families[0])
         {
-          sugs.push_back(t1 + " " + t2);
+            co_await yieldNow();
         }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            co_return result;
+        }
+
+        (this->*family)(word, result.words);
     }
+
+    result.complete = true;
+    co_return result;
 }
 
+#endif
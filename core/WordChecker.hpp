@@ -12,14 +12,30 @@
 // given.
 //
 // You are permitted to use the C++ Standard Library in this class.
+//
+// The algorithms themselves live in BasicWordChecker, which can also be
+// used directly with a concrete kind of set to avoid a virtual call on
+// every lookup; a WordChecker works with any Set<std::string>.
+//
+// When built with coroutine support (see CoroutineTask.hpp), a WordChecker
+// can also find suggestions as a Task, a family of edits at a time, so that
+// many requests can share a thread and each can be cut short by a deadline.
 
 #ifndef WORDCHECKER_HPP
 #define WORDCHECKER_HPP
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <fstream>
+#include "Alphabet.hpp"
+#include "BasicWordChecker.hpp"
+#include "CoroutineTask.hpp"
+#include "LikelyEdits.hpp"
+#include "PrefixFilter.hpp"
 #include "Set.hpp"
+#include "WordFrequencies.hpp"
 
 
 class WordChecker
@@ -30,6 +46,17 @@ public:
     // whenever it needs to look up a word.
     WordChecker(const Set<std::string>& words);
 
+    // This constructor also takes a table of how often words are used,
+    // which findTopSuggestions() ranks its suggestions by; it, too, is
+    // stored by reference.  Without one, every word's frequency is zero.
+    WordChecker(const Set<std::string>& words, const WordFrequencies& frequencies);
+
+    // These constructors also take the Alphabet whose letters are
+    // inserted and replaced when making suggestions, which is also stored
+    // by reference.  Without one, the letters are 'A' through 'Z'.
+    WordChecker(const Set<std::string>& words, const Alphabet& alphabet);
+    WordChecker(const Set<std::string>& words, const WordFrequencies& frequencies, const Alphabet& alphabet);
+
 
     // wordExists() returns true if the given word is spelled correctly,
     // false otherwise.
@@ -41,26 +68,68 @@ public:
     // the project write-up.
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
+
+    // findTopSuggestions() returns the k best suggestions found by the
+    // same five algorithms, best first, ranked by the cost of the edit
+    // that found them and then by their frequency (see
+    // BasicWordChecker.hpp).
+    std::vector<std::string> findTopSuggestions(const std::string& word, std::size_t k) const;
+
+
+    // hasFrequencies() returns true if the WordChecker was given a table
+    // of word frequencies, so that findTopSuggestions() has more than edit
+    // costs to rank by.
+    bool hasFrequencies() const noexcept;
+
+
+    // findLikelySuggestions() returns at most k suggestions, found by
+    // trying the likeliest edits (by keyboard adjacency, then by sound)
+    // first and stopping once it has k; see BasicWordChecker.hpp.
+    std::vector<std::string> findLikelySuggestions(
+        const std::string& word, std::size_t k, const PhoneticIndex* phonetic = nullptr,
+        EditTier widest = EditTier::Other) const;
+
+
+    // findDistance2Suggestions() returns the words within two edits of
+    // the given word, trying no more than the given number of candidates;
+    // see BasicWordChecker.hpp.
+    SuggestionResult findDistance2Suggestions(
+        const std::string& word, const PrefixFilter& prefixes,
+        std::size_t candidateBudget = BasicWordChecker<Set<std::string>>::DEFAULT_CANDIDATE_BUDGET) const;
+
     //Swapping each adjacent pair of characters in the word
     void swapIt(const std::string& word, std::vector<std::string>& sugs) const;
 
     // In between each pair of adjacent pair of characters in the word ( also
     // before the first and after the last character), each letter from 'A'
-    // through 'Z' is inserted
+    // through 'Z' (or of the Alphabet) is inserted
     void insertIt(const std::string& word, std::vector<std::string>& sugs) const;
 
     // Deleting each character from the word
     void deleteIt(const std::string& word, std::vector<std::string>& sugs) const;
 
     // Replacing each character in the word with each letter from 'A' through
+    // 'Z' (or of the Alphabet)
     void replaceIt(const std::string& word, std::vector<std::string>& sugs) const;
 
     // Splitting the word into a pair of words by adding a space in between
     // adjacent pair of characters in the word
     void splitIt(const std::string& word, std::vector<std::string>& sugs) const;
-  
+
+#ifdef ICS46_HAS_COROUTINES
+    // suggestAsync() returns a Task that finds the same suggestions as
+    // findSuggestions(), yielding after each of the five families of edits.
+    // Once the deadline has passed, it stops before the next family and
+    // gives the suggestions found so far, marked incomplete.  The word is
+    // copied into the Task, but the WordChecker must outlive it.
+    Task<SuggestionResult> suggestAsync(
+        std::string word,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) const;
+#endif
+
 private:
-    const Set<std::string>& words;
+    BasicWordChecker<Set<std::string>> checker;
+    const WordFrequencies& frequencies;
 };
 
 
@@ -0,0 +1,129 @@
+// WordFrequencies.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "Utf8.hpp"
+#include "WordFrequencies.hpp"
+
+
+WordFrequencies::FrequencyException::FrequencyException(const std::string& reason)
+    : reason_{reason}
+{
+}
+
+
+const std::string& WordFrequencies::FrequencyException::reason() const noexcept
+{
+    return reason_;
+}
+
+
+WordFrequencies::WordFrequencies()
+    : maxOverall{0}
+{
+}
+
+
+WordFrequencies::WordFrequencies(const std::string& path)
+    : WordFrequencies{}
+{
+    std::ifstream in{path};
+    if (!in)
+    {
+        throw FrequencyException{"Cannot open frequency file " + path};
+    }
+
+    read(in);
+}
+
+
+void WordFrequencies::read(std::istream& in)
+{
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+
+        std::istringstream fields{line};
+        std::string word;
+        if (!(fields >> word) || word[0] == '#')
+        {
+            continue;
+        }
+
+        std::string count;
+        std::string extra;
+        if (!(fields >> count) || (fields >> extra)
+            || !std::all_of(count.begin(), count.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+            throw FrequencyException{
+                "Expected a word and a count on line " + std::to_string(lineNumber) + ": " + line};
+        }
+
+        try
+        {
+            add(word, std::stoull(count));
+        }
+        catch (std::out_of_range&)
+        {
+            throw FrequencyException{"Count too large on line " + std::to_string(lineNumber) + ": " + line};
+        }
+    }
+
+    if (in.bad())
+    {
+        throw FrequencyException{"Cannot read frequency file"};
+    }
+}
+
+
+void WordFrequencies::add(const std::string& word, std::uint64_t count)
+{
+    std::uint64_t& frequency = frequencies[Utf8::toUpper(word)];
+
+    frequency = count > std::numeric_limits<std::uint64_t>::max() - frequency
+        ? std::numeric_limits<std::uint64_t>::max()
+        : frequency + count;
+
+    std::size_t length = Utf8::length(word);
+    if (maxByLength.size() <= length)
+    {
+        maxByLength.resize(length + 1, 0);
+    }
+
+    maxByLength[length] = std::max(maxByLength[length], frequency);
+    maxOverall = std::max(maxOverall, frequency);
+}
+
+
+std::uint64_t WordFrequencies::frequency(const std::string& word) const
+{
+    auto found = Utf8::isUpper(word) ? frequencies.find(word) : frequencies.find(Utf8::toUpper(word));
+    return found != frequencies.end() ? found->second : 0;
+}
+
+
+std::uint64_t WordFrequencies::maxFrequency(std::size_t length) const noexcept
+{
+    return length < maxByLength.size() ? maxByLength[length] : 0;
+}
+
+
+std::uint64_t WordFrequencies::maxFrequency() const noexcept
+{
+    return maxOverall;
+}
+
+
+std::size_t WordFrequencies::size() const noexcept
+{
+    return frequencies.size();
+}
@@ -0,0 +1,94 @@
+// WordFrequencies.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A WordFrequencies table records how often each word is used, so that
+// suggestions can be ranked with the likeliest first (see
+// WordChecker::findTopSuggestions()).  Words are stored in upper case, as
+// the dictionary's are, and looked up without regard to case; a word that
+// isn't in the table has a frequency of zero.
+//
+// A frequency file has one word per line, followed by its count:
+//
+//     THE 23135851162
+//     OF 13151942776
+//
+// Blank lines, and lines whose first non-blank character is '#', are
+// ignored.  A word that appears more than once has its counts added.
+//
+// Along with each word's frequency, the table keeps the largest frequency
+// of any word of each length (in characters, not bytes), which bounds how
+// well any word of that length could rank without looking at it.
+
+#ifndef WORDFREQUENCIES_HPP
+#define WORDFREQUENCIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+
+class WordFrequencies
+{
+public:
+    // A FrequencyException is thrown when a frequency file can't be read,
+    // or has a line that isn't a word followed by a count.
+    class FrequencyException
+    {
+    public:
+        explicit FrequencyException(const std::string& reason);
+
+        const std::string& reason() const noexcept;
+
+    private:
+        std::string reason_;
+    };
+
+public:
+    // Initializes an empty table, in which every word has frequency zero.
+    WordFrequencies();
+
+    // Reads the frequency file with the given path, throwing a
+    // FrequencyException if that fails.
+    explicit WordFrequencies(const std::string& path);
+
+
+    // read() adds every word and count from the given stream, in the
+    // format of a frequency file, throwing a FrequencyException (naming
+    // the offending line) if any line is malformed.
+    void read(std::istream& in);
+
+
+    // add() adds the given count to the given word's frequency.
+    void add(const std::string& word, std::uint64_t count);
+
+
+    // frequency() returns the given word's frequency, or zero if it isn't
+    // in the table.
+    std::uint64_t frequency(const std::string& word) const;
+
+
+    // maxFrequency() returns the largest frequency of any word with the
+    // given length, or of any word at all.
+    std::uint64_t maxFrequency(std::size_t length) const noexcept;
+    std::uint64_t maxFrequency() const noexcept;
+
+
+    // size() returns the number of distinct words in the table.
+    std::size_t size() const noexcept;
+
+
+private:
+    std::unordered_map<std::string, std::uint64_t> frequencies;
+    std::vector<std::uint64_t> maxByLength;
+    std::uint64_t maxOverall;
+};
+
+
+
+#endif // WORDFREQUENCIES_HPP
@@ -0,0 +1,124 @@
+// dictmain.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// This converts a word list, with words separated by whitespace (usually
+// one per line), into a dictionary file that a MappedDictionary can open
+// without parsing anything.  Run it with the paths of the word list and
+// the dictionary file to write, e.g.,
+//
+//     ./dict words.txt words.dict
+//
+// Then, to check the dictionary file against the word list it came from,
+// add --verify:
+//
+//     ./dict --verify words.txt words.dict
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "MappedDictionary.hpp"
+
+
+namespace
+{
+    std::vector<std::string> readWords(const std::string& path)
+    {
+        std::ifstream in{path};
+        if (!in)
+        {
+            throw MappedDictionary::DictionaryException{"Cannot open " + path};
+        }
+
+        std::vector<std::string> words;
+        std::string word;
+        while (in >> word)
+        {
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+
+    void build(const std::string& wordListPath, const std::string& dictionaryPath)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string> words = readWords(wordListPath);
+        writeMappedDictionary(dictionaryPath, words);
+
+        std::cout << "Wrote " << dictionaryPath << " from " << words.size()
+                  << " words in " << secondsSince(start) << "s" << std::endl;
+    }
+
+
+    bool verify(const std::string& wordListPath, const std::string& dictionaryPath)
+    {
+        std::vector<std::string> words = readWords(wordListPath);
+
+        auto start = std::chrono::steady_clock::now();
+        MappedDictionary dictionary{dictionaryPath};
+        double openSeconds = secondsSince(start);
+
+        unsigned int missing = 0;
+        for (const std::string& word : words)
+        {
+            if (!dictionary.contains(word))
+            {
+                if (missing++ < 10)
+                {
+                    std::cout << "Missing: " << word << std::endl;
+                }
+            }
+        }
+
+        std::cout << dictionaryPath << ": " << dictionary.size() << " words, opened in "
+                  << openSeconds << "s, " << missing << " missing" << std::endl;
+
+        return missing == 0;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args{argv + 1, argv + argc};
+    bool verifying = !args.empty() && args[0] == "--verify";
+    if (verifying)
+    {
+        args.erase(args.begin());
+    }
+
+    if (args.size() != 2)
+    {
+        std::cout << "usage: " << argv[0] << " [--verify] WORDLIST DICTIONARY" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        if (verifying)
+        {
+            return verify(args[0], args[1]) ? 0 : 1;
+        }
+
+        build(args[0], args[1]);
+    }
+    catch (MappedDictionary::DictionaryException& e)
+    {
+        std::cout << "ERROR: " << e.reason() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -6,12 +6,149 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
+//
+// At the moment, this measures the throughput of ConcurrentSkipListSet as
+// the number of threads grows, first with every thread adding and then
+// with one thread adding while the rest look words up, which is how the
+// spell checker uses it.  Run it with an optional element count, e.g.,
+//
+//     ./exp 1000000
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentSkipListSet.hpp"
 
-int main()
+
+namespace
 {
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::mt19937 engine{46};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        std::uniform_int_distribution<int> length{3, 12};
 
+        std::vector<std::string> words;
+        words.reserve(count);
 
-    return 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string word(length(engine), ' ');
+            for (char& c : word)
+            {
+                c = static_cast<char>(letter(engine));
+            }
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    template <typename Work>
+    double timeThreads(unsigned int threadCount, Work work)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(work, t);
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+
+    void measureAdds(const std::vector<std::string>& words, unsigned int threadCount)
+    {
+        ConcurrentSkipListSet<std::string> s;
+        unsigned int total = words.size();
+
+        double seconds = timeThreads(threadCount, [&](unsigned int t) {
+            for (unsigned int i = t; i < total; i += threadCount)
+            {
+                s.add(words[i]);
+            }
+        });
+
+        std::cout << std::setw(8) << threadCount << " threads adding:         "
+                  << std::setw(12) << static_cast<long>(total / seconds) << " adds/s" << std::endl;
+    }
+
+
+    void measureMixed(const std::vector<std::string>& words, unsigned int threadCount)
+    {
+        ConcurrentSkipListSet<std::string> s;
+        unsigned int total = words.size();
+
+        for (unsigned int i = 0; i < total / 2; ++i)
+        {
+            s.add(words[i]);
+        }
+
+        std::atomic<bool> writing{true};
+        std::atomic<unsigned long> lookups{0};
+        std::atomic<unsigned long> found{0};
+
+        double seconds = timeThreads(threadCount, [&](unsigned int t) {
+            if (t == 0)
+            {
+                for (unsigned int i = total / 2; i < total; ++i)
+                {
+                    s.add(words[i]);
+                }
+                writing = false;
+                return;
+            }
+
+            unsigned long done = 0;
+            unsigned long hits = 0;
+            for (unsigned int i = t; writing; i = (i + 7919) % total)
+            {
+                hits += s.contains(words[i]);
+                ++done;
+            }
+            lookups += done;
+            found += hits;
+        });
+
+        std::cout << std::setw(8) << threadCount << " threads, one adding:    "
+                  << std::setw(12) << static_cast<long>(lookups / seconds) << " lookups/s ("
+                  << found * 100 / std::max(1ul, lookups.load()) << "% found)" << std::endl;
+    }
 }
 
+
+int main(int argc, char** argv)
+{
+    unsigned int count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    std::vector<std::string> words = makeWords(count);
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "ConcurrentSkipListSet, " << count << " words" << std::endl;
+
+    for (unsigned int threadCount = 1; threadCount <= 2 * cores; threadCount *= 2)
+    {
+        measureAdds(words, threadCount);
+    }
+
+    for (unsigned int threadCount = 2; threadCount <= 2 * cores; threadCount *= 2)
+    {
+        measureMixed(words, threadCount);
+    }
+
+    return 0;
+}
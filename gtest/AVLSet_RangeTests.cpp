@@ -0,0 +1,124 @@
+// AVLSet_RangeTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the ordered queries on AVLSet: lowerBound(), range(),
+// prefixRange() and forEachWithPrefix(), which back autocompletion.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+namespace
+{
+    AVLSet<std::string> makeWords(bool shouldBalance = true)
+    {
+        AVLSet<std::string> s{shouldBalance};
+        for (const char* word : {"CAT", "CAR", "CART", "CARD", "DOG", "COT", "BAT", "CA", "CARE"})
+        {
+            s.add(word);
+        }
+        return s;
+    }
+
+
+    template <typename Range>
+    std::vector<std::string> collect(const Range& r)
+    {
+        return std::vector<std::string>(r.begin(), r.end());
+    }
+}
+
+
+TEST(AVLSet_RangeTests, iteratesInAscendingOrder)
+{
+    AVLSet<int> s;
+    for (int i : {50, 20, 80, 10, 30, 70, 90, 60})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> elements;
+    for (int i : s)
+    {
+        elements.push_back(i);
+    }
+
+    std::vector<int> expected{10, 20, 30, 50, 60, 70, 80, 90};
+    EXPECT_EQ(expected, elements);
+}
+
+
+TEST(AVLSet_RangeTests, addingDuplicatesHasNoEffect)
+{
+    AVLSet<int> s;
+    s.add(5);
+    s.add(5);
+    s.add(3);
+    s.add(3);
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_EQ(2, std::distance(s.begin(), s.end()));
+}
+
+
+TEST(AVLSet_RangeTests, lowerBoundFindsSmallestNotLess)
+{
+    AVLSet<int> s;
+    for (int i = 0; i < 100; i += 10)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(30, *s.lowerBound(30));
+    EXPECT_EQ(40, *s.lowerBound(31));
+    EXPECT_EQ(0, *s.lowerBound(-5));
+    EXPECT_TRUE(s.lowerBound(91) == s.end());
+}
+
+
+TEST(AVLSet_RangeTests, rangeIsHalfOpen)
+{
+    AVLSet<int> s{false};
+    for (int i = 1; i <= 10; ++i)
+    {
+        s.add(i);
+    }
+
+    std::vector<int> elements;
+    for (int i : s.range(3, 7))
+    {
+        elements.push_back(i);
+    }
+
+    std::vector<int> expected{3, 4, 5, 6};
+    EXPECT_EQ(expected, elements);
+    EXPECT_TRUE(s.range(7, 3).empty());
+    EXPECT_TRUE(s.range(11, 20).empty());
+}
+
+
+TEST(AVLSet_RangeTests, prefixRangeYieldsOnlyMatchingWords)
+{
+    AVLSet<std::string> s = makeWords();
+
+    std::vector<std::string> expected{"CAR", "CARD", "CARE", "CART"};
+    EXPECT_EQ(expected, collect(s.prefixRange("CAR")));
+    EXPECT_TRUE(s.prefixRange("CX").empty());
+    EXPECT_EQ(s.size(), collect(s.prefixRange("")).size());
+}
+
+
+TEST(AVLSet_RangeTests, forEachWithPrefixMatchesPrefixRange)
+{
+    AVLSet<std::string> s = makeWords(false);
+
+    std::vector<std::string> visited;
+    s.forEachWithPrefix("CA", [&](const std::string& word) { visited.push_back(word); });
+
+    EXPECT_EQ(collect(s.prefixRange("CA")), visited);
+    EXPECT_EQ(6, visited.size());
+}
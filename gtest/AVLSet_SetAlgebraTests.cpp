@@ -0,0 +1,158 @@
+// AVLSet_SetAlgebraTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for unionWith(), intersectWith() and differenceWith() on
+// AVLSet, comparing their results against std::set_union and friends and
+// checking that balanced results stay balanced.
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+namespace
+{
+    std::vector<int> randomSorted(unsigned int count, int range, unsigned int seed)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<int> distribution{0, range};
+        std::vector<int> v;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            v.push_back(distribution(engine));
+        }
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return v;
+    }
+
+
+    AVLSet<int> makeSet(const std::vector<int>& v, bool shouldBalance = true)
+    {
+        AVLSet<int> s{shouldBalance};
+        std::vector<int> shuffled{v};
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{46});
+        for (int i : shuffled)
+        {
+            s.add(i);
+        }
+        return s;
+    }
+
+
+    void expectContents(const AVLSet<int>& s, const std::vector<int>& expected)
+    {
+        ASSERT_EQ(expected.size(), s.size());
+        EXPECT_EQ(expected, std::vector<int>(s.begin(), s.end()));
+    }
+
+
+    void expectBalanced(const AVLSet<int>& s)
+    {
+        // An AVL tree with n nodes is never taller than about 1.44 log2(n + 2).
+        EXPECT_LE(s.height(), 1.4405 * std::log2(s.size() + 2.0));
+    }
+}
+
+
+TEST(AVLSet_SetAlgebraTests, unionMatchesStandardAlgorithm)
+{
+    std::vector<int> a = randomSorted(20000, 100000, 1);
+    std::vector<int> b = randomSorted(3000, 100000, 2);
+    std::vector<int> expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+    AVLSet<int> s = makeSet(a);
+    s.unionWith(makeSet(b));
+
+    expectContents(s, expected);
+    expectBalanced(s);
+}
+
+
+TEST(AVLSet_SetAlgebraTests, intersectionMatchesStandardAlgorithm)
+{
+    std::vector<int> a = randomSorted(20000, 40000, 3);
+    std::vector<int> b = randomSorted(15000, 40000, 4);
+    std::vector<int> expected;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+    AVLSet<int> s = makeSet(a);
+    AVLSet<int> other = makeSet(b);
+    s.intersectWith(other);
+
+    expectContents(s, expected);
+    expectBalanced(s);
+    EXPECT_EQ(b.size(), other.size());
+}
+
+
+TEST(AVLSet_SetAlgebraTests, differenceMatchesStandardAlgorithm)
+{
+    std::vector<int> a = randomSorted(20000, 40000, 5);
+    std::vector<int> b = randomSorted(8000, 40000, 6);
+    std::vector<int> expected;
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+    AVLSet<int> s = makeSet(a);
+    s.differenceWith(makeSet(b));
+
+    expectContents(s, expected);
+    expectBalanced(s);
+}
+
+
+TEST(AVLSet_SetAlgebraTests, handlesEmptyAndIdenticalSets)
+{
+    std::vector<int> a = randomSorted(500, 1000, 7);
+    AVLSet<int> s = makeSet(a);
+    AVLSet<int> empty;
+
+    s.unionWith(empty);
+    expectContents(s, a);
+
+    s.intersectWith(s);
+    expectContents(s, a);
+
+    AVLSet<int> copy{s};
+    s.differenceWith(copy);
+    expectContents(s, {});
+
+    s.unionWith(std::move(copy));
+    expectContents(s, a);
+    EXPECT_EQ(0, copy.size());
+}
+
+
+TEST(AVLSet_SetAlgebraTests, unbalancedSetsFallBackToAdding)
+{
+    std::vector<int> a{1, 2, 3, 4, 5, 6};
+    std::vector<int> b{4, 5, 6, 7, 8};
+
+    AVLSet<int> s{false};
+    for (int i : a)
+    {
+        s.add(i);
+    }
+    AVLSet<int> t = makeSet(b);
+
+    AVLSet<int> u{s};
+    u.unionWith(t);
+    expectContents(u, {1, 2, 3, 4, 5, 6, 7, 8});
+
+    AVLSet<int> i{s};
+    i.intersectWith(t);
+    expectContents(i, {4, 5, 6});
+    EXPECT_EQ(2, i.height());
+
+    AVLSet<int> d{s};
+    d.differenceWith(t);
+    expectContents(d, {1, 2, 3});
+    EXPECT_EQ(2, d.height());
+}
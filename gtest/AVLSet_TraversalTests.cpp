@@ -0,0 +1,110 @@
+// AVLSet_TraversalTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the iterator-based traversals of AVLSet, checking that
+// they agree with the visitor-based ones and survive degenerate trees.
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+namespace
+{
+    template <typename Traversal>
+    std::vector<int> collect(const Traversal& t)
+    {
+        return std::vector<int>(t.begin(), t.end());
+    }
+}
+
+
+TEST(AVLSet_TraversalTests, iteratorsAgreeWithVisitors)
+{
+    AVLSet<int> s;
+    for (int i : {40, 20, 60, 10, 30, 50, 70, 25, 35, 5})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> pre, in, post;
+    AVLSet<int>::VisitFunction addPre = [&](const int& i) { pre.push_back(i); };
+    s.preorder(addPre);
+    s.inorder([&](const int& i) { in.push_back(i); });
+    s.postorder([&](const int& i) { post.push_back(i); });
+
+    EXPECT_EQ(pre, collect(s.preorderTraversal()));
+    EXPECT_EQ(in, collect(s.inorderTraversal()));
+    EXPECT_EQ(post, collect(s.postorderTraversal()));
+    EXPECT_TRUE(std::is_sorted(in.begin(), in.end()));
+    EXPECT_EQ(10, post.size());
+}
+
+
+TEST(AVLSet_TraversalTests, postorderVisitsChildrenBeforeParents)
+{
+    AVLSet<int> s{false};
+    for (int i : {50, 30, 70, 20, 40, 60, 80})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> expected{20, 40, 30, 60, 80, 70, 50};
+    EXPECT_EQ(expected, collect(s.postorderTraversal()));
+}
+
+
+TEST(AVLSet_TraversalTests, emptyTraversalsAreEmpty)
+{
+    AVLSet<int> s;
+
+    EXPECT_TRUE(collect(s.preorderTraversal()).empty());
+    EXPECT_TRUE(collect(s.inorderTraversal()).empty());
+    EXPECT_TRUE(collect(s.postorderTraversal()).empty());
+}
+
+
+TEST(AVLSet_TraversalTests, canTraverseDegenerateTree)
+{
+    const int count = 5000;
+    AVLSet<int> s{false};
+    for (int i = 0; i < count; ++i)
+    {
+        s.add(i);
+    }
+
+    ASSERT_EQ(count - 1, s.height());
+
+    int visited = 0;
+    s.postorder([&](const int& i) { EXPECT_EQ(count - 1 - visited, i); ++visited; });
+    EXPECT_EQ(count, visited);
+
+    AVLSet<int> copy{s};
+    EXPECT_EQ(count, copy.size());
+    EXPECT_EQ(count - 1, copy.height());
+}
+
+
+TEST(AVLSet_TraversalTests, copiesKeepTheShapeOfTheOriginal)
+{
+    AVLSet<int> s{false};
+    for (int i : {50, 20, 80, 10, 30, 70, 90, 25, 35, 33})
+    {
+        s.add(i);
+    }
+
+    AVLSet<int> copy{s};
+    EXPECT_EQ(collect(s.preorderTraversal()), collect(copy.preorderTraversal()));
+    EXPECT_EQ(s.height(), copy.height());
+
+    AVLSet<int> assigned;
+    assigned.add(1);
+    assigned = s;
+    EXPECT_EQ(collect(s.preorderTraversal()), collect(assigned.preorderTraversal()));
+    EXPECT_EQ(s.size(), assigned.size());
+    EXPECT_FALSE(assigned.contains(1));
+}
@@ -0,0 +1,80 @@
+// BasicWordChecker_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests checking that a BasicWordChecker bound to each concrete kind
+// of set gives exactly the same answers as the type-erased WordChecker.
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    const std::vector<std::string> dictionary{
+        "ABDC", "CAT", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "CATS", "SCAT"};
+
+    const std::vector<std::string> queries{"ABCD", "CAT", "cat", "CAAT", "CT", "ACT", "CATA", "ANAT", "Q"};
+
+
+    template <typename SetT>
+    void expectSameAsWordChecker(SetT& set)
+    {
+        for (const std::string& word : dictionary)
+        {
+            set.add(word);
+        }
+
+        BasicWordChecker<SetT> direct{set};
+        WordChecker erased{set};
+
+        for (const std::string& query : queries)
+        {
+            EXPECT_EQ(erased.wordExists(query), direct.wordExists(query)) << query;
+            EXPECT_EQ(erased.findSuggestions(query), direct.findSuggestions(query)) << query;
+        }
+    }
+}
+
+
+TEST(BasicWordChecker_Tests, hashSetMatchesWordChecker)
+{
+    HashSet<std::string> set{std::hash<std::string>{}};
+    expectSameAsWordChecker(set);
+}
+
+
+TEST(BasicWordChecker_Tests, avlSetMatchesWordChecker)
+{
+    AVLSet<std::string> set;
+    expectSameAsWordChecker(set);
+}
+
+
+TEST(BasicWordChecker_Tests, skipListSetMatchesWordChecker)
+{
+    SkipListSet<std::string> set;
+    expectSameAsWordChecker(set);
+}
+
+
+TEST(BasicWordChecker_Tests, findsSuggestionsWithoutVirtualSet)
+{
+    AVLSet<std::string> set;
+    set.add("ABDC");
+    set.add("ZZZZZ");
+
+    BasicWordChecker<AVLSet<std::string>> checker{set};
+    std::vector<std::string> suggestions = checker.findSuggestions("ABCD");
+
+    ASSERT_EQ(1, suggestions.size());
+    EXPECT_EQ("ABDC", suggestions[0]);
+}
@@ -0,0 +1,191 @@
+// BatchChecker_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for checkText() and BatchOutput.
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Alphabet.hpp"
+#include "BatchChecker.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT", "DON'T", "AT"})
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    std::string check(const WordChecker& checker, const std::string& text, BatchStatistics* stats = nullptr)
+    {
+        std::ostringstream out;
+
+        {
+            BatchOutput output{out};
+            BatchStatistics s = checkText(checker, text, output);
+            if (stats != nullptr)
+            {
+                *stats = s;
+            }
+        }
+
+        return out.str();
+    }
+
+
+    std::string check(const std::string& text, BatchStatistics* stats = nullptr)
+    {
+        HashSet<std::string> words = makeWords();
+        WordChecker checker{words};
+        return check(checker, text, stats);
+    }
+}
+
+
+TEST(BatchChecker_Tests, correctlySpelledTextWritesNothing)
+{
+    BatchStatistics stats;
+    EXPECT_EQ("", check("The cat sat on the mat.", &stats));
+    EXPECT_EQ(23, stats.bytes);
+    EXPECT_EQ(6, stats.words);
+    EXPECT_EQ(0, stats.misspellings);
+}
+
+
+TEST(BatchChecker_Tests, misspellingsAreReportedWithOffsetLineAndColumn)
+{
+    BatchStatistics stats;
+    std::string output = check("The cat sat\non the mta.\nCAAT", &stats);
+
+    EXPECT_EQ("19\t2:8\tmta\tMAT\n24\t3:1\tCAAT\tCAT\n", output);
+    EXPECT_EQ(7, stats.words);
+    EXPECT_EQ(2, stats.misspellings);
+}
+
+
+TEST(BatchChecker_Tests, wordsAreWrittenAsTheyAppearInTheText)
+{
+    EXPECT_EQ("0\t1:1\tcAtt\tCAT\n", check("cAtt"));
+}
+
+
+TEST(BatchChecker_Tests, apostrophesInsideWordsArePartOfTheWord)
+{
+    EXPECT_EQ("", check("'Don't' sat"));
+    EXPECT_EQ("0\t1:1\tcan't\t\n", check("can't"));
+}
+
+
+TEST(BatchChecker_Tests, wordsOutsideAsciiAreCheckedInUpperCase)
+{
+    const std::vector<std::string> dictionary{"THE", "CAF\xc3\x89"};
+    HashSet<std::string> words{stringHash};
+    words.addMany(dictionary);
+    Alphabet alphabet{dictionary};
+    WordChecker checker{words, alphabet};
+
+    EXPECT_EQ("", check(checker, "The caf\xc3\xa9, the CAF\xc3\x89"));
+    EXPECT_EQ("0\t1:1\tcafe\tCAF\xc3\x89\n", check(checker, "cafe"));
+    EXPECT_EQ("0\t1:1\tcaf\xc3\xa9s\tCAF\xc3\x89\n", check(checker, "caf\xc3\xa9s"));
+}
+
+
+TEST(BatchChecker_Tests, eachSuggestionIsWrittenOnce)
+{
+    // "SATT" becomes "SAT" by deleting either of its T's.
+    EXPECT_EQ("0\t1:1\tSATT\tSAT\n", check("SATT"));
+}
+
+
+TEST(BatchChecker_Tests, suggestionsAreRankedWhenThereAreFrequencies)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies;
+    frequencies.add("CAT", 1000);
+    frequencies.add("SAT", 100);
+    frequencies.add("MAT", 10);
+    frequencies.add("AT", 1);
+
+    WordChecker unranked{words};
+    WordChecker ranked{words, frequencies};
+
+    EXPECT_EQ("0\t1:1\txat\tAT CAT MAT SAT\n", check(unranked, "xat"));
+    EXPECT_EQ("0\t1:1\txat\tCAT SAT MAT AT\n", check(ranked, "xat"));
+}
+
+
+TEST(BatchChecker_Tests, onlyTheTopSuggestionsAreWrittenWhenRanked)
+{
+    HashSet<std::string> words{stringHash};
+    for (char c = 'A'; c <= 'W'; ++c)
+    {
+        words.add(std::string{c} + "AT");
+    }
+
+    WordFrequencies frequencies;
+    WordChecker unranked{words};
+    WordChecker ranked{words, frequencies};
+
+    auto countSuggestions = [](const std::string& line)
+    {
+        std::string suggestions = line.substr(line.rfind('\t') + 1);
+        return static_cast<std::size_t>(std::count(suggestions.begin(), suggestions.end(), ' ')) + 1;
+    };
+
+    EXPECT_EQ(23u, countSuggestions(check(unranked, "XAT")));
+    EXPECT_EQ(TOP_SUGGESTIONS, countSuggestions(check(ranked, "XAT")));
+}
+
+
+TEST(BatchChecker_Tests, outputLargerThanTheBufferIsWrittenInFull)
+{
+    std::string chunk(BatchOutput::BUFFER_SIZE / 2 + 1, 'x');
+    std::ostringstream out;
+    {
+        BatchOutput output{out};
+        for (int i = 0; i < 3; ++i)
+        {
+            output.append(chunk);
+            output.append('\n');
+        }
+    }
+
+    EXPECT_EQ(3 * (chunk.size() + 1), out.str().size());
+    EXPECT_EQ(chunk + "\n" + chunk + "\n" + chunk + "\n", out.str());
+}
+
+
+TEST(BatchChecker_Tests, numbersAreWrittenInDecimal)
+{
+    std::ostringstream out;
+    {
+        BatchOutput output{out};
+        output.append(std::size_t{0});
+        output.append(' ');
+        output.append(std::size_t{18446744073709551615ull});
+        EXPECT_TRUE(output.flush());
+    }
+
+    EXPECT_EQ("0 18446744073709551615", out.str());
+}
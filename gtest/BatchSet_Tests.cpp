@@ -0,0 +1,158 @@
+// BatchSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for addMany() and containsMany(), which should leave each kind
+// of set with the same contents, and give the same answers, as calling
+// add() and contains() one element at a time.
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    unsigned int intHash(const int& i)
+    {
+        return static_cast<unsigned int>(i) * 2654435761u;
+    }
+
+
+    std::vector<int> makeBatch(unsigned int count, int range, unsigned int seed)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<int> value{0, range - 1};
+
+        std::vector<int> batch;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            batch.push_back(value(engine));
+        }
+        return batch;
+    }
+
+
+    void expectBatchesAgree(BatchSet<int>& s)
+    {
+        std::set<int> expected;
+
+        for (unsigned int round = 0; round < 4; ++round)
+        {
+            std::vector<int> batch = makeBatch(500 * round + 1, 3000, round);
+            s.addMany(batch);
+            expected.insert(batch.begin(), batch.end());
+
+            ASSERT_EQ(expected.size(), s.size());
+
+            std::vector<int> queries = makeBatch(2000, 4000, round + 100);
+            std::vector<bool> found = s.containsMany(queries);
+
+            ASSERT_EQ(queries.size(), found.size());
+            for (unsigned int i = 0; i < queries.size(); ++i)
+            {
+                ASSERT_EQ(expected.count(queries[i]) == 1, found[i]) << queries[i];
+            }
+        }
+    }
+}
+
+
+TEST(BatchSet_Tests, hashSetBatchesAgreeWithSingleOperations)
+{
+    HashSet<int> s{intHash};
+    expectBatchesAgree(s);
+}
+
+
+TEST(BatchSet_Tests, hashSetBatchesWorkWithCollidingHashes)
+{
+    HashSet<int> s{[](const int&) { return 0u; }};
+    expectBatchesAgree(s);
+
+    EXPECT_EQ(s.size(), s.elementsAtIndex(0));
+}
+
+
+TEST(BatchSet_Tests, balancedAVLSetBatchesAgreeWithSingleOperations)
+{
+    AVLSet<int> s;
+    expectBatchesAgree(s);
+}
+
+
+TEST(BatchSet_Tests, balancedAVLSetStaysBalancedAfterAddMany)
+{
+    AVLSet<int> s;
+    std::vector<int> batch;
+    for (int i = 0; i < 1023; ++i)
+    {
+        batch.push_back(i);
+    }
+
+    s.addMany(batch);
+
+    EXPECT_EQ(1023, s.size());
+    EXPECT_EQ(9, s.height());
+}
+
+
+TEST(BatchSet_Tests, unbalancedAVLSetAddManyKeepsInsertionShape)
+{
+    AVLSet<int> s{false};
+    std::vector<int> batch{1, 2, 3, 4, 5};
+
+    s.addMany(batch);
+
+    EXPECT_EQ(5, s.size());
+    EXPECT_EQ(4, s.height());
+}
+
+
+TEST(BatchSet_Tests, unbalancedAVLSetBatchesAgreeWithSingleOperations)
+{
+    AVLSet<int> s{false};
+    expectBatchesAgree(s);
+}
+
+
+TEST(BatchSet_Tests, skipListSetBatchesAgreeWithSingleOperations)
+{
+    SkipListSet<int> s;
+    expectBatchesAgree(s);
+}
+
+
+TEST(BatchSet_Tests, emptyBatchesHaveNoEffect)
+{
+    AVLSet<int> s;
+    std::vector<int> empty;
+
+    s.addMany(empty);
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_TRUE(s.containsMany(empty).empty());
+}
+
+
+TEST(BatchSet_Tests, freeFunctionsWorkThroughSetReferences)
+{
+    HashSet<std::string> s{[](const std::string& str) { return static_cast<unsigned int>(str.size()); }};
+    Set<std::string>& set = s;
+
+    std::vector<std::string> words{"boo", "is", "happy", "today", "is"};
+    addMany(set, words.data(), words.size());
+
+    std::vector<std::string> queries{"today", "sad", "boo"};
+    std::vector<bool> found;
+    containsMany(set, queries.data(), queries.size(), found);
+
+    EXPECT_EQ(4, set.size());
+    EXPECT_EQ((std::vector<bool>{true, false, true}), found);
+}
@@ -0,0 +1,194 @@
+// ConcurrentQueue_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SpscQueue and MpmcQueue, both on one thread and with
+// producers and consumers on many.
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentQueue.hpp"
+
+
+namespace
+{
+    template <typename Queue>
+    void expectFirstInFirstOutUntilFull()
+    {
+        Queue q{5};
+        EXPECT_EQ(8, q.capacity());
+
+        for (int i = 0; i < 8; ++i)
+        {
+            int value = i;
+            ASSERT_TRUE(q.tryPush(value));
+        }
+
+        int extra = 8;
+        EXPECT_FALSE(q.tryPush(extra));
+
+        for (int i = 0; i < 8; ++i)
+        {
+            int value = -1;
+            ASSERT_TRUE(q.tryPop(value));
+            EXPECT_EQ(i, value);
+        }
+
+        int value = -1;
+        EXPECT_FALSE(q.tryPop(value));
+    }
+
+
+    template <typename Queue>
+    void expectCloseToEndConsumption()
+    {
+        Queue q{4};
+        EXPECT_TRUE(q.push(1));
+        EXPECT_TRUE(q.push(2));
+        q.close();
+
+        EXPECT_TRUE(q.isClosed());
+        EXPECT_FALSE(q.push(3));
+
+        int value = 0;
+        EXPECT_TRUE(q.pop(value));
+        EXPECT_EQ(1, value);
+        EXPECT_TRUE(q.pop(value));
+        EXPECT_EQ(2, value);
+        EXPECT_FALSE(q.pop(value));
+    }
+}
+
+
+TEST(ConcurrentQueue_Tests, spscQueuesAreFirstInFirstOutUntilFull)
+{
+    expectFirstInFirstOutUntilFull<SpscQueue<int>>();
+}
+
+
+TEST(ConcurrentQueue_Tests, mpmcQueuesAreFirstInFirstOutUntilFull)
+{
+    expectFirstInFirstOutUntilFull<MpmcQueue<int>>();
+}
+
+
+TEST(ConcurrentQueue_Tests, closingAnSpscQueueEndsConsumptionOnceItsEmpty)
+{
+    expectCloseToEndConsumption<SpscQueue<int>>();
+}
+
+
+TEST(ConcurrentQueue_Tests, closingAnMpmcQueueEndsConsumptionOnceItsEmpty)
+{
+    expectCloseToEndConsumption<MpmcQueue<int>>();
+}
+
+
+TEST(ConcurrentQueue_Tests, failedPushesLeaveTheirValueAlone)
+{
+    MpmcQueue<std::unique_ptr<int>> q{2};
+    q.push(std::make_unique<int>(1));
+    q.push(std::make_unique<int>(2));
+
+    auto value = std::make_unique<int>(3);
+    EXPECT_FALSE(q.tryPush(value));
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(3, *value);
+}
+
+
+TEST(ConcurrentQueue_Tests, spscQueuesDeliverEverythingInOrderAcrossThreads)
+{
+    constexpr int COUNT = 200000;
+    SpscQueue<std::string> q{16};
+
+    std::thread producer{[&] {
+        for (int i = 0; i < COUNT; ++i)
+        {
+            q.push(std::to_string(i));
+        }
+        q.close();
+    }};
+
+    std::string value;
+    int expected = 0;
+    while (q.pop(value))
+    {
+        ASSERT_EQ(std::to_string(expected), value);
+        ++expected;
+    }
+
+    producer.join();
+    EXPECT_EQ(COUNT, expected);
+}
+
+
+TEST(ConcurrentQueue_Tests, mpmcQueuesDeliverEverythingExactlyOnceAcrossThreads)
+{
+    constexpr unsigned int PRODUCERS = 4;
+    constexpr unsigned int CONSUMERS = 4;
+    constexpr unsigned int PER_PRODUCER = 50000;
+
+    MpmcQueue<unsigned int> q{64};
+    std::vector<std::vector<unsigned int>> received(CONSUMERS);
+
+    std::vector<std::thread> producers;
+    for (unsigned int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&q, p] {
+            for (unsigned int i = 0; i < PER_PRODUCER; ++i)
+            {
+                q.push(p * PER_PRODUCER + i);
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (unsigned int c = 0; c < CONSUMERS; ++c)
+    {
+        consumers.emplace_back([&q, &received, c] {
+            unsigned int value;
+            while (q.pop(value))
+            {
+                received[c].push_back(value);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+    q.close();
+    for (std::thread& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    // Each consumer sees each producer's values in the order they were
+    // pushed, and together they see every value once.
+    std::vector<unsigned int> seen(PRODUCERS * PER_PRODUCER, 0);
+    for (const std::vector<unsigned int>& values : received)
+    {
+        std::vector<unsigned int> last(PRODUCERS, 0);
+        std::vector<bool> any(PRODUCERS, false);
+
+        for (unsigned int value : values)
+        {
+            unsigned int producer = value / PER_PRODUCER;
+            ASSERT_TRUE(!any[producer] || last[producer] < value);
+            any[producer] = true;
+            last[producer] = value;
+            ++seen[value];
+        }
+    }
+
+    for (unsigned int count : seen)
+    {
+        ASSERT_EQ(1, count);
+    }
+}
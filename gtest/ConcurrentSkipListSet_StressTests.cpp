@@ -0,0 +1,136 @@
+// ConcurrentSkipListSet_StressTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Multi-threaded stress tests for ConcurrentSkipListSet, with several
+// threads adding overlapping elements while others look them up.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSkipListSet.hpp"
+
+
+namespace
+{
+    const unsigned int threadCount = 8;
+}
+
+
+TEST(ConcurrentSkipListSet_StressTests, behavesLikeASetOnOneThread)
+{
+    ConcurrentSkipListSet<int> s;
+    Set<int>& ss = s;
+    ss.add(11);
+    ss.add(1);
+    ss.add(5);
+    ss.add(5);
+
+    EXPECT_TRUE(ss.isImplemented());
+    EXPECT_EQ(3, ss.size());
+    EXPECT_TRUE(ss.contains(1));
+    EXPECT_TRUE(ss.contains(5));
+    EXPECT_TRUE(ss.contains(11));
+    EXPECT_FALSE(ss.contains(2));
+    EXPECT_EQ(3, s.elementsOnLevel(0));
+}
+
+
+TEST(ConcurrentSkipListSet_StressTests, concurrentAddsOfOverlappingElements)
+{
+    const int perThread = 20000;
+    ConcurrentSkipListSet<int> s;
+
+    // Every element is added by two different threads, in different orders.
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&s, t, perThread] {
+            int first = static_cast<int>(t / 2) * perThread;
+            for (int i = 0; i < perThread; ++i)
+            {
+                s.add(t % 2 == 0 ? first + i : first + perThread - 1 - i);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    const unsigned int expected = threadCount / 2 * perThread;
+    EXPECT_EQ(expected, s.size());
+    EXPECT_EQ(expected, s.elementsOnLevel(0));
+    for (int i = 0; i < static_cast<int>(expected); ++i)
+    {
+        ASSERT_TRUE(s.contains(i)) << i;
+    }
+    EXPECT_FALSE(s.contains(-1));
+    EXPECT_FALSE(s.contains(static_cast<int>(expected)));
+
+    // Every tower has to be reachable on each level it was built for, so
+    // no level can have lost a tower to a stale forward pointer.
+    std::vector<unsigned int> taller(ConcurrentSkipListSet<int>::MAX_LEVELS, 0);
+    for (int i = 0; i < static_cast<int>(expected); ++i)
+    {
+        unsigned int height = s.heightOf(i);
+        ASSERT_GE(height, 1u) << i;
+        for (unsigned int level = 0; level < height; ++level)
+        {
+            ++taller[level];
+        }
+    }
+    for (unsigned int level = 0; level < taller.size(); ++level)
+    {
+        EXPECT_EQ(taller[level], s.elementsOnLevel(level)) << level;
+    }
+}
+
+
+TEST(ConcurrentSkipListSet_StressTests, readersSeeEveryCompletedAdd)
+{
+    const int count = 50000;
+    ConcurrentSkipListSet<std::string> s;
+    std::atomic<int> added{0};
+    std::atomic<bool> failed{false};
+
+    std::thread writer{[&] {
+        for (int i = 0; i < count; ++i)
+        {
+            s.add(std::to_string(i));
+            added.store(i + 1, std::memory_order_release);
+        }
+    }};
+
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0; t < threadCount - 1; ++t)
+    {
+        readers.emplace_back([&, t] {
+            unsigned int probe = t;
+            while (added.load(std::memory_order_acquire) < count)
+            {
+                int done = added.load(std::memory_order_acquire);
+                if (done > 0 && !s.contains(std::to_string(probe++ % done)))
+                {
+                    failed = true;
+                }
+                if (s.contains("-" + std::to_string(probe)))
+                {
+                    failed = true;
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(count, s.size());
+}
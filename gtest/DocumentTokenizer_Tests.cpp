@@ -0,0 +1,247 @@
+// DocumentTokenizer_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DocumentTokenizer and MappedDocument.
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DocumentTokenizer.hpp"
+
+
+namespace
+{
+    struct Word
+    {
+        std::string word;
+        std::size_t offset;
+        std::size_t line;
+        std::size_t column;
+
+        bool operator==(const Word& w) const
+        {
+            return word == w.word && offset == w.offset && line == w.line && column == w.column;
+        }
+    };
+
+
+    std::ostream& operator<<(std::ostream& out, const Word& w)
+    {
+        return out << w.word << "@" << w.offset << "(" << w.line << ":" << w.column << ")";
+    }
+
+
+    std::vector<Word> tokenize(std::string_view text)
+    {
+        std::vector<Word> words;
+        DocumentTokenizer tokenizer{text};
+        DocumentToken token;
+
+        while (tokenizer.next(token))
+        {
+            EXPECT_EQ(text.data() + token.offset, token.word.data());
+            words.push_back(Word{std::string{token.word}, token.offset, token.line, token.column});
+        }
+
+        EXPECT_FALSE(tokenizer.next(token));
+        return words;
+    }
+
+
+    // A straightforward tokenizer, one character at a time, against which
+    // DocumentTokenizer is compared.
+    std::vector<Word> tokenizeSlowly(std::string_view text)
+    {
+        auto isLetter = [](char c)
+        {
+            return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || static_cast<unsigned char>(c) >= 0x80;
+        };
+
+        std::vector<Word> words;
+        std::size_t line = 1;
+        std::size_t lineStart = 0;
+
+        for (std::size_t i = 0; i < text.size(); )
+        {
+            if (!isLetter(text[i]))
+            {
+                if (text[i] == '\n')
+                {
+                    ++line;
+                    lineStart = i + 1;
+                }
+                ++i;
+                continue;
+            }
+
+            std::size_t begin = i;
+            while (i < text.size()
+                   && (isLetter(text[i])
+                       || (text[i] == '\'' && i + 1 < text.size() && isLetter(text[i + 1]))))
+            {
+                ++i;
+            }
+
+            words.push_back(Word{std::string{text.substr(begin, i - begin)}, begin, line, begin - lineStart + 1});
+        }
+
+        return words;
+    }
+
+
+    std::string temporaryPath(const std::string& name)
+    {
+        return ::testing::TempDir() + "DocumentTokenizer_Tests_" + name;
+    }
+}
+
+
+TEST(DocumentTokenizer_Tests, emptyTextHasNoWords)
+{
+    EXPECT_TRUE(tokenize("").empty());
+    EXPECT_TRUE(tokenize(" \n\t.,;'\n").empty());
+}
+
+
+TEST(DocumentTokenizer_Tests, wordsAreFoundWithTheirPositions)
+{
+    std::vector<Word> expected{
+        {"The", 0, 1, 1}, {"cat", 4, 1, 5}, {"sat", 8, 2, 1},
+        {"on", 15, 4, 2}, {"the", 18, 4, 5}, {"mat", 22, 4, 9}};
+
+    EXPECT_EQ(expected, tokenize("The cat\nsat.\n\n on the mat"));
+}
+
+
+TEST(DocumentTokenizer_Tests, apostrophesAreOnlyPartOfWordsBetweenLetters)
+{
+    std::vector<Word> expected{
+        {"don't", 1, 1, 2}, {"rock'n'roll", 8, 1, 9}, {"dogs", 21, 1, 22}, {"o", 29, 1, 30}};
+
+    EXPECT_EQ(expected, tokenize("'don't' rock'n'roll, dogs' ''o'"));
+}
+
+
+TEST(DocumentTokenizer_Tests, bytesOutsideAsciiArePartOfWords)
+{
+    std::vector<Word> expected{
+        {"caf\xc3\xa9", 0, 1, 1}, {"\xc3\x89t\xc3\xa9", 6, 1, 7}, {"na\xc3\xafve", 13, 2, 1},
+        {"x\x80Z\xff", 20, 2, 8}};
+
+    EXPECT_EQ(expected, tokenize("caf\xc3\xa9 \xc3\x89t\xc3\xa9,\nna\xc3\xafve x\x80Z\xff{@[`"));
+}
+
+
+TEST(DocumentTokenizer_Tests, bytesOutsideAsciiSpanningBlocksAreFoundWhole)
+{
+    const std::size_t block = DocumentTokenizer::BLOCK_SIZE;
+
+    for (std::size_t at = block - 3; at <= block + 1; ++at)
+    {
+        std::string text(block * 2, ' ');
+        text.replace(at - 3, 7, "caf\xc3\xa9's");
+        EXPECT_EQ(tokenizeSlowly(text), tokenize(text)) << at;
+    }
+}
+
+
+TEST(DocumentTokenizer_Tests, wordsSpanningBlocksAreFoundWhole)
+{
+    std::string text(DocumentTokenizer::BLOCK_SIZE - 3, ' ');
+    text += std::string(3 * DocumentTokenizer::BLOCK_SIZE, 'a') + "'b\n" + std::string(200, '\n') + "c";
+
+    EXPECT_EQ(tokenizeSlowly(text), tokenize(text));
+}
+
+
+TEST(DocumentTokenizer_Tests, apostrophesAtTheEdgesOfBlocksAreHandled)
+{
+    const std::size_t block = DocumentTokenizer::BLOCK_SIZE;
+
+    for (std::size_t at = block - 2; at <= block + 1; ++at)
+    {
+        std::string text(block * 2, 'a');
+        text[at] = '\'';
+        EXPECT_EQ(tokenizeSlowly(text), tokenize(text)) << at;
+
+        text[at + 1] = ' ';
+        EXPECT_EQ(tokenizeSlowly(text), tokenize(text)) << at;
+
+        text[at + 1] = 'a';
+        text[at - 1] = ' ';
+        EXPECT_EQ(tokenizeSlowly(text), tokenize(text)) << at;
+    }
+}
+
+
+TEST(DocumentTokenizer_Tests, wordsEndingTheTextAreFound)
+{
+    std::string text(DocumentTokenizer::BLOCK_SIZE, 'z');
+    text[10] = '\n';
+
+    std::vector<Word> expected{{std::string(10, 'z'), 0, 1, 1}, {std::string(53, 'z'), 11, 2, 1}};
+    EXPECT_EQ(expected, tokenize(text));
+
+    text.back() = '\'';
+    expected.back().word.pop_back();
+    EXPECT_EQ(expected, tokenize(text));
+}
+
+
+TEST(DocumentTokenizer_Tests, matchesCharacterAtATimeTokenizingOfRandomText)
+{
+    std::mt19937 rng{46};
+    const std::string alphabet = "abcdeXYZ    ''\n\n.,-\t\x80\xe9";
+    std::uniform_int_distribution<std::size_t> character{0, alphabet.size() - 1};
+    std::uniform_int_distribution<std::size_t> length{0, 500};
+
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string text;
+        for (std::size_t n = length(rng); n > 0; --n)
+        {
+            text += alphabet[character(rng)];
+        }
+
+        ASSERT_EQ(tokenizeSlowly(text), tokenize(text)) << text;
+    }
+}
+
+
+TEST(DocumentTokenizer_Tests, mappedDocumentsContainTheirFiles)
+{
+    std::string path = temporaryPath("document.txt");
+    std::string contents = "Hello, world\nand goodbye";
+    std::ofstream{path, std::ios::binary} << contents;
+
+    MappedDocument document{path};
+    EXPECT_EQ(contents, document.text());
+
+    MappedDocument moved{std::move(document)};
+    EXPECT_EQ(contents, moved.text());
+    EXPECT_TRUE(document.text().empty());
+}
+
+
+TEST(DocumentTokenizer_Tests, emptyFilesCanBeMapped)
+{
+    std::string path = temporaryPath("empty.txt");
+    std::ofstream{path, std::ios::binary};
+
+    MappedDocument document{path};
+    EXPECT_TRUE(document.text().empty());
+    EXPECT_TRUE(tokenize(document.text()).empty());
+}
+
+
+TEST(DocumentTokenizer_Tests, missingFilesCannotBeMapped)
+{
+    EXPECT_THROW(
+        MappedDocument{temporaryPath("missing.txt")},
+        MappedDocument::DocumentException);
+}
@@ -0,0 +1,154 @@
+// HashSet_CapacityTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for HashSet's capacity planning: reserving capacity ahead of
+// time, shrinking it afterward, and choosing the maximum load factor.
+
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(HashSet_CapacityTests, startsAtDefaultCapacity)
+{
+    HashSet<int> s{identityHash};
+
+    EXPECT_EQ(HashSet<int>::DEFAULT_CAPACITY, s.capacity());
+    EXPECT_DOUBLE_EQ(HashSet<int>::DEFAULT_MAX_LOAD_FACTOR, s.maxLoadFactor());
+}
+
+
+TEST(HashSet_CapacityTests, expectedSizeAvoidsResizing)
+{
+    HashSet<int> s{identityHash, 1000};
+    unsigned int reserved = s.capacity();
+
+    EXPECT_GE(reserved * 0.8, 1000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(reserved, s.capacity());
+    EXPECT_EQ(1000, s.size());
+}
+
+
+TEST(HashSet_CapacityTests, reserveNeverShrinks)
+{
+    HashSet<int> s{identityHash};
+    s.reserve(400);
+    unsigned int reserved = s.capacity();
+
+    s.reserve(10);
+
+    EXPECT_EQ(reserved, s.capacity());
+}
+
+
+TEST(HashSet_CapacityTests, reserveKeepsElementsInTheirNewBuckets)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 7; ++i)
+    {
+        s.add(i * 10);
+    }
+    EXPECT_EQ(7, s.elementsAtIndex(0));
+
+    s.reserve(100);
+
+    EXPECT_EQ(125, s.capacity());
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_TRUE(s.contains(i * 10));
+        EXPECT_TRUE(s.isElementAtIndex(i * 10, i * 10));
+    }
+}
+
+
+TEST(HashSet_CapacityTests, shrinkToFitReturnsToSmallestFittingCapacity)
+{
+    HashSet<int> s{identityHash, 10000};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    s.shrinkToFit();
+
+    EXPECT_EQ(125, s.capacity());
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(HashSet_CapacityTests, shrinkToFitNeverGoesBelowDefaultCapacity)
+{
+    HashSet<int> s{identityHash, 1000};
+
+    s.shrinkToFit();
+
+    EXPECT_EQ(HashSet<int>::DEFAULT_CAPACITY, s.capacity());
+}
+
+
+TEST(HashSet_CapacityTests, maxLoadFactorControlsWhenToResize)
+{
+    HashSet<int> s{identityHash, 0, 2.0};
+
+    for (int i = 0; i < 20; ++i)
+    {
+        s.add(i);
+    }
+    EXPECT_EQ(10, s.capacity());
+
+    s.add(20);
+    EXPECT_EQ(20, s.capacity());
+}
+
+
+TEST(HashSet_CapacityTests, loweringMaxLoadFactorGrowsRightAway)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 8; ++i)
+    {
+        s.add(i);
+    }
+
+    s.setMaxLoadFactor(0.5);
+
+    EXPECT_DOUBLE_EQ(0.5, s.maxLoadFactor());
+    EXPECT_EQ(16, s.capacity());
+}
+
+
+TEST(HashSet_CapacityTests, nonPositiveMaxLoadFactorIsReplacedByDefault)
+{
+    HashSet<int> s{identityHash, 0, -1.0};
+
+    EXPECT_DOUBLE_EQ(HashSet<int>::DEFAULT_MAX_LOAD_FACTOR, s.maxLoadFactor());
+}
+
+
+TEST(HashSet_CapacityTests, copiesAndMovesKeepMaxLoadFactor)
+{
+    HashSet<int> s{identityHash, 0, 3.0};
+
+    HashSet<int> copy{s};
+    HashSet<int> moved{std::move(copy)};
+
+    EXPECT_DOUBLE_EQ(3.0, moved.maxLoadFactor());
+}
@@ -0,0 +1,171 @@
+// HashSet_StatisticsTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for HashSet::statistics(), which should make a degenerate
+// hash function (like zeroHash in the sanity-checking tests) easy to see.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+
+
+namespace
+{
+    template <typename T>
+    unsigned int zeroHash(const T&)
+    {
+        return 0;
+    }
+
+
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(HashSet_StatisticsTests, emptySetHasOnlyEmptyLists)
+{
+    HashSet<int> s{identityHash};
+
+    HashSet<int>::Statistics stats = s.statistics();
+
+    EXPECT_EQ(0, stats.size);
+    EXPECT_EQ(10, stats.capacity);
+    EXPECT_DOUBLE_EQ(0.0, stats.loadFactor);
+    ASSERT_EQ(1, stats.chainLengths.size());
+    EXPECT_EQ(10, stats.chainLengths[0]);
+    EXPECT_EQ(0, stats.maxProbeLength);
+    EXPECT_DOUBLE_EQ(0.0, stats.meanProbeLength);
+    EXPECT_EQ(0, stats.resizeCount);
+}
+
+
+TEST(HashSet_StatisticsTests, zeroHashPutsEverythingInOneList)
+{
+    HashSet<int> s{zeroHash<int>};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+
+    HashSet<int>::Statistics stats = s.statistics();
+
+    EXPECT_EQ(3, stats.size);
+    EXPECT_DOUBLE_EQ(0.3, stats.loadFactor);
+    ASSERT_EQ(4, stats.chainLengths.size());
+    EXPECT_EQ(9, stats.chainLengths[0]);
+    EXPECT_EQ(0, stats.chainLengths[1]);
+    EXPECT_EQ(0, stats.chainLengths[2]);
+    EXPECT_EQ(1, stats.chainLengths[3]);
+    EXPECT_EQ(3, stats.maxProbeLength);
+    EXPECT_DOUBLE_EQ(2.0, stats.meanProbeLength);
+}
+
+
+TEST(HashSet_StatisticsTests, goodHashKeepsListsShort)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int>::Statistics stats = s.statistics();
+
+    EXPECT_EQ(1, stats.maxProbeLength);
+    EXPECT_DOUBLE_EQ(1.0, stats.meanProbeLength);
+    EXPECT_EQ(stats.capacity - 1000, stats.chainLengths[0]);
+    EXPECT_EQ(1000, stats.chainLengths[1]);
+}
+
+
+TEST(HashSet_StatisticsTests, resizesAreCounted)
+{
+    HashSet<int> s{identityHash};
+    for (int i = 0; i < 9; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(1, s.statistics().resizeCount);
+
+    s.reserve(1000);
+    s.shrinkToFit();
+
+    EXPECT_EQ(3, s.statistics().resizeCount);
+}
+
+
+TEST(HashSet_StatisticsTests, reservingAheadAvoidsResizes)
+{
+    HashSet<int> s{identityHash, 1000};
+    unsigned int capacity = s.capacity();
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(0, s.statistics().resizeCount);
+    EXPECT_EQ(capacity, s.capacity());
+}
+
+
+TEST(HashSet_StatisticsTests, allocatedBytesCoverArrayAndNodes)
+{
+    HashSet<std::string> s{zeroHash<std::string>};
+    std::size_t empty = s.statistics().allocatedBytes;
+    s.add("Boo");
+    s.add("is");
+    std::size_t two = s.statistics().allocatedBytes;
+
+    EXPECT_EQ(10 * sizeof(void*), empty);
+    EXPECT_GE(two, empty + 2 * sizeof(std::string));
+}
+
+
+TEST(HashSet_StatisticsTests, lookupsAreNotCountedByDefault)
+{
+    HashSet<int> s{zeroHash<int>};
+    s.add(1);
+    s.add(2);
+    s.contains(1);
+
+    HashSet<int>::Statistics stats = s.statistics();
+
+    EXPECT_EQ(0, stats.lookups);
+    EXPECT_EQ(0, stats.probes);
+}
+
+
+TEST(HashSet_StatisticsTests, lookupsAreCountedWhenAskedFor)
+{
+    HashSet<int, HashSetCountedLookups> s{zeroHash<int>};
+    s.add(1);
+    s.add(2);
+    s.contains(1);
+
+    HashSet<int, HashSetCountedLookups>::Statistics stats = s.statistics();
+
+    // add(1) visits no nodes and add(2) visits one; contains(1) visits two,
+    // since 2 was added in front of 1.
+    EXPECT_EQ(3, stats.lookups);
+    EXPECT_EQ(3, stats.probes);
+}
+
+
+TEST(HashSet_StatisticsTests, copiesStartCountingLookupsAfresh)
+{
+    HashSet<int, HashSetCountedLookups> s{zeroHash<int>};
+    s.add(1);
+    s.contains(1);
+
+    HashSet<int, HashSetCountedLookups> copied{s};
+    copied.contains(1);
+
+    EXPECT_EQ(2, s.statistics().lookups);
+    EXPECT_EQ(1, copied.statistics().lookups);
+    EXPECT_EQ(1, copied.statistics().probes);
+}
@@ -0,0 +1,216 @@
+// LikelyEdits_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the tiers of likely edits, Soundex keys, PhoneticIndex,
+// and the suggestions findLikelySuggestions() makes with them.
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "LikelyEdits.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    const std::vector<std::string> dictionary{
+        "THE", "CAT", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "CATS", "SCAT",
+        "ACT", "CUT", "COT", "BAT", "HAT", "MAT", "SAT", "CAB", "CAN", "CAP", "CAR",
+        "RHYTHM", "RHYTHMS", "RATHER", "VAT", "FAT", "KAT"};
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const std::string& word : dictionary)
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    std::string sorted(std::string_view letters)
+    {
+        std::string s{letters};
+        std::sort(s.begin(), s.end());
+        return s;
+    }
+
+
+    std::vector<std::string> sorted(std::vector<std::string> words)
+    {
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+}
+
+
+TEST(LikelyEdits_Tests, adjacentKeysFollowTheKeyboard)
+{
+    EXPECT_EQ("ADEWXZ", sorted(LikelyEdits::replacements('S', EditTier::Adjacent)));
+    EXPECT_EQ("AW", sorted(LikelyEdits::replacements('Q', EditTier::Adjacent)));
+    EXPECT_EQ("ASX", sorted(LikelyEdits::replacements('Z', EditTier::Adjacent)));
+    EXPECT_EQ("ADEWXZ", sorted(LikelyEdits::replacements('s', EditTier::Adjacent)));
+}
+
+
+TEST(LikelyEdits_Tests, soundAlikeLettersExcludeAdjacentOnes)
+{
+    // C is next to X on the keyboard, and V next to B and F, so those are
+    // adjacent rather than sound-alike.
+    EXPECT_EQ("GJKQSZ", sorted(LikelyEdits::replacements('C', EditTier::SoundAlike)));
+    EXPECT_EQ("P", sorted(LikelyEdits::replacements('V', EditTier::SoundAlike)));
+    EXPECT_EQ("", sorted(LikelyEdits::replacements('L', EditTier::SoundAlike)));
+}
+
+
+TEST(LikelyEdits_Tests, replacementTiersTogetherAreTheWholeAlphabet)
+{
+    for (char c : std::string{"ABCDEFGHIJKLMNOPQRSTUVWXYZ'"})
+    {
+        std::string all;
+        for (EditTier tier : {EditTier::Adjacent, EditTier::SoundAlike, EditTier::Other})
+        {
+            all += LikelyEdits::replacements(c, tier);
+        }
+        EXPECT_EQ("ABCDEFGHIJKLMNOPQRSTUVWXYZ", sorted(all)) << c;
+    }
+}
+
+
+TEST(LikelyEdits_Tests, insertionTiersStartWithDoubledLetters)
+{
+    std::string letters;
+
+    LikelyEdits::insertions('C', 'A', EditTier::Adjacent, letters);
+    EXPECT_EQ("CA", letters.substr(0, 2));
+    EXPECT_EQ("ACDFQSVWXZ", sorted(letters));
+
+    LikelyEdits::insertions('\0', 'Q', EditTier::Adjacent, letters);
+    EXPECT_EQ("AQW", sorted(letters));
+
+    for (char before : {'\0', 'C', 'M', '\''})
+    {
+        std::string all;
+        for (EditTier tier : {EditTier::Adjacent, EditTier::SoundAlike, EditTier::Other})
+        {
+            LikelyEdits::insertions(before, 'T', tier, letters);
+            all += letters;
+        }
+        EXPECT_EQ("ABCDEFGHIJKLMNOPQRSTUVWXYZ", sorted(all)) << before;
+    }
+}
+
+
+TEST(LikelyEdits_Tests, soundexKeysAreComputedAsUsual)
+{
+    EXPECT_EQ("R163", soundexKey("ROBERT"));
+    EXPECT_EQ("R163", soundexKey("rupert"));
+    EXPECT_EQ("A261", soundexKey("ASHCRAFT"));
+    EXPECT_EQ("T522", soundexKey("TYMCZAK"));
+    EXPECT_EQ("P236", soundexKey("PFISTER"));
+    EXPECT_EQ("H555", soundexKey("HONEYMAN"));
+    EXPECT_EQ("D530", soundexKey("DON'T"));
+    EXPECT_EQ("A000", soundexKey("A"));
+    EXPECT_EQ("", soundexKey("'"));
+}
+
+
+TEST(LikelyEdits_Tests, phoneticIndexGroupsWordsBySoundexKey)
+{
+    PhoneticIndex index;
+    for (const std::string& word : dictionary)
+    {
+        index.add(word);
+    }
+
+    EXPECT_EQ(dictionary.size(), index.size());
+    EXPECT_EQ(std::vector<std::string>{"RHYTHM"}, index.wordsLike("RITHM"));
+    EXPECT_EQ(std::vector<std::string>{"RHYTHMS"}, index.wordsLike("RITHMS"));
+    EXPECT_TRUE(index.wordsLike("XYZZY").empty());
+}
+
+
+TEST(LikelyEdits_Tests, allTiersFindWhatReplaceAndInsertFind)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    BasicWordChecker<HashSet<std::string>> direct{words};
+
+    for (const char* word : {"CAX", "CTA", "CT", "AT", "XAT", "RHYTM", "Q", ""})
+    {
+        std::vector<std::string> replaced;
+        std::vector<std::string> inserted;
+        checker.replaceIt(word, replaced);
+        checker.insertIt(word, inserted);
+
+        std::vector<std::string> likelyReplaced;
+        std::vector<std::string> likelyInserted;
+        for (EditTier tier : {EditTier::Adjacent, EditTier::SoundAlike, EditTier::Other})
+        {
+            direct.likelyReplaceIt(word, likelyReplaced, tier);
+            direct.likelyInsertIt(word, likelyInserted, tier);
+        }
+
+        EXPECT_EQ(sorted(replaced), sorted(likelyReplaced)) << word;
+        EXPECT_EQ(sorted(inserted), sorted(likelyInserted)) << word;
+    }
+}
+
+
+TEST(LikelyEdits_Tests, likelySuggestionsComeFirst)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    // R is next to E on the keyboard, so CAR comes ahead of CAB, which
+    // findSuggestions() finds first.
+    EXPECT_EQ("CAB", checker.findSuggestions("CAE").front());
+    EXPECT_EQ(std::vector<std::string>{"CAR"}, checker.findLikelySuggestions("CAE", 1));
+    EXPECT_EQ(std::vector<std::string>{"CAT"}, checker.findLikelySuggestions("CTA", 1));
+    EXPECT_TRUE(checker.findLikelySuggestions("CAE", 0).empty());
+}
+
+
+TEST(LikelyEdits_Tests, restrictingTiersLeavesOutUnlikelyLetters)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    std::vector<std::string> all = checker.findLikelySuggestions("PAT", 100);
+    std::vector<std::string> adjacent = checker.findLikelySuggestions("PAT", 100, nullptr, EditTier::Adjacent);
+
+    EXPECT_EQ(sorted(checker.findSuggestions("PAT")), sorted(all));
+    EXPECT_TRUE(std::find(all.begin(), all.end(), "MAT") != all.end());
+    EXPECT_TRUE(std::find(adjacent.begin(), adjacent.end(), "MAT") == adjacent.end());
+    EXPECT_LT(adjacent.size(), all.size());
+}
+
+
+TEST(LikelyEdits_Tests, soundAlikeWordsAreSuggestedWithAnIndex)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    PhoneticIndex index;
+    for (const std::string& word : dictionary)
+    {
+        index.add(word);
+    }
+
+    EXPECT_TRUE(checker.findLikelySuggestions("RITHM", 5).empty());
+    EXPECT_EQ(std::vector<std::string>{"RHYTHM"}, checker.findLikelySuggestions("RITHM", 5, &index));
+}
@@ -0,0 +1,216 @@
+// MappedDictionary_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for writing dictionary files and opening them as a
+// MappedDictionary.
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MappedDictionary.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::string temporaryPath(const std::string& name)
+    {
+        return ::testing::TempDir() + "MappedDictionary_Tests_" + name;
+    }
+
+
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back("W" + std::to_string(i * 7919));
+        }
+        return words;
+    }
+}
+
+
+TEST(MappedDictionary_Tests, containsExactlyTheWordsWritten)
+{
+    std::string path = temporaryPath("exact.dict");
+    std::vector<std::string> words = makeWords(50000);
+    writeMappedDictionary(path, words);
+
+    MappedDictionary d{path};
+
+    EXPECT_TRUE(d.isImplemented());
+    EXPECT_EQ(50000, d.size());
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(d.contains(word)) << word;
+    }
+    EXPECT_FALSE(d.contains(std::string{"W1"}));
+    EXPECT_FALSE(d.contains(std::string{""}));
+    EXPECT_FALSE(d.contains(std::string_view{"W79190"}.substr(0, 3)));
+}
+
+
+TEST(MappedDictionary_Tests, duplicatesAreStoredOnce)
+{
+    std::string path = temporaryPath("duplicates.dict");
+    writeMappedDictionary(path, {"BOO", "IS", "BOO", "HAPPY", "IS"});
+
+    MappedDictionary d{path};
+
+    EXPECT_EQ(3, d.size());
+}
+
+
+TEST(MappedDictionary_Tests, wordsAreVisitedInAscendingOrder)
+{
+    std::string path = temporaryPath("ordered.dict");
+    writeMappedDictionary(path, {"TODAY", "BOO", "IS", "HAPPY"});
+
+    MappedDictionary d{path};
+    std::vector<std::string> visited;
+    d.forEachWord([&](std::string_view word) { visited.emplace_back(word); });
+
+    EXPECT_EQ((std::vector<std::string>{"BOO", "HAPPY", "IS", "TODAY"}), visited);
+}
+
+
+TEST(MappedDictionary_Tests, emptyDictionaryContainsNothing)
+{
+    std::string path = temporaryPath("empty.dict");
+    writeMappedDictionary(path, {});
+
+    MappedDictionary d{path};
+
+    EXPECT_EQ(0, d.size());
+    EXPECT_FALSE(d.contains(std::string{"BOO"}));
+}
+
+
+TEST(MappedDictionary_Tests, addingThrows)
+{
+    std::string path = temporaryPath("readonly.dict");
+    writeMappedDictionary(path, {"BOO"});
+
+    MappedDictionary d{path};
+    Set<std::string>& s = d;
+
+    EXPECT_THROW(s.add("IS"), MappedDictionary::DictionaryException);
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(MappedDictionary_Tests, missingFileThrows)
+{
+    EXPECT_THROW(
+        MappedDictionary{temporaryPath("does-not-exist.dict")},
+        MappedDictionary::DictionaryException);
+}
+
+
+TEST(MappedDictionary_Tests, otherFilesAreRejected)
+{
+    std::string path = temporaryPath("words.txt");
+    {
+        std::ofstream out{path};
+        out << "This is a word list, not a dictionary file.\nBOO\nIS\nHAPPY\n";
+    }
+
+    try
+    {
+        MappedDictionary d{path};
+        FAIL() << "opened a text file as a dictionary";
+    }
+    catch (MappedDictionary::DictionaryException& e)
+    {
+        EXPECT_NE(std::string::npos, e.reason().find("not a dictionary file"));
+    }
+}
+
+
+TEST(MappedDictionary_Tests, dictionaryFilesAreRecognizedEvenWhenDamaged)
+{
+    std::string path = temporaryPath("recognized.dict");
+    writeMappedDictionary(path, makeWords(100));
+    EXPECT_TRUE(isMappedDictionaryFile(path));
+
+    // Cutting the file short leaves it a dictionary file, but one that
+    // can't be opened.
+    std::string damagedPath = temporaryPath("damaged.dict");
+    {
+        std::ifstream in{path, std::ios::binary};
+        std::string contents{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+        std::ofstream out{damagedPath, std::ios::binary};
+        out << contents.substr(0, 12);
+    }
+    EXPECT_TRUE(isMappedDictionaryFile(damagedPath));
+
+    try
+    {
+        MappedDictionary d{damagedPath};
+        FAIL() << "opened a damaged dictionary file";
+    }
+    catch (MappedDictionary::DictionaryException& e)
+    {
+        EXPECT_NE(std::string::npos, e.reason().find("is damaged"));
+    }
+
+    std::string listPath = temporaryPath("list.txt");
+    {
+        std::ofstream out{listPath};
+        out << "BOO\nIS\nHAPPY\n";
+    }
+    EXPECT_FALSE(isMappedDictionaryFile(listPath));
+    EXPECT_FALSE(isMappedDictionaryFile(temporaryPath("does-not-exist.dict")));
+}
+
+
+TEST(MappedDictionary_Tests, rewritingLeavesOpenDictionaryIntact)
+{
+    std::string path = temporaryPath("rewritten.dict");
+    writeMappedDictionary(path, {"BOO", "IS"});
+    MappedDictionary before{path};
+
+    writeMappedDictionary(path, {"HAPPY"});
+    MappedDictionary after{path};
+
+    EXPECT_TRUE(before.contains(std::string{"BOO"}));
+    EXPECT_EQ(2, before.size());
+    EXPECT_TRUE(after.contains(std::string{"HAPPY"}));
+    EXPECT_FALSE(after.contains(std::string{"BOO"}));
+}
+
+
+TEST(MappedDictionary_Tests, movedDictionaryKeepsItsWords)
+{
+    std::string path = temporaryPath("moved.dict");
+    writeMappedDictionary(path, {"BOO"});
+    MappedDictionary d{path};
+
+    MappedDictionary moved{std::move(d)};
+
+    EXPECT_TRUE(moved.contains(std::string{"BOO"}));
+    EXPECT_EQ(0, d.size());
+    EXPECT_FALSE(d.contains(std::string{"BOO"}));
+}
+
+
+TEST(MappedDictionary_Tests, canBeUsedByWordChecker)
+{
+    std::string path = temporaryPath("checker.dict");
+    writeMappedDictionary(path, {"BOO", "IS", "HAPPY", "TODAY"});
+    MappedDictionary d{path};
+
+    WordChecker checker{d};
+
+    EXPECT_TRUE(checker.wordExists("HAPPY"));
+    EXPECT_FALSE(checker.wordExists("HAPPI"));
+    std::vector<std::string> suggestions = checker.findSuggestions("HAPPI");
+    EXPECT_NE(suggestions.end(), std::find(suggestions.begin(), suggestions.end(), "HAPPY"));
+}
@@ -0,0 +1,259 @@
+// PipelineChecker_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for PipelineChecker, mostly checking that it writes exactly
+// what checkText() does, however the input is cut into chunks and however
+// many workers there are.
+
+#include <functional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "BatchChecker.hpp"
+#include "HashSet.hpp"
+#include "PipelineChecker.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT", "DON'T", "AT", "A", "TA"})
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    std::string makeText(unsigned int seed, std::size_t size)
+    {
+        std::mt19937 rng{seed};
+        const std::string alphabet = "acmnotsTAC''    \n.,";
+        std::uniform_int_distribution<std::size_t> character{0, alphabet.size() - 1};
+
+        std::string text;
+        while (text.size() < size)
+        {
+            text += alphabet[character(rng)];
+        }
+        return text;
+    }
+
+
+    std::string checkSerially(const WordChecker& checker, std::string_view text)
+    {
+        std::ostringstream out;
+        {
+            BatchOutput output{out};
+            checkText(checker, text, output);
+        }
+        return out.str();
+    }
+
+
+    std::string checkInPipeline(
+        const WordChecker& checker, std::string_view text, unsigned int workers,
+        std::size_t chunkSize, bool asStream, BatchStatistics* stats = nullptr)
+    {
+        PipelineChecker pipeline{checker, workers, chunkSize};
+        std::ostringstream out;
+        {
+            BatchOutput output{out};
+            BatchStatistics s;
+
+            if (asStream)
+            {
+                std::istringstream in{std::string{text}};
+                s = pipeline.check(in, output);
+            }
+            else
+            {
+                s = pipeline.check(text, output);
+            }
+
+            if (stats != nullptr)
+            {
+                *stats = s;
+            }
+        }
+        return out.str();
+    }
+
+
+    class ThrowingSet : public Set<std::string>
+    {
+    public:
+        bool isImplemented() const noexcept override
+        {
+            return true;
+        }
+
+        void add(const std::string&) override
+        {
+        }
+
+        bool contains(const std::string& element) const override
+        {
+            if (element == "BOOM")
+            {
+                throw std::runtime_error{"boom"};
+            }
+            return element == "CAT";
+        }
+
+        unsigned int size() const noexcept override
+        {
+            return 1;
+        }
+    };
+}
+
+
+TEST(PipelineChecker_Tests, emptyInputWritesNothing)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    BatchStatistics stats;
+
+    EXPECT_EQ("", checkInPipeline(checker, "", 2, 16, false, &stats));
+    EXPECT_EQ(0, stats.words);
+    EXPECT_EQ("", checkInPipeline(checker, "", 2, 16, true, &stats));
+    EXPECT_EQ(0, stats.bytes);
+}
+
+
+TEST(PipelineChecker_Tests, writesWhatCheckTextWritesInTheSameOrder)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    std::string text = makeText(44, 20000);
+    std::string expected = checkSerially(checker, text);
+
+    for (std::size_t chunkSize : {1, 7, 64, 1000, 1 << 20})
+    {
+        for (unsigned int workers : {1, 3})
+        {
+            BatchStatistics stats;
+            ASSERT_EQ(expected, checkInPipeline(checker, text, workers, chunkSize, false, &stats))
+                << chunkSize << " " << workers;
+            EXPECT_EQ(text.size(), stats.bytes);
+        }
+    }
+}
+
+
+TEST(PipelineChecker_Tests, rankedSuggestionsAreWrittenAsCheckTextWritesThem)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies;
+    frequencies.add("A", 50);
+    frequencies.add("AT", 40);
+    frequencies.add("CAT", 30);
+    frequencies.add("TA", 20);
+    WordChecker checker{words, frequencies};
+
+    std::string text = makeText(45, 20000);
+    std::string expected = checkSerially(checker, text);
+    EXPECT_NE(expected, checkSerially(WordChecker{words}, text));
+
+    for (unsigned int workers : {1, 3})
+    {
+        EXPECT_EQ(expected, checkInPipeline(checker, text, workers, 64, false)) << workers;
+    }
+}
+
+
+TEST(PipelineChecker_Tests, streamsAreCheckedLikeTexts)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    std::string text = makeText(45, 20000);
+    std::string expected = checkSerially(checker, text);
+
+    for (std::size_t chunkSize : {1, 5, 333, 1 << 20})
+    {
+        BatchStatistics stats;
+        ASSERT_EQ(expected, checkInPipeline(checker, text, 2, chunkSize, true, &stats)) << chunkSize;
+        EXPECT_EQ(text.size(), stats.bytes);
+    }
+}
+
+
+TEST(PipelineChecker_Tests, wordsLongerThanAChunkAreNotSplit)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    std::string text = "cat " + std::string(100, 'x') + "'s\nthe catt";
+    std::string expected = checkSerially(checker, text);
+
+    EXPECT_EQ(expected, checkInPipeline(checker, text, 2, 8, false));
+    EXPECT_EQ(expected, checkInPipeline(checker, text, 2, 8, true));
+}
+
+
+TEST(PipelineChecker_Tests, wordsOutsideAsciiAreNotSplit)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    std::string text = "the caf\xc3\xa9\nna\xc3\xafve \xc3\xa9t\xc3\xa9 cat";
+    std::string expected = checkSerially(checker, text);
+    EXPECT_NE(std::string::npos, expected.find("caf\xc3\xa9\t"));
+
+    for (std::size_t chunkSize : {1, 2, 3, 5})
+    {
+        EXPECT_EQ(expected, checkInPipeline(checker, text, 2, chunkSize, false)) << chunkSize;
+        EXPECT_EQ(expected, checkInPipeline(checker, text, 2, chunkSize, true)) << chunkSize;
+    }
+}
+
+
+TEST(PipelineChecker_Tests, manyMoreMisspellingsThanTheWindowStayInOrder)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    std::string text;
+    for (std::size_t i = 0; i < PipelineChecker::WINDOW * 3; ++i)
+    {
+        text += i % 2 == 0 ? "caat " : "mta\n";
+    }
+
+    BatchStatistics stats;
+    EXPECT_EQ(checkSerially(checker, text), checkInPipeline(checker, text, 4, 4096, false, &stats));
+    EXPECT_EQ(PipelineChecker::WINDOW * 3, stats.misspellings);
+}
+
+
+TEST(PipelineChecker_Tests, exceptionsInAStageAreRethrown)
+{
+    ThrowingSet words;
+    WordChecker checker{words};
+    std::string text = makeText(46, 5000) + " boom " + makeText(47, 5000);
+
+    EXPECT_THROW(checkInPipeline(checker, text, 2, 100, false), std::runtime_error);
+    EXPECT_THROW(checkInPipeline(checker, text, 2, 100, true), std::runtime_error);
+}
+
+
+TEST(PipelineChecker_Tests, workerCountDefaultsToAtLeastOne)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    EXPECT_LE(1, PipelineChecker{checker}.workerCount());
+    EXPECT_EQ(3, (PipelineChecker{checker, 3}.workerCount()));
+}
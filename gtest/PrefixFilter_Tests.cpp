@@ -0,0 +1,147 @@
+// PrefixFilter_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for PrefixFilter, checking its answers against a scan of the
+// words for every prefix of every word, and a few that begin none.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "PrefixFilter.hpp"
+
+
+namespace
+{
+    const std::vector<std::string> words{
+        "CAT", "CATS", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "SCAT", "DON'T", "cab", "CAT"};
+}
+
+
+TEST(PrefixFilter_Tests, duplicatesAreDroppedAndCaseIsFolded)
+{
+    PrefixFilter filter{words};
+
+    EXPECT_EQ(12u, filter.size());
+    EXPECT_TRUE(filter.hasPrefix("CAB"));
+    EXPECT_FALSE(filter.hasPrefix("cab"));
+}
+
+
+TEST(PrefixFilter_Tests, everyPrefixOfEveryWordIsFound)
+{
+    PrefixFilter filter{words};
+
+    std::vector<std::string> upperCaseWords{
+        "CAT", "CATS", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "SCAT", "DON'T"};
+
+    for (const std::string& word : upperCaseWords)
+    {
+        for (std::size_t length = 0; length <= word.size(); ++length)
+        {
+            EXPECT_TRUE(filter.hasPrefix(word.substr(0, length))) << word << " " << length;
+        }
+    }
+}
+
+
+TEST(PrefixFilter_Tests, prefixesOfNoWordAreNotFound)
+{
+    PrefixFilter filter{words};
+
+    for (const char* prefix : {"CATSS", "CB", "B", "ATE", "DONT", "SCATTER", "Z"})
+    {
+        EXPECT_FALSE(filter.hasPrefix(prefix)) << prefix;
+    }
+}
+
+
+TEST(PrefixFilter_Tests, narrowingRangesWalksTheWordsLikeATrie)
+{
+    PrefixFilter filter{words};
+
+    PrefixFilter::Range c = filter.narrow(filter.all(), 0, 'C');
+    EXPECT_EQ(6u, c.last - c.first);
+
+    PrefixFilter::Range ca = filter.narrow(c, 1, 'A');
+    EXPECT_EQ(5u, ca.last - ca.first);
+
+    PrefixFilter::Range cat = filter.narrow(ca, 2, 'T');
+    EXPECT_EQ(2u, cat.last - cat.first);
+
+    EXPECT_TRUE(filter.narrow(cat, 3, 'T').empty());
+    EXPECT_EQ(1u, filter.narrow(cat, 3, 'S').last - filter.narrow(cat, 3, 'S').first);
+}
+
+
+TEST(PrefixFilter_Tests, branchesAreTheCharactersThatComeNext)
+{
+    PrefixFilter filter{words};
+
+    std::vector<PrefixFilter::Branch> branches;
+    PrefixFilter::Range ca = filter.narrow(filter.narrow(filter.all(), 0, 'C'), 1, 'A');
+
+    filter.branches(ca, 2, branches);
+    ASSERT_EQ(4u, branches.size());
+    EXPECT_EQ('B', branches[0].c);
+    EXPECT_EQ('R', branches[1].c);
+    EXPECT_EQ('S', branches[2].c);
+    EXPECT_EQ('T', branches[3].c);
+
+    for (const PrefixFilter::Branch& branch : branches)
+    {
+        PrefixFilter::Range narrowed = filter.narrow(ca, 2, branch.c);
+        EXPECT_EQ(narrowed.first, branch.range.first) << branch.c;
+        EXPECT_EQ(narrowed.last, branch.range.last) << branch.c;
+    }
+
+    // "A" is a word, but isn't a branch from itself.
+    filter.branches(filter.narrow(filter.all(), 0, 'A'), 1, branches);
+    ASSERT_EQ(2u, branches.size());
+    EXPECT_EQ('N', branches[0].c);
+    EXPECT_EQ('T', branches[1].c);
+
+    filter.branches(filter.narrow(ca, 2, 'B'), 3, branches);
+    EXPECT_TRUE(branches.empty());
+}
+
+
+TEST(PrefixFilter_Tests, longRangesAreNarrowedLikeShortOnes)
+{
+    // Every two-letter word, so that the Ranges are long enough to be
+    // searched rather than scanned.
+    std::vector<std::string> pairs;
+    for (char first = 'A'; first <= 'Z'; ++first)
+    {
+        for (char second = 'A'; second <= 'Z'; ++second)
+        {
+            pairs.push_back(std::string{first} + second);
+        }
+    }
+
+    PrefixFilter filter{pairs};
+
+    std::vector<PrefixFilter::Branch> branches;
+    filter.branches(filter.all(), 0, branches);
+    ASSERT_EQ(26u, branches.size());
+
+    for (const PrefixFilter::Branch& branch : branches)
+    {
+        EXPECT_EQ(26u, branch.range.last - branch.range.first) << branch.c;
+        EXPECT_EQ(1u, filter.narrow(branch.range, 1, 'Q').last - filter.narrow(branch.range, 1, 'Q').first);
+    }
+
+    EXPECT_TRUE(filter.hasPrefix("QZ"));
+    EXPECT_FALSE(filter.hasPrefix("QZA"));
+}
+
+
+TEST(PrefixFilter_Tests, emptyFiltersHaveNoPrefixes)
+{
+    PrefixFilter filter{std::vector<std::string>{}};
+
+    EXPECT_TRUE(filter.all().empty());
+    EXPECT_FALSE(filter.hasPrefix(""));
+    EXPECT_FALSE(filter.hasPrefix("A"));
+}
@@ -0,0 +1,340 @@
+// SetSerialization_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for saving snapshots of HashSets and AVLSets and loading them
+// back, which should rebuild exactly the structure that was saved.
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    unsigned int hashCalls = 0;
+
+
+    unsigned int countingHash(const std::string& s)
+    {
+        ++hashCalls;
+        return std::hash<std::string>{}(s);
+    }
+
+
+    unsigned int intHash(const int& i)
+    {
+        return static_cast<unsigned int>(i) * 2654435761u;
+    }
+
+
+    template <typename Traversal>
+    std::vector<int> collect(Traversal traversal)
+    {
+        std::vector<int> elements;
+        for (int element : traversal)
+        {
+            elements.push_back(element);
+        }
+        return elements;
+    }
+}
+
+
+TEST(SetSerialization_Tests, hashSetLoadsWithoutHashing)
+{
+    HashSet<std::string> s{countingHash};
+    for (int i = 0; i < 20000; ++i)
+    {
+        s.add("word" + std::to_string(i));
+    }
+
+    std::stringstream stream;
+    s.save(stream);
+
+    HashSet<std::string> loaded{countingHash};
+    hashCalls = 0;
+    loaded.load(stream);
+
+    EXPECT_EQ(0, hashCalls);
+    EXPECT_EQ(s.size(), loaded.size());
+    EXPECT_EQ(s.capacity(), loaded.capacity());
+    for (unsigned int i = 0; i < s.capacity(); ++i)
+    {
+        ASSERT_EQ(s.elementsAtIndex(i), loaded.elementsAtIndex(i));
+    }
+    for (int i = 0; i < 20000; ++i)
+    {
+        ASSERT_TRUE(loaded.contains("word" + std::to_string(i)));
+    }
+    EXPECT_FALSE(loaded.contains("word20000"));
+}
+
+
+TEST(SetSerialization_Tests, hashSetKeepsMaxLoadFactor)
+{
+    HashSet<int> s{intHash, 100, 2.5};
+    s.add(46);
+
+    std::stringstream stream;
+    s.save(stream);
+    HashSet<int> loaded{intHash};
+    loaded.load(stream);
+
+    EXPECT_DOUBLE_EQ(2.5, loaded.maxLoadFactor());
+    EXPECT_TRUE(loaded.contains(46));
+}
+
+
+TEST(SetSerialization_Tests, hashSetGrowsNormallyAfterLoading)
+{
+    HashSet<int> s{intHash};
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    std::stringstream stream;
+    s.save(stream);
+    HashSet<int> loaded{intHash};
+    loaded.load(stream);
+
+    for (int i = 100; i < 1000; ++i)
+    {
+        loaded.add(i);
+    }
+
+    EXPECT_EQ(1000, loaded.size());
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(loaded.contains(i));
+    }
+}
+
+
+TEST(SetSerialization_Tests, avlSetLoadsTheSameTree)
+{
+    AVLSet<int> s;
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add((i * 7919) % 5003);
+    }
+
+    std::stringstream stream;
+    s.save(stream);
+    AVLSet<int> loaded;
+    loaded.load(stream);
+
+    EXPECT_EQ(s.size(), loaded.size());
+    EXPECT_EQ(s.height(), loaded.height());
+    EXPECT_EQ(collect(s.preorderTraversal()), collect(loaded.preorderTraversal()));
+    EXPECT_EQ(collect(s.inorderTraversal()), collect(loaded.inorderTraversal()));
+}
+
+
+TEST(SetSerialization_Tests, avlSetTakesOnSnapshotBalancing)
+{
+    AVLSet<int> s{false};
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    std::stringstream stream;
+    s.save(stream);
+    AVLSet<int> loaded;
+    loaded.load(stream);
+
+    EXPECT_EQ(9999, loaded.height());
+
+    loaded.add(10000);
+    EXPECT_EQ(10000, loaded.height());
+}
+
+
+TEST(SetSerialization_Tests, avlSetOfStringsRoundTrips)
+{
+    AVLSet<std::string> s;
+    s.add("Boo");
+    s.add("is");
+    s.add("");
+    s.add(std::string(100000, 'x'));
+
+    std::stringstream stream;
+    s.save(stream);
+    AVLSet<std::string> loaded;
+    loaded.load(stream);
+
+    EXPECT_EQ(4, loaded.size());
+    EXPECT_TRUE(loaded.contains(""));
+    EXPECT_TRUE(loaded.contains(std::string(100000, 'x')));
+    EXPECT_TRUE(loaded.contains("Boo"));
+}
+
+
+TEST(SetSerialization_Tests, emptySetsRoundTrip)
+{
+    std::stringstream stream;
+    AVLSet<int>{}.save(stream);
+    HashSet<int>{intHash}.save(stream);
+
+    AVLSet<int> a;
+    a.add(1);
+    HashSet<int> h{intHash};
+    h.add(1);
+    a.load(stream);
+    h.load(stream);
+
+    EXPECT_EQ(0, a.size());
+    EXPECT_EQ(-1, a.height());
+    EXPECT_EQ(0, h.size());
+}
+
+
+TEST(SetSerialization_Tests, snapshotsCanFollowOneAnother)
+{
+    AVLSet<int> a;
+    HashSet<int> h{intHash};
+    for (int i = 0; i < 30000; ++i)
+    {
+        a.add(i);
+        h.add(-i);
+    }
+
+    std::stringstream stream;
+    a.save(stream);
+    h.save(stream);
+    stream << "trailer";
+
+    AVLSet<int> loadedA;
+    HashSet<int> loadedH{intHash};
+    loadedA.load(stream);
+    loadedH.load(stream);
+    std::string trailer;
+    stream >> trailer;
+
+    EXPECT_EQ(30000, loadedA.size());
+    EXPECT_EQ(30000, loadedH.size());
+    EXPECT_TRUE(loadedH.contains(-29999));
+    EXPECT_EQ("trailer", trailer);
+}
+
+
+TEST(SetSerialization_Tests, wrongKindOfSnapshotThrowsAndLeavesSetAlone)
+{
+    HashSet<int> h{intHash};
+    h.add(1);
+    std::stringstream stream;
+    h.save(stream);
+
+    AVLSet<int> a;
+    a.add(46);
+
+    EXPECT_THROW(a.load(stream), SnapshotException);
+    EXPECT_EQ(1, a.size());
+    EXPECT_TRUE(a.contains(46));
+}
+
+
+TEST(SetSerialization_Tests, truncatedSnapshotThrowsAndLeavesSetAlone)
+{
+    AVLSet<int> s;
+    HashSet<int> h{intHash};
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+        h.add(i);
+    }
+
+    std::stringstream avlStream;
+    s.save(avlStream);
+    std::stringstream hashStream;
+    h.save(hashStream);
+    std::stringstream truncatedAVL{avlStream.str().substr(0, avlStream.str().size() / 2)};
+    std::stringstream truncatedHash{hashStream.str().substr(0, hashStream.str().size() / 2)};
+
+    AVLSet<int> a;
+    a.add(46);
+    HashSet<int> b{intHash};
+    b.add(46);
+
+    EXPECT_THROW(a.load(truncatedAVL), SnapshotException);
+    EXPECT_THROW(b.load(truncatedHash), SnapshotException);
+    EXPECT_EQ(1, a.size());
+    EXPECT_EQ(1, b.size());
+    EXPECT_TRUE(b.contains(46));
+}
+
+
+TEST(SetSerialization_Tests, hashSetWithMoreElementsThanItsCapacityAllowsIsDamaged)
+{
+    HashSet<int> h{intHash};
+    h.add(1);
+    std::stringstream stream;
+    h.save(stream);
+
+    // The size follows the header and the capacity.
+    std::string bytes = stream.str();
+    std::uint32_t size = 1000;
+    std::memcpy(&bytes[16], &size, sizeof(size));
+    std::stringstream damaged{bytes};
+
+    HashSet<int> loaded{intHash};
+    loaded.add(46);
+
+    EXPECT_THROW(loaded.load(damaged), SnapshotException);
+    EXPECT_EQ(1, loaded.size());
+    EXPECT_TRUE(loaded.contains(46));
+}
+
+
+TEST(SetSerialization_Tests, hashSetWithAnImpossibleCapacityIsDamaged)
+{
+    HashSet<int> h{intHash};
+    h.add(1);
+    std::stringstream stream;
+    h.save(stream);
+
+    // The capacity follows the header.
+    std::string bytes = stream.str();
+    std::uint32_t capacity = 0x7fffffff;
+    std::memcpy(&bytes[12], &capacity, sizeof(capacity));
+    std::stringstream damaged{bytes};
+
+    HashSet<int> loaded{intHash};
+    loaded.add(46);
+
+    EXPECT_THROW(loaded.load(damaged), SnapshotException);
+    EXPECT_EQ(1, loaded.size());
+    EXPECT_TRUE(loaded.contains(46));
+}
+
+
+TEST(SetSerialization_Tests, hashSetKeepsReservedCapacity)
+{
+    HashSet<int> s{intHash};
+    s.reserve(5000);
+    for (int i = 0; i < 3; ++i)
+    {
+        s.add(i);
+    }
+
+    std::stringstream stream;
+    s.save(stream);
+    HashSet<int> loaded{intHash};
+    loaded.load(stream);
+
+    EXPECT_EQ(s.capacity(), loaded.capacity());
+    EXPECT_EQ(3, loaded.size());
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(loaded.contains(i)) << i;
+    }
+}
@@ -0,0 +1,132 @@
+// SkipListSet_FingerTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for finger searches and sorted bulk additions on SkipListSet,
+// which should build exactly the same skip list as plain add() does.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    SkipListSet<int> makeSet()
+    {
+        return SkipListSet<int>{std::make_unique<HashSkipListLevelTester<int>>(46)};
+    }
+
+
+    void expectSameLayout(const SkipListSet<int>& expected, const SkipListSet<int>& actual, int range)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        ASSERT_EQ(expected.levelCount(), actual.levelCount());
+        for (unsigned int level = 0; level < expected.levelCount(); ++level)
+        {
+            EXPECT_EQ(expected.elementsOnLevel(level), actual.elementsOnLevel(level));
+        }
+        for (int i = -1; i <= range; ++i)
+        {
+            ASSERT_EQ(expected.contains(i), actual.contains(i)) << i;
+        }
+    }
+}
+
+
+TEST(SkipListSet_FingerTests, addSortedMatchesAdd)
+{
+    std::vector<int> elements;
+    for (int i = 0; i < 20000; i += 3)
+    {
+        elements.push_back(i);
+    }
+
+    SkipListSet<int> expected = makeSet();
+    for (int i : elements)
+    {
+        expected.add(i);
+    }
+
+    SkipListSet<int> actual = makeSet();
+    actual.addSorted(elements.begin(), elements.end());
+
+    expectSameLayout(expected, actual, 20000);
+}
+
+
+TEST(SkipListSet_FingerTests, addSortedInterleavesWithExistingElements)
+{
+    SkipListSet<int> expected = makeSet();
+    SkipListSet<int> actual = makeSet();
+    std::vector<int> evens;
+    std::vector<int> odds;
+    for (int i = 0; i < 10000; ++i)
+    {
+        expected.add(i);
+        (i % 2 == 0 ? evens : odds).push_back(i);
+    }
+
+    actual.addSorted(odds.begin(), odds.end());
+    actual.addSorted(evens.begin(), evens.end());
+    actual.addSorted(odds.begin(), odds.end());
+
+    expectSameLayout(expected, actual, 10000);
+}
+
+
+TEST(SkipListSet_FingerTests, fingerToleratesUnsortedKeys)
+{
+    std::vector<int> elements;
+    for (int i = 0; i < 5000; ++i)
+    {
+        elements.push_back(i * 7 % 5003);
+    }
+    std::shuffle(elements.begin(), elements.end(), std::mt19937{46});
+
+    SkipListSet<int> expected = makeSet();
+    SkipListSet<int> actual = makeSet();
+    SkipListSet<int>::Finger finger;
+    for (int i : elements)
+    {
+        expected.add(i);
+        actual.add(i, finger);
+    }
+
+    expectSameLayout(expected, actual, 5003);
+}
+
+
+TEST(SkipListSet_FingerTests, fingerContainsAgreesWithContains)
+{
+    SkipListSet<std::string> s;
+    std::vector<std::string> words;
+    for (int i = 0; i < 3000; ++i)
+    {
+        words.push_back(std::to_string(i * 3));
+    }
+    std::sort(words.begin(), words.end());
+    s.addSorted(words.begin(), words.end());
+
+    std::vector<std::string> queries;
+    for (int i = 0; i < 9000; ++i)
+    {
+        queries.push_back(std::to_string(i));
+    }
+    std::sort(queries.begin(), queries.end());
+
+    SkipListSet<std::string>::Finger finger;
+    for (const std::string& query : queries)
+    {
+        ASSERT_EQ(s.contains(query), s.contains(query, finger)) << query;
+    }
+
+    // Going backwards just starts over from the top.
+    EXPECT_TRUE(s.contains("0", finger));
+    EXPECT_FALSE(s.contains("1", finger));
+}
@@ -0,0 +1,100 @@
+// SkipListSet_RangeTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the ordered queries on SkipListSet: iteration,
+// lowerBound(), range(), prefixRange() and forEachWithPrefix().
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    SkipListSet<std::string> makeWords()
+    {
+        SkipListSet<std::string> s;
+        for (const char* word : {"CAT", "CAR", "CART", "CARD", "DOG", "COT", "BAT", "CA", "CARE"})
+        {
+            s.add(word);
+        }
+        return s;
+    }
+
+
+    template <typename Range>
+    std::vector<std::string> collect(const Range& r)
+    {
+        return std::vector<std::string>(r.begin(), r.end());
+    }
+}
+
+
+TEST(SkipListSet_RangeTests, iteratesInAscendingOrder)
+{
+    SkipListSet<int> s;
+    for (int i : {50, 20, 80, 10, 30, 70, 90, 60, 20})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> elements(s.begin(), s.end());
+    std::vector<int> expected{10, 20, 30, 50, 60, 70, 80, 90};
+    EXPECT_EQ(expected, elements);
+}
+
+
+TEST(SkipListSet_RangeTests, lowerBoundFindsSmallestNotLess)
+{
+    SkipListSet<int> s;
+    for (int i = 0; i < 1000; i += 10)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(300, *s.lowerBound(300));
+    EXPECT_EQ(310, *s.lowerBound(301));
+    EXPECT_EQ(0, *s.lowerBound(-5));
+    EXPECT_TRUE(s.lowerBound(991) == s.end());
+}
+
+
+TEST(SkipListSet_RangeTests, rangeIsHalfOpen)
+{
+    SkipListSet<int> s;
+    for (int i = 1; i <= 10; ++i)
+    {
+        s.add(i);
+    }
+
+    std::vector<int> elements;
+    for (int i : s.range(3, 7))
+    {
+        elements.push_back(i);
+    }
+
+    std::vector<int> expected{3, 4, 5, 6};
+    EXPECT_EQ(expected, elements);
+    EXPECT_TRUE(s.range(7, 3).empty());
+    EXPECT_TRUE(s.range(11, 20).empty());
+}
+
+
+TEST(SkipListSet_RangeTests, prefixRangeYieldsOnlyMatchingWords)
+{
+    SkipListSet<std::string> s = makeWords();
+
+    std::vector<std::string> expected{"CAR", "CARD", "CARE", "CART"};
+    EXPECT_EQ(expected, collect(s.prefixRange("CAR")));
+    EXPECT_TRUE(s.prefixRange("CX").empty());
+    EXPECT_EQ(s.size(), collect(s.prefixRange("")).size());
+
+    std::vector<std::string> visited;
+    s.forEachWithPrefix("CA", [&](const std::string& word) { visited.push_back(word); });
+    EXPECT_EQ(collect(s.prefixRange("CA")), visited);
+    EXPECT_EQ(6, visited.size());
+}
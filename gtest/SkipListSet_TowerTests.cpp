@@ -0,0 +1,230 @@
+// SkipListSet_TowerTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the layout of SkipListSet's towers, using a level tester
+// whose decisions are known in advance.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // Gives each integer a tower one level taller than the number of
+    // trailing zero bits in it, so that 8 occupies levels 0 through 3.
+    class TrailingZerosLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        virtual bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element != last)
+            {
+                last = element;
+                occupied = 1;
+            }
+
+            return element != 0 && (element & ((1 << occupied++) - 1)) == 0;
+        }
+
+        virtual std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<TrailingZerosLevelTester>();
+        }
+
+    private:
+        int last = -1;
+        int occupied = 1;
+    };
+
+
+    SkipListSet<int> makeSet(int count)
+    {
+        SkipListSet<int> s{std::make_unique<TrailingZerosLevelTester>()};
+        for (int i = 1; i <= count; ++i)
+        {
+            s.add(i);
+        }
+        return s;
+    }
+}
+
+
+TEST(SkipListSet_TowerTests, towersFollowLevelTester)
+{
+    SkipListSet<int> s = makeSet(16);
+
+    EXPECT_EQ(5, s.levelCount());
+    EXPECT_EQ(16, s.elementsOnLevel(0));
+    EXPECT_EQ(8, s.elementsOnLevel(1));
+    EXPECT_EQ(4, s.elementsOnLevel(2));
+    EXPECT_EQ(2, s.elementsOnLevel(3));
+    EXPECT_EQ(1, s.elementsOnLevel(4));
+    EXPECT_EQ(0, s.elementsOnLevel(5));
+
+    EXPECT_TRUE(s.isElementOnLevel(8, 3));
+    EXPECT_FALSE(s.isElementOnLevel(8, 4));
+    EXPECT_TRUE(s.isElementOnLevel(16, 4));
+    EXPECT_FALSE(s.isElementOnLevel(17, 0));
+}
+
+
+TEST(SkipListSet_TowerTests, emptySkipListHasOneLevel)
+{
+    SkipListSet<std::string> s;
+
+    EXPECT_EQ(1, s.levelCount());
+    EXPECT_EQ(0, s.elementsOnLevel(0));
+    EXPECT_FALSE(s.contains("A"));
+}
+
+
+TEST(SkipListSet_TowerTests, addingDuplicatesHasNoEffect)
+{
+    SkipListSet<int> s = makeSet(16);
+    for (int i = 1; i <= 16; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(16, s.size());
+    EXPECT_EQ(16, s.elementsOnLevel(0));
+}
+
+
+TEST(SkipListSet_TowerTests, copiesKeepTheSameLayout)
+{
+    SkipListSet<int> s = makeSet(40);
+    SkipListSet<int> copy{s};
+    SkipListSet<int> assigned;
+    assigned = s;
+
+    for (const SkipListSet<int>* t : {&copy, &assigned})
+    {
+        ASSERT_EQ(s.levelCount(), t->levelCount());
+        for (unsigned int level = 0; level < s.levelCount(); ++level)
+        {
+            EXPECT_EQ(s.elementsOnLevel(level), t->elementsOnLevel(level));
+        }
+        EXPECT_TRUE(t->isElementOnLevel(32, 5));
+    }
+
+    SkipListSet<int> moved{std::move(copy)};
+    EXPECT_EQ(40, moved.size());
+    EXPECT_EQ(0, copy.size());
+    copy.add(1);
+    EXPECT_TRUE(copy.contains(1));
+}
+
+
+TEST(SkipListSet_TowerTests, containsEveryStringAdded)
+{
+    std::vector<std::string> words;
+    std::mt19937 engine{46};
+    std::uniform_int_distribution<int> letter{'A', 'Z'};
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string word;
+        for (int j = 0; j < 1 + i % 12; ++j)
+        {
+            word += static_cast<char>(letter(engine));
+        }
+        words.push_back(word);
+    }
+
+    SkipListSet<std::string> s;
+    for (const std::string& word : words)
+    {
+        s.add(word);
+    }
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    EXPECT_EQ(words.size(), s.size());
+    EXPECT_EQ(words.size(), s.elementsOnLevel(0));
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(word));
+        EXPECT_FALSE(s.contains(word + "#"));
+    }
+}
+
+
+TEST(SkipListSet_TowerTests, fastRandomTesterIsReproducibleFromSeed)
+{
+    FastRandomSkipListLevelTester<int> a{46};
+    FastRandomSkipListLevelTester<int> b{46};
+    std::unique_ptr<SkipListLevelTester<int>> aClone = a.clone();
+    std::unique_ptr<SkipListLevelTester<int>> bClone = b.clone();
+
+    unsigned int tallest = 0;
+    unsigned int total = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        unsigned int height = a.towerHeight(i, 32);
+        ASSERT_EQ(height, b.towerHeight(i, 32));
+
+        unsigned int capped = a.towerHeight(i, 3);
+        ASSERT_EQ(capped, b.towerHeight(i, 3));
+        ASSERT_LE(capped, 3);
+        ASSERT_EQ(aClone->towerHeight(i, 32), bClone->towerHeight(i, 32));
+        ASSERT_GE(height, 1);
+        ASSERT_LE(height, 32);
+        tallest = std::max(tallest, height);
+        total += height;
+    }
+
+    // Heights are geometric with p = 1/2, so they average about 2.
+    EXPECT_NEAR(2.0, total / 10000.0, 0.1);
+    EXPECT_GE(tallest, 8);
+}
+
+
+TEST(SkipListSet_TowerTests, hashTesterGivesSameLayoutInAnyOrder)
+{
+    SkipListSet<std::string> forward{std::make_unique<HashSkipListLevelTester<std::string>>(7)};
+    SkipListSet<std::string> backward{std::make_unique<HashSkipListLevelTester<std::string>>(7)};
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        forward.add(std::to_string(i));
+        backward.add(std::to_string(1999 - i));
+    }
+
+    ASSERT_EQ(forward.levelCount(), backward.levelCount());
+    for (unsigned int level = 0; level < forward.levelCount(); ++level)
+    {
+        EXPECT_EQ(forward.elementsOnLevel(level), backward.elementsOnLevel(level));
+    }
+    for (int i = 0; i < 2000; i += 37)
+    {
+        for (unsigned int level = 0; level < forward.levelCount(); ++level)
+        {
+            std::string word = std::to_string(i);
+            EXPECT_EQ(forward.isElementOnLevel(word, level), backward.isElementOnLevel(word, level));
+        }
+    }
+}
+
+
+TEST(SkipListSet_TowerTests, hashTesterCoinFlipsMatchTowerHeight)
+{
+    HashSkipListLevelTester<int> tester{3};
+
+    for (int i = 0; i < 200; ++i)
+    {
+        unsigned int height = 1;
+        while (height < 32 && tester.shouldOccupyNextLevel(i))
+        {
+            ++height;
+        }
+        EXPECT_EQ(tester.towerHeight(i, 32), height);
+    }
+}
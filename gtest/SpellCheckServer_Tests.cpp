@@ -0,0 +1,333 @@
+// SpellCheckServer_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SpellCheckServer and SpellCheckClient, with the server
+// running on a thread of the test and clients connecting to it over a
+// socket in the temporary directory.
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "HashSet.hpp"
+#include "SpellCheckClient.hpp"
+#include "SpellCheckServer.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    std::string temporarySocket(const std::string& name)
+    {
+        return ::testing::TempDir() + "SpellCheckServer_Tests_" + name + ".sock";
+    }
+
+
+    // A RunningServer runs a SpellCheckServer on a thread of its own for
+    // as long as it exists.
+    class RunningServer
+    {
+    public:
+        explicit RunningServer(
+            const std::string& name, unsigned int workers = 2,
+            const WordFrequencies* frequencies = nullptr)
+            : words{makeWords()},
+              checker{frequencies != nullptr ? WordChecker{words, *frequencies} : WordChecker{words}},
+              server{checker, temporarySocket(name), workers},
+              thread{[this] { server.run(); }}
+        {
+        }
+
+        ~RunningServer()
+        {
+            server.stop();
+            thread.join();
+        }
+
+        const std::string& path() const
+        {
+            return server.socketPath();
+        }
+
+    private:
+        HashSet<std::string> words;
+        WordChecker checker;
+        SpellCheckServer server;
+        std::thread thread;
+
+        static HashSet<std::string> makeWords()
+        {
+            HashSet<std::string> words{stringHash};
+            for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT", "DON'T", "CAF\xc3\x89"})
+            {
+                words.add(word);
+            }
+            return words;
+        }
+    };
+
+
+    // sendRaw() sends the given bytes on a new connection, closes the
+    // sending side, and returns everything the server sends back.
+    std::string sendRaw(const std::string& path, const std::string& bytes)
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+        EXPECT_EQ(0, ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)));
+
+        EXPECT_EQ(static_cast<ssize_t>(bytes.size()), ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL));
+        ::shutdown(fd, SHUT_WR);
+
+        std::string received;
+        char buffer[4096];
+        for (ssize_t count; (count = ::recv(fd, buffer, sizeof(buffer), 0)) > 0; )
+        {
+            received.append(buffer, static_cast<std::size_t>(count));
+        }
+
+        ::close(fd);
+        return received;
+    }
+}
+
+
+TEST(SpellCheckServer_Tests, checksWords)
+{
+    RunningServer server{"check"};
+    SpellCheckClient client{server.path()};
+
+    EXPECT_TRUE(client.check("CAT"));
+    EXPECT_TRUE(client.check("cat"));
+    EXPECT_TRUE(client.check("Don't"));
+    EXPECT_FALSE(client.check("CAAT"));
+    EXPECT_EQ("OK the", client.request("CHECK the"));
+    EXPECT_EQ("MISSPELLED teh", client.request("CHECK teh"));
+}
+
+
+TEST(SpellCheckServer_Tests, wordsOutsideAsciiAreCheckedInUpperCase)
+{
+    RunningServer server{"accented"};
+    SpellCheckClient client{server.path()};
+
+    EXPECT_TRUE(client.check("CAF\xc3\x89"));
+    EXPECT_TRUE(client.check("caf\xc3\xa9"));
+    EXPECT_TRUE(client.check("Caf\xc3\xa9"));
+    EXPECT_FALSE(client.check("cafe"));
+    EXPECT_EQ("SUGGESTIONS caf\xc3\xa9s CAF\xc3\x89", client.request("SUGGEST caf\xc3\xa9s"));
+}
+
+
+TEST(SpellCheckServer_Tests, suggestsWordsOnce)
+{
+    RunningServer server{"suggest"};
+    SpellCheckClient client{server.path()};
+
+    EXPECT_EQ(std::vector<std::string>{"CAT"}, client.suggest("CAAT"));
+    EXPECT_EQ(std::vector<std::string>{"SAT"}, client.suggest("satt"));
+    EXPECT_EQ("SUGGESTIONS xyzzy", client.request("SUGGEST xyzzy"));
+}
+
+
+TEST(SpellCheckServer_Tests, suggestionsAreRankedWhenThereAreFrequencies)
+{
+    WordFrequencies frequencies;
+    frequencies.add("MAT", 1000);
+    frequencies.add("SAT", 100);
+    frequencies.add("CAT", 10);
+
+    RunningServer unranked{"unranked"};
+    RunningServer ranked{"ranked", 2, &frequencies};
+
+    EXPECT_EQ("SUGGESTIONS xat CAT MAT SAT", SpellCheckClient{unranked.path()}.request("SUGGEST xat"));
+    EXPECT_EQ("SUGGESTIONS xat MAT SAT CAT", SpellCheckClient{ranked.path()}.request("SUGGEST xat"));
+}
+
+
+TEST(SpellCheckServer_Tests, malformedRequestsAreAnsweredWithErrors)
+{
+    RunningServer server{"malformed"};
+    SpellCheckClient client{server.path()};
+
+    EXPECT_EQ("ERROR unknown command", client.request("SPELL CAT"));
+    EXPECT_EQ("ERROR expected a command and one word", client.request("CHECK"));
+    EXPECT_EQ("ERROR expected a command and one word", client.request("CHECK TWO WORDS"));
+    EXPECT_TRUE(client.check("CAT"));
+}
+
+
+TEST(SpellCheckServer_Tests, pipelinedResponsesComeBackInOrder)
+{
+    RunningServer server{"pipelined", 4};
+    SpellCheckClient client{server.path()};
+
+    std::vector<std::string> requests;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 3000; ++i)
+    {
+        switch (i % 3)
+        {
+        case 0:
+            requests.push_back("SUGGEST CAAT");
+            expected.push_back("SUGGESTIONS CAAT CAT");
+            break;
+        case 1:
+            requests.push_back("CHECK MAT");
+            expected.push_back("OK MAT");
+            break;
+        default:
+            requests.push_back("SUGGEST TEH" + std::to_string(i));
+            expected.push_back("SUGGESTIONS TEH" + std::to_string(i));
+            break;
+        }
+    }
+
+    EXPECT_EQ(expected, client.requestMany(requests));
+}
+
+
+TEST(SpellCheckServer_Tests, manyClientsCanBeServedAtOnce)
+{
+    RunningServer server{"many"};
+
+    std::vector<std::thread> clients;
+    std::vector<int> failures(8, 0);
+
+    for (int c = 0; c < 8; ++c)
+    {
+        clients.emplace_back([&server, &failures, c] {
+            SpellCheckClient client{server.path()};
+            for (int i = 0; i < 200; ++i)
+            {
+                bool ok = client.check("CAT") && !client.check("CAAT")
+                    && client.suggest("MATT") == std::vector<std::string>{"MAT"};
+                failures[c] += ok ? 0 : 1;
+            }
+        });
+    }
+
+    for (std::thread& client : clients)
+    {
+        client.join();
+    }
+
+    EXPECT_EQ(std::vector<int>(8, 0), failures);
+}
+
+
+TEST(SpellCheckServer_Tests, responsesAreSentAfterTheClientStopsSending)
+{
+    RunningServer server{"halfclosed"};
+
+    EXPECT_EQ(
+        "SUGGESTIONS CAAT CAT\nOK CAT\n",
+        sendRaw(server.path(), "SUGGEST CAAT\r\nCHECK CAT\n"));
+}
+
+
+TEST(SpellCheckServer_Tests, aLastRequestWithoutANewlineIsAnswered)
+{
+    RunningServer server{"unterminated"};
+
+    EXPECT_EQ("MISSPELLED FOO\n", sendRaw(server.path(), "CHECK FOO"));
+    EXPECT_EQ("OK CAT\nSUGGESTIONS CAAT CAT\n", sendRaw(server.path(), "CHECK CAT\nSUGGEST CAAT\r"));
+}
+
+
+TEST(SpellCheckServer_Tests, overlongRequestsCloseTheConnection)
+{
+    RunningServer server{"overlong"};
+
+    std::string request = "CHECK " + std::string(SpellCheckServer::MAX_REQUEST_LENGTH * 2, 'A');
+    EXPECT_EQ("OK CAT\nERROR request too long\n", sendRaw(server.path(), "CHECK CAT\n" + request));
+
+    SpellCheckClient client{server.path()};
+    EXPECT_TRUE(client.check("CAT"));
+}
+
+
+TEST(SpellCheckServer_Tests, staleSocketsAreReplacedButLiveOnesAreNot)
+{
+    std::string path = temporarySocket("stale");
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+        ::unlink(path.c_str());
+        ASSERT_EQ(0, ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)));
+        ::close(fd);
+    }
+
+    RunningServer server{"stale"};
+    SpellCheckClient client{server.path()};
+    EXPECT_TRUE(client.check("CAT"));
+
+    HashSet<std::string> words{stringHash};
+    WordChecker checker{words};
+    EXPECT_THROW((SpellCheckServer{checker, path}), SpellCheckServer::ServerException);
+}
+
+
+TEST(SpellCheckServer_Tests, otherFilesAreNeverReplaced)
+{
+    std::string path = temporarySocket("notes");
+    {
+        std::ofstream out{path};
+        out << "Not a socket\n";
+    }
+
+    HashSet<std::string> words{stringHash};
+    WordChecker checker{words};
+    EXPECT_THROW((SpellCheckServer{checker, path}), SpellCheckServer::ServerException);
+
+    std::ifstream in{path};
+    std::string line;
+    EXPECT_TRUE(std::getline(in, line));
+    EXPECT_EQ("Not a socket", line);
+
+    ::unlink(path.c_str());
+}
+
+
+TEST(SpellCheckServer_Tests, connectingToNoServerFails)
+{
+    EXPECT_THROW(SpellCheckClient{temporarySocket("nobody")}, SpellCheckClient::ClientException);
+}
+
+
+TEST(SpellCheckServer_Tests, roundTripsAreFast)
+{
+    RunningServer server{"fast"};
+    SpellCheckClient client{server.path()};
+    client.check("CAT");
+
+    constexpr int COUNT = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        client.check("CAT");
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Generous, so as not to fail on a loaded machine or under sanitizers,
+    // but still far below what reloading a dictionary would cost.
+    EXPECT_LT(elapsed.count() / COUNT, 5000.0);
+}
@@ -0,0 +1,183 @@
+// StringPool_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for StringPool and for PooledStringSet, which stores Handles
+// from a StringPool in another kind of set.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "PooledStringSet.hpp"
+#include "StringPool.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back("word" + std::to_string(i * 7919));
+        }
+        return words;
+    }
+}
+
+
+TEST(StringPool_Tests, internedStringsCanBeViewed)
+{
+    StringPool pool;
+    StringPool::Handle boo = pool.intern("Boo");
+    StringPool::Handle empty = pool.intern("");
+
+    EXPECT_EQ("Boo", pool.view(boo));
+    EXPECT_EQ("", pool.view(empty));
+    EXPECT_EQ(2, pool.size());
+}
+
+
+TEST(StringPool_Tests, equalStringsShareOneHandle)
+{
+    StringPool pool;
+    StringPool::Handle first = pool.intern("happy");
+    std::size_t used = pool.bytesUsed();
+
+    StringPool::Handle second = pool.intern(std::string{"hap"} + "py");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, pool.size());
+    EXPECT_EQ(used, pool.bytesUsed());
+}
+
+
+TEST(StringPool_Tests, findDoesNotIntern)
+{
+    StringPool pool;
+    StringPool::Handle boo = pool.intern("Boo");
+    StringPool::Handle found = StringPool::NO_HANDLE;
+
+    EXPECT_TRUE(pool.find("Boo", found));
+    EXPECT_EQ(boo, found);
+    EXPECT_FALSE(pool.find("Alex", found));
+    EXPECT_EQ(1, pool.size());
+}
+
+
+TEST(StringPool_Tests, viewsStayValidAsThePoolGrows)
+{
+    StringPool pool;
+    std::vector<std::string> words = makeWords(200000);
+
+    std::string_view first = pool.view(pool.intern(words[0]));
+    std::vector<StringPool::Handle> handles;
+    for (const std::string& word : words)
+    {
+        handles.push_back(pool.intern(word));
+    }
+
+    EXPECT_EQ(words[0], first);
+    EXPECT_GT(pool.bytesAllocated(), StringPool::CHUNK_SIZE);
+    for (unsigned int i = 0; i < words.size(); ++i)
+    {
+        ASSERT_EQ(words[i], pool.view(handles[i]));
+    }
+}
+
+
+TEST(StringPool_Tests, stringsTakeLittleMoreThanTheirLength)
+{
+    StringPool pool;
+    std::vector<std::string> words = makeWords(100000);
+    std::size_t rawBytes = 0;
+
+    for (const std::string& word : words)
+    {
+        pool.intern(word);
+        rawBytes += word.size();
+    }
+
+    EXPECT_EQ(rawBytes + words.size(), pool.bytesUsed());
+    EXPECT_LT(pool.bytesAllocated(), pool.bytesUsed() + StringPool::CHUNK_SIZE);
+}
+
+
+TEST(StringPool_Tests, stringsLongerThanAChunkGetTheirOwn)
+{
+    StringPool pool;
+    std::string longString(StringPool::CHUNK_SIZE + 10, 'x');
+
+    StringPool::Handle before = pool.intern("before");
+    StringPool::Handle big = pool.intern(longString);
+    StringPool::Handle after = pool.intern("after");
+
+    EXPECT_EQ("before", pool.view(before));
+    EXPECT_EQ(longString, pool.view(big));
+    EXPECT_EQ("after", pool.view(after));
+}
+
+
+TEST(StringPool_Tests, movedPoolKeepsItsStrings)
+{
+    StringPool pool;
+    StringPool::Handle boo = pool.intern("Boo");
+    std::string_view view = pool.view(boo);
+
+    StringPool moved{std::move(pool)};
+
+    EXPECT_EQ("Boo", moved.view(boo));
+    EXPECT_EQ("Boo", view);
+    EXPECT_EQ(0, pool.size());
+}
+
+
+TEST(StringPool_Tests, pooledHashSetAnswersLikeAStringSet)
+{
+    StringPool pool;
+    PooledStringSet<HashSet<StringPool::Handle>> s{
+        pool, HashSet<StringPool::Handle>{StringPool::hashHandle}};
+    Set<std::string>& set = s;
+
+    set.add("Boo");
+    set.add("is");
+    set.add("Boo");
+
+    EXPECT_TRUE(set.isImplemented());
+    EXPECT_EQ(2, set.size());
+    EXPECT_TRUE(set.contains("Boo"));
+    EXPECT_TRUE(set.contains("is"));
+    EXPECT_FALSE(set.contains("happy"));
+}
+
+
+TEST(StringPool_Tests, setsSharingAPoolStoreEachStringOnce)
+{
+    StringPool pool;
+    PooledStringSet<HashSet<StringPool::Handle>> hashed{
+        pool, HashSet<StringPool::Handle>{StringPool::hashHandle}};
+    PooledStringSet<AVLSet<StringPool::Handle>> balanced{pool};
+
+    std::vector<std::string> words = makeWords(1000);
+    for (const std::string& word : words)
+    {
+        hashed.add(word);
+        balanced.add(word);
+    }
+    balanced.add("only in one");
+
+    EXPECT_EQ(1001, pool.size());
+    EXPECT_EQ(1000, hashed.size());
+    EXPECT_EQ(1001, balanced.size());
+    EXPECT_FALSE(hashed.contains("only in one"));
+    EXPECT_TRUE(balanced.contains("only in one"));
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(hashed.contains(word));
+        ASSERT_TRUE(balanced.contains(word));
+    }
+}
@@ -0,0 +1,126 @@
+// Utf8_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for finding UTF-8 characters, folding them to upper case, and
+// the Alphabets built from them.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Alphabet.hpp"
+#include "Utf8.hpp"
+
+
+TEST(Utf8_Tests, sequencesAreOneToFourBytesLong)
+{
+    EXPECT_EQ(1u, Utf8::sequenceLength("A", 0));
+    EXPECT_EQ(2u, Utf8::sequenceLength("\xC3\x9C", 0));
+    EXPECT_EQ(3u, Utf8::sequenceLength("\xE2\x82\xAC", 0));
+    EXPECT_EQ(4u, Utf8::sequenceLength("\xF0\x9F\x98\x80", 0));
+
+    EXPECT_EQ(4u, Utf8::length("M\xC3\x9C" "DE"));
+    EXPECT_EQ(0u, Utf8::length(""));
+}
+
+
+TEST(Utf8_Tests, malformedBytesAreCharactersByThemselves)
+{
+    // A stray continuation byte, a sequence cut short, an overlong form,
+    // a surrogate, and a byte that never begins a sequence.
+    for (const char* text : {"\x80", "\xC3", "\xE2\x82", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xFF"})
+    {
+        EXPECT_EQ(1u, Utf8::sequenceLength(text, 0)) << text;
+    }
+
+    EXPECT_EQ(3u, Utf8::length("\xC3" "AB"));
+}
+
+
+TEST(Utf8_Tests, asciiIsFoldedToUpperCase)
+{
+    EXPECT_EQ("HELLO, WORLD", Utf8::toUpper("Hello, world"));
+    EXPECT_EQ("", Utf8::toUpper(""));
+
+    // Long enough to be folded 16 bytes at a time, with every ASCII
+    // character in it.
+    std::string all;
+    std::string expected;
+    for (int c = 0; c < 128; ++c)
+    {
+        all += static_cast<char>(c);
+        expected += static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+    }
+    EXPECT_EQ(expected, Utf8::toUpper(all));
+}
+
+
+TEST(Utf8_Tests, lettersBeyondAsciiAreFoldedToUpperCase)
+{
+    EXPECT_EQ("M\xC3\x9C" "DE", Utf8::toUpper("m\xC3\xBC" "de"));                   // müde
+    EXPECT_EQ("\xC3\x89L\xC3\x88VE", Utf8::toUpper("\xC3\xA9l\xC3\xA8ve"));          // élève
+    EXPECT_EQ("\xC5\x81\xC3\x93" "D\xC5\xB9", Utf8::toUpper("\xC5\x82\xC3\xB3" "d\xC5\xBA")); // łódź
+    EXPECT_EQ("\xCE\xA3\xCE\xA3", Utf8::toUpper("\xCF\x83\xCF\x82"));               // σς
+    EXPECT_EQ("\xD0\x81\xD0\x96", Utf8::toUpper("\xD1\x91\xD0\xB6"));               // ёж
+    EXPECT_EQ("\xC5\xB8", Utf8::toUpper("\xC3\xBF"));                               // ÿ
+    EXPECT_EQ("I", Utf8::toUpper("\xC4\xB1"));                                      // dotless ı
+
+    // 'ß' and the division sign have no single upper-case character.
+    EXPECT_EQ("STRA\xC3\x9F" "E", Utf8::toUpper("stra\xC3\x9F" "e"));
+    EXPECT_EQ("\xC3\xB7", Utf8::toUpper("\xC3\xB7"));
+}
+
+
+TEST(Utf8_Tests, foldingContinuesPastTheAsciiFastPath)
+{
+    std::string text = "abcdefghijklmnopqrstuvwxyz \xC3\xA9t\xC3\xA9 and more ascii after it";
+    Utf8::foldToUpper(text);
+
+    EXPECT_EQ("ABCDEFGHIJKLMNOPQRSTUVWXYZ \xC3\x89T\xC3\x89 AND MORE ASCII AFTER IT", text);
+}
+
+
+TEST(Utf8_Tests, foldingLeavesOtherCharactersAlone)
+{
+    EXPECT_EQ("\xE2\x82\xAC" "5", Utf8::toUpper("\xE2\x82\xAC" "5"));
+    EXPECT_EQ("\xF0\x9F\x98\x80", Utf8::toUpper("\xF0\x9F\x98\x80"));
+    EXPECT_EQ("A\x80" "B\xC3", Utf8::toUpper("a\x80" "b\xC3"));
+}
+
+
+TEST(Utf8_Tests, upperCaseTextIsRecognized)
+{
+    EXPECT_TRUE(Utf8::isUpper("HELLO"));
+    EXPECT_TRUE(Utf8::isUpper("M\xC3\x9C" "DE"));
+    EXPECT_TRUE(Utf8::isUpper(""));
+    EXPECT_FALSE(Utf8::isUpper("HELLo"));
+    EXPECT_FALSE(Utf8::isUpper("M\xC3\xBC" "DE"));
+}
+
+
+TEST(Utf8_Tests, theEnglishAlphabetIsAThroughZ)
+{
+    const Alphabet& english = Alphabet::english();
+
+    ASSERT_EQ(26u, english.size());
+    EXPECT_EQ("A", english.letters().front());
+    EXPECT_EQ("Z", english.letters().back());
+    EXPECT_EQ(std::vector<std::string>{"Q"}, english.startingWith('Q'));
+    EXPECT_TRUE(english.startingWith('\'').empty());
+}
+
+
+TEST(Utf8_Tests, alphabetsHoldTheCharactersOfTheirWords)
+{
+    Alphabet alphabet{std::vector<std::string>{"m\xC3\xBC" "de", "M\xC3\x9C" "HE", "don't", "two words"}};
+
+    std::vector<std::string> expected{
+        "'", "D", "E", "H", "M", "N", "O", "R", "S", "T", "W", "\xC3\x9C"};
+    EXPECT_EQ(expected, alphabet.letters());
+
+    EXPECT_EQ(std::vector<std::string>{"\xC3\x9C"}, alphabet.startingWith('\xC3'));
+    EXPECT_TRUE(alphabet.contains("\xC3\x9C"));
+    EXPECT_FALSE(alphabet.contains("\xC3\xBC"));
+    EXPECT_FALSE(alphabet.contains(" "));
+}
@@ -0,0 +1,256 @@
+// WordChecker_AsyncTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordChecker::suggestAsync() and the Task and
+// TaskScheduler it's built on.  These only exist in builds with coroutine
+// support.
+
+#include "WordChecker.hpp"
+
+#ifdef ICS46_HAS_COROUTINES
+
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CoroutineTask.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const char* word : {"THE", "CAT", "SAT", "ON", "MAT", "CATS", "AT", "ACT", "CART"})
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    Task<int> countTo(int n, std::vector<int>& log)
+    {
+        for (int i = 1; i <= n; ++i)
+        {
+            log.push_back(i);
+            co_await yieldNow();
+        }
+        co_return n;
+    }
+
+
+    Task<int> throwAfterYielding()
+    {
+        co_await yieldNow();
+        throw std::runtime_error{"thrown"};
+        co_return 0;
+    }
+}
+
+
+TEST(WordChecker_AsyncTests, suggestionsMatchFindSuggestions)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    for (const char* word : {"CTA", "CAAT", "CTAS", "THECAT", "XYZZY", "C", ""})
+    {
+        Task<SuggestionResult> task = checker.suggestAsync(word);
+        while (!task.done())
+        {
+            task.resume();
+        }
+
+        EXPECT_TRUE(task.result().complete);
+        EXPECT_EQ(checker.findSuggestions(word), task.result().words);
+    }
+}
+
+
+TEST(WordChecker_AsyncTests, yieldsBetweenEachFamilyOfEdits)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    Task<SuggestionResult> task = checker.suggestAsync("CTA");
+
+    int resumes = 0;
+    while (!task.done())
+    {
+        task.resume();
+        ++resumes;
+    }
+
+    EXPECT_EQ(5, resumes);
+}
+
+
+TEST(WordChecker_AsyncTests, tasksDoNothingUntilResumed)
+{
+    std::vector<int> log;
+    Task<int> task = countTo(3, log);
+
+    EXPECT_FALSE(task.done());
+    EXPECT_TRUE(log.empty());
+}
+
+
+TEST(WordChecker_AsyncTests, passedDeadlinesGiveIncompleteResults)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    Task<SuggestionResult> task = checker.suggestAsync("CTA", std::chrono::steady_clock::now());
+    task.resume();
+
+    ASSERT_TRUE(task.done());
+    EXPECT_FALSE(task.result().complete);
+    EXPECT_TRUE(task.result().words.empty());
+}
+
+
+TEST(WordChecker_AsyncTests, deadlinesPassingPartwayKeepPartialResults)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+    Task<SuggestionResult> task = checker.suggestAsync("CTA", deadline);
+
+    // The swaps are tried before the first yield; the deadline passes
+    // before the task is resumed again.
+    task.resume();
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+    }
+    task.resume();
+
+    ASSERT_TRUE(task.done());
+    EXPECT_FALSE(task.result().complete);
+    EXPECT_EQ(std::vector<std::string>{"CAT"}, task.result().words);
+}
+
+
+TEST(WordChecker_AsyncTests, schedulerInterleavesTasks)
+{
+    std::vector<int> log;
+    Task<int> first = countTo(3, log);
+    Task<int> second = countTo(2, log);
+
+    TaskScheduler scheduler;
+    scheduler.schedule(first);
+    scheduler.schedule(second);
+
+    EXPECT_EQ(2u, scheduler.runOnce());
+    EXPECT_EQ((std::vector<int>{1, 1}), log);
+
+    scheduler.run();
+    EXPECT_EQ((std::vector<int>{1, 1, 2, 2, 3}), log);
+    EXPECT_EQ(3, first.result());
+    EXPECT_EQ(2, second.result());
+}
+
+
+TEST(WordChecker_AsyncTests, schedulerRunsManySuggestionRequests)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    std::vector<std::string> requests{"CTA", "TEH", "MTA", "CAATS", "ONN", "SATMAT"};
+    std::vector<Task<SuggestionResult>> tasks;
+    TaskScheduler scheduler;
+
+    for (const std::string& request : requests)
+    {
+        tasks.push_back(checker.suggestAsync(request));
+    }
+    for (Task<SuggestionResult>& task : tasks)
+    {
+        scheduler.schedule(task);
+    }
+
+    scheduler.run();
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        ASSERT_TRUE(tasks[i].done());
+        EXPECT_TRUE(tasks[i].result().complete);
+        EXPECT_EQ(checker.findSuggestions(requests[i]), tasks[i].result().words);
+    }
+}
+
+
+TEST(WordChecker_AsyncTests, awaitedTasksYieldThroughTheirAwaiter)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    std::vector<int> log;
+
+    auto parent = [&]() -> Task<std::size_t> {
+        int counted = co_await countTo(2, log);
+        SuggestionResult result = co_await checker.suggestAsync("CTA");
+        co_return counted + result.words.size();
+    };
+
+    Task<std::size_t> task = parent();
+
+    int resumes = 0;
+    while (!task.done())
+    {
+        task.resume();
+        ++resumes;
+    }
+
+    EXPECT_EQ((std::vector<int>{1, 2}), log);
+    EXPECT_EQ(2u + checker.findSuggestions("CTA").size(), task.result());
+
+    // Two yields while counting, then four between the edit families, so
+    // seven resumes in all.
+    EXPECT_EQ(7, resumes);
+}
+
+
+TEST(WordChecker_AsyncTests, exceptionsPropagateToAwaiters)
+{
+    auto parent = []() -> Task<bool> {
+        try
+        {
+            co_await throwAfterYielding();
+        }
+        catch (std::runtime_error&)
+        {
+            co_return true;
+        }
+        co_return false;
+    };
+
+    Task<bool> task = parent();
+    TaskScheduler scheduler;
+    scheduler.schedule(task);
+    scheduler.run();
+
+    EXPECT_TRUE(task.result());
+
+    Task<int> thrower = throwAfterYielding();
+    while (!thrower.done())
+    {
+        thrower.resume();
+    }
+    EXPECT_THROW(thrower.result(), std::runtime_error);
+}
+
+
+#endif // ICS46_HAS_COROUTINES
@@ -0,0 +1,211 @@
+// WordChecker_Distance2Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for findDistance2Suggestions(), which are checked against
+// applying every edit to every single edit of each query.
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "PrefixFilter.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    const std::vector<std::string> dictionary{
+        "THE", "CAT", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "CATS", "SCAT",
+        "ACT", "CUT", "COT", "BAT", "HAT", "MAT", "SAT", "CAB", "CAN", "CAP", "CAR",
+        "RHYTHM", "RHYTHMS", "RATHER", "ELEPHANT", "RELEVANT", "BECAUSE", "BEACH", "DON'T"};
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const std::string& word : dictionary)
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    // edits() returns every string one swap, deletion, replacement or
+    // insertion (of a letter from 'A' through 'Z') away from the given one.
+    std::set<std::string> edits(const std::string& s)
+    {
+        std::set<std::string> result;
+
+        for (std::size_t i = 0; i <= s.size(); ++i)
+        {
+            if (i + 1 < s.size())
+            {
+                std::string swapped = s;
+                std::swap(swapped[i], swapped[i + 1]);
+                result.insert(swapped);
+            }
+            if (i < s.size())
+            {
+                result.insert(s.substr(0, i) + s.substr(i + 1));
+            }
+            for (char letter = 'A'; letter <= 'Z'; ++letter)
+            {
+                if (i < s.size())
+                {
+                    std::string replaced = s;
+                    replaced[i] = letter;
+                    result.insert(replaced);
+                }
+                result.insert(s.substr(0, i) + letter + s.substr(i));
+            }
+        }
+
+        result.erase(s);
+        return result;
+    }
+
+
+    // withinTwoEdits() returns the words in the dictionary one or two
+    // edits away from the given word, the slow way.
+    std::vector<std::string> withinTwoEdits(const std::string& word)
+    {
+        std::set<std::string> reachable = edits(word);
+        for (const std::string& edit : edits(word))
+        {
+            std::set<std::string> more = edits(edit);
+            reachable.insert(more.begin(), more.end());
+        }
+
+        std::vector<std::string> found;
+        for (const std::string& w : dictionary)
+        {
+            if (w != word && reachable.count(w) != 0)
+            {
+                found.push_back(w);
+            }
+        }
+        return found;
+    }
+
+
+    std::vector<std::string> sorted(std::vector<std::string> words)
+    {
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+}
+
+
+TEST(WordChecker_Distance2Tests, findsEveryWordWithinTwoEdits)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    PrefixFilter prefixes{dictionary};
+
+    // Only letters are inserted or replaced, so DON'T is out of reach of
+    // anything without an apostrophe, but not of DON'S.
+    for (const char* query : {"CAX", "CTA", "XYZ", "ELEFANT", "RITHM", "BECUASE", "BEECH", "Q", "", "DONT", "DON'S"})
+    {
+        SuggestionResult result = checker.findDistance2Suggestions(query, prefixes);
+        EXPECT_TRUE(result.complete) << query;
+        EXPECT_EQ(sorted(withinTwoEdits(query)), sorted(result.words)) << query;
+    }
+}
+
+
+TEST(WordChecker_Distance2Tests, wordsOneEditAwayComeFirst)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    PrefixFilter prefixes{dictionary};
+
+    SuggestionResult result = checker.findDistance2Suggestions("CATZ", prefixes);
+    std::set<std::string> near = edits("CATZ");
+
+    auto isNear = [&](const std::string& word) { return near.count(word) != 0; };
+    auto firstFar = std::find_if_not(result.words.begin(), result.words.end(), isNear);
+
+    ASSERT_NE(result.words.begin(), firstFar);
+    ASSERT_NE(result.words.end(), firstFar);
+    EXPECT_TRUE(std::none_of(firstFar, result.words.end(), isNear));
+}
+
+
+TEST(WordChecker_Distance2Tests, queriesAreFoldedToUpperCase)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    PrefixFilter prefixes{dictionary};
+
+    EXPECT_EQ(
+        sorted(checker.findDistance2Suggestions("ELEFANT", prefixes).words),
+        sorted(checker.findDistance2Suggestions("elefant", prefixes).words));
+}
+
+
+TEST(WordChecker_Distance2Tests, theBudgetLimitsCandidatesTried)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+    PrefixFilter prefixes{dictionary};
+
+    SuggestionResult all = checker.findDistance2Suggestions("ELEFANT", prefixes);
+    ASSERT_TRUE(all.complete);
+
+    // "ELEFANT" has 7 * 25 + 8 * 26 + 7 + 6 single edits, fewer any
+    // duplicates; a budget of 100 can't even try all of them.
+    SuggestionResult cut = checker.findDistance2Suggestions("ELEFANT", prefixes, 100);
+    EXPECT_FALSE(cut.complete);
+    EXPECT_LE(cut.words.size(), all.words.size());
+
+    SuggestionResult none = checker.findDistance2Suggestions("ELEFANT", prefixes, 0);
+    EXPECT_FALSE(none.complete);
+    EXPECT_TRUE(none.words.empty());
+}
+
+
+TEST(WordChecker_Distance2Tests, onlyCandidatesThatBeginSomeWordAreLookedUp)
+{
+    HashSet<std::string> words = makeWords();
+    PrefixFilter prefixes{dictionary};
+
+    // A set that counts lookups, to see how many candidates get that far.
+    struct CountingSet
+    {
+        const HashSet<std::string>& words;
+        mutable std::size_t lookups = 0;
+
+        bool contains(const std::string& word) const
+        {
+            ++lookups;
+            return words.contains(word);
+        }
+    };
+
+    CountingSet counting{words};
+    BasicWordChecker<CountingSet> checker{counting};
+
+    SuggestionResult result = checker.findDistance2Suggestions("BECUASE", prefixes);
+    EXPECT_TRUE(result.complete);
+    EXPECT_NE(result.words.end(), std::find(result.words.begin(), result.words.end(), "BECAUSE"));
+
+    // Every single edit of a 7-letter word, edited again, would be over
+    // 100,000 candidates, but only those that begin some word all the way
+    // through are looked up: here, BECAUSE (one edit away) and BECAUS (two
+    // away, which begins BECAUSE but isn't a word itself).
+    EXPECT_EQ(std::vector<std::string>{"BECAUSE"}, result.words);
+    EXPECT_EQ(2u, counting.lookups);
+}
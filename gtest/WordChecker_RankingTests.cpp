@@ -0,0 +1,262 @@
+// WordChecker_RankingTests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordFrequencies and for the ranked suggestions that
+// findTopSuggestions() makes with them, which are checked against ranking
+// everything the five families of edits find.
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    const std::vector<std::string> dictionary{
+        "THE", "CAT", "CART", "CAST", "COAT", "AT", "A", "AN", "ANT", "CATS", "SCAT",
+        "ACT", "CUT", "COT", "BAT", "HAT", "MAT", "SAT", "CAB", "CAN", "CAP", "CAR"};
+
+    const std::string frequencyFile =
+        "# word frequencies\n"
+        "THE 500\n"
+        "CAT 90\n"
+        "CART 15\n"
+        "CAST 20\n"
+        "\n"
+        "coat 4\n"
+        "AT 300\n"
+        "A 400\n"
+        "AN 200\n"
+        "ACT 60\n"
+        "CUT 70\n"
+        "COT 5\n"
+        "BAT 30\n"
+        "HAT 40\n"
+        "MAT 10\n"
+        "CAN 80\n"
+        "CAR 85\n";
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const std::string& word : dictionary)
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    WordFrequencies makeFrequencies()
+    {
+        std::istringstream in{frequencyFile};
+        WordFrequencies frequencies;
+        frequencies.read(in);
+        return frequencies;
+    }
+
+
+    // A CountingSet counts the lookups made of it.
+    class CountingSet
+    {
+    public:
+        explicit CountingSet(const HashSet<std::string>& words)
+            : words{words}, lookups{0}
+        {
+        }
+
+        bool contains(const std::string& word) const
+        {
+            ++lookups;
+            return words.contains(word);
+        }
+
+        const HashSet<std::string>& words;
+        mutable unsigned int lookups;
+    };
+
+
+    // rankAll() ranks every suggestion each family of edits finds, the
+    // slow way, to check findTopSuggestions() against.
+    std::vector<std::string> rankAll(
+        const WordChecker& checker, const WordFrequencies& frequencies, const std::string& word)
+    {
+        std::vector<std::string> suggestions;
+        for (auto edit : {&WordChecker::swapIt, &WordChecker::insertIt, &WordChecker::deleteIt,
+                          &WordChecker::replaceIt, &WordChecker::splitIt})
+        {
+            std::vector<std::string> found;
+            (checker.*edit)(word, found);
+            suggestions.insert(suggestions.end(), found.begin(), found.end());
+        }
+
+        std::vector<impl_::BasicWordChecker__Ranked> ranked;
+
+        for (const std::string& suggestion : suggestions)
+        {
+            std::size_t space = suggestion.find(' ');
+            if (space == std::string::npos)
+            {
+                ranked.push_back({1, frequencies.frequency(suggestion), suggestion});
+            }
+            else
+            {
+                std::uint64_t frequency = std::min(
+                    frequencies.frequency(suggestion.substr(0, space)),
+                    frequencies.frequency(suggestion.substr(space + 1)));
+                ranked.push_back({2, frequency, suggestion});
+            }
+        }
+
+        std::sort(ranked.begin(), ranked.end(), impl_::BasicWordChecker__ranksBefore);
+
+        std::vector<std::string> words;
+        for (const auto& r : ranked)
+        {
+            if (std::find(words.begin(), words.end(), r.word) == words.end())
+            {
+                words.push_back(r.word);
+            }
+        }
+        return words;
+    }
+}
+
+
+TEST(WordChecker_RankingTests, frequenciesAreReadIgnoringCaseAndComments)
+{
+    WordFrequencies frequencies = makeFrequencies();
+
+    EXPECT_EQ(16u, frequencies.size());
+    EXPECT_EQ(90u, frequencies.frequency("CAT"));
+    EXPECT_EQ(90u, frequencies.frequency("cat"));
+    EXPECT_EQ(4u, frequencies.frequency("COAT"));
+    EXPECT_EQ(0u, frequencies.frequency("SCAT"));
+}
+
+
+TEST(WordChecker_RankingTests, repeatedWordsHaveTheirCountsAdded)
+{
+    WordFrequencies frequencies;
+    frequencies.add("CAT", 5);
+    frequencies.add("cat", 7);
+
+    EXPECT_EQ(1u, frequencies.size());
+    EXPECT_EQ(12u, frequencies.frequency("CAT"));
+}
+
+
+TEST(WordChecker_RankingTests, maxFrequenciesAreKeptByLength)
+{
+    WordFrequencies frequencies = makeFrequencies();
+
+    EXPECT_EQ(400u, frequencies.maxFrequency(1));
+    EXPECT_EQ(300u, frequencies.maxFrequency(2));
+    EXPECT_EQ(500u, frequencies.maxFrequency(3));
+    EXPECT_EQ(20u, frequencies.maxFrequency(4));
+    EXPECT_EQ(0u, frequencies.maxFrequency(5));
+    EXPECT_EQ(500u, frequencies.maxFrequency());
+}
+
+
+TEST(WordChecker_RankingTests, malformedFrequencyFilesAreRejected)
+{
+    for (const char* text : {"CAT\n", "CAT many\n", "CAT 12 13\n", "CAT -4\n", "CAT 99999999999999999999999\n"})
+    {
+        std::istringstream in{text};
+        WordFrequencies frequencies;
+        EXPECT_THROW(frequencies.read(in), WordFrequencies::FrequencyException) << text;
+    }
+
+    EXPECT_THROW(WordFrequencies{"/nonexistent/frequencies.txt"}, WordFrequencies::FrequencyException);
+}
+
+
+TEST(WordChecker_RankingTests, suggestionsAreRankedByCostThenFrequency)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies = makeFrequencies();
+    WordChecker checker{words, frequencies};
+
+    EXPECT_EQ((std::vector<std::string>{"CAT", "CAR", "CAN"}), checker.findTopSuggestions("CAX", 3));
+    EXPECT_EQ((std::vector<std::string>{"CAT"}), checker.findTopSuggestions("CAX", 1));
+    EXPECT_EQ((std::vector<std::string>{"CAT", "ACT", "SCAT", "A CAT"}), checker.findTopSuggestions("ACAT", 4));
+    EXPECT_TRUE(checker.findTopSuggestions("CAX", 0).empty());
+}
+
+
+TEST(WordChecker_RankingTests, topSuggestionsMatchRankingEverySuggestion)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies = makeFrequencies();
+    WordChecker checker{words, frequencies};
+
+    for (const char* word : {"CAX", "CTA", "CAAT", "ACAT", "THECAT", "ATT", "AA", "Q", "XYZZY", "CATT", "SCATS"})
+    {
+        std::vector<std::string> all = rankAll(checker, frequencies, word);
+
+        for (std::size_t k = 0; k <= all.size() + 1; ++k)
+        {
+            std::vector<std::string> expected{all.begin(), all.begin() + std::min(k, all.size())};
+            EXPECT_EQ(expected, checker.findTopSuggestions(word, k)) << word << " k=" << k;
+        }
+    }
+}
+
+
+TEST(WordChecker_RankingTests, withoutFrequenciesSuggestionsAreRankedByCostThenAlphabetically)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    EXPECT_EQ((std::vector<std::string>{"CAB", "CAN", "CAP", "CAR", "CAT"}), checker.findTopSuggestions("CAX", 10));
+}
+
+
+TEST(WordChecker_RankingTests, basicWordCheckerRanksTheSameWay)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies = makeFrequencies();
+    WordChecker erased{words, frequencies};
+    BasicWordChecker<HashSet<std::string>> direct{words};
+
+    for (const char* word : {"CAX", "CTA", "ACAT", "THECAT"})
+    {
+        EXPECT_EQ(erased.findTopSuggestions(word, 4), direct.findTopSuggestions(word, 4, frequencies)) << word;
+    }
+}
+
+
+TEST(WordChecker_RankingTests, familiesThatCannotRankHighEnoughAreSkipped)
+{
+    HashSet<std::string> words = makeWords();
+    WordFrequencies frequencies = makeFrequencies();
+    CountingSet counting{words};
+    BasicWordChecker<CountingSet> checker{counting};
+
+    checker.findTopSuggestions("CAX", 100, frequencies);
+    unsigned int allLookups = counting.lookups;
+
+    // CAT, found by replacing a letter, is more frequent than any
+    // four-letter word, so no insertions or splits need to be tried.
+    counting.lookups = 0;
+    EXPECT_EQ(std::vector<std::string>{"CAT"}, checker.findTopSuggestions("CAX", 1, frequencies));
+    EXPECT_LT(counting.lookups, allLookups - 4 * 26);
+}
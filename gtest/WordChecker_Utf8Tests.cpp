@@ -0,0 +1,267 @@
+// WordChecker_Utf8Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for checking words, and suggesting them, in a dictionary whose
+// letters go beyond 'A' through 'Z', with an Alphabet built from it.
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Alphabet.hpp"
+#include "HashSet.hpp"
+#include "PrefixFilter.hpp"
+#include "Utf8.hpp"
+#include "WordChecker.hpp"
+#include "WordFrequencies.hpp"
+
+
+namespace
+{
+    unsigned int stringHash(const std::string& s)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(s));
+    }
+
+
+    // MÜDE, MÜHE, STRAßE, GRÜßE, ÄPFEL, SCHÖN, TÜR, TOR, MUD
+    const std::vector<std::string> dictionary{
+        "M\xC3\x9C" "DE", "M\xC3\x9CHE", "STRA\xC3\x9F" "E", "GR\xC3\x9C\xC3\x9F" "E",
+        "\xC3\x84PFEL", "SCH\xC3\x96N", "T\xC3\x9CR", "TOR", "MUD"};
+
+    const std::string MUEDE = "M\xC3\x9C" "DE";
+
+
+    HashSet<std::string> makeWords()
+    {
+        HashSet<std::string> words{stringHash};
+        for (const std::string& word : dictionary)
+        {
+            words.add(word);
+        }
+        return words;
+    }
+
+
+    bool contains(const std::vector<std::string>& words, const std::string& word)
+    {
+        return std::find(words.begin(), words.end(), word) != words.end();
+    }
+
+
+    // isWellFormed() returns true if every character of the given text is
+    // either ASCII or a whole UTF-8 sequence, i.e., no edit split one.
+    bool isWellFormed(const std::string& text)
+    {
+        for (std::size_t i = 0; i < text.size(); i += Utf8::sequenceLength(text, i))
+        {
+            if (Utf8::sequenceLength(text, i) == 1 && static_cast<unsigned char>(text[i]) >= 0x80)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    // characters() splits the given text into its characters.
+    std::vector<std::string> characters(const std::string& text)
+    {
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < text.size(); i += Utf8::sequenceLength(text, i))
+        {
+            result.push_back(text.substr(i, Utf8::sequenceLength(text, i)));
+        }
+        return result;
+    }
+
+
+    std::string join(const std::vector<std::string>& letters)
+    {
+        std::string result;
+        for (const std::string& letter : letters)
+        {
+            result += letter;
+        }
+        return result;
+    }
+
+
+    // edits() returns every string one swap, deletion, replacement or
+    // insertion (of a letter of the given Alphabet) away from the given one.
+    std::set<std::string> edits(const std::string& s, const Alphabet& alphabet)
+    {
+        std::vector<std::string> letters = characters(s);
+        std::set<std::string> result;
+
+        for (std::size_t i = 0; i <= letters.size(); ++i)
+        {
+            std::vector<std::string> edited = letters;
+
+            if (i + 1 < letters.size())
+            {
+                std::swap(edited[i], edited[i + 1]);
+                result.insert(join(edited));
+                edited = letters;
+            }
+            if (i < letters.size())
+            {
+                edited.erase(edited.begin() + i);
+                result.insert(join(edited));
+                edited = letters;
+            }
+            for (const std::string& letter : alphabet.letters())
+            {
+                if (i < letters.size())
+                {
+                    edited[i] = letter;
+                    result.insert(join(edited));
+                    edited = letters;
+                }
+                edited.insert(edited.begin() + i, letter);
+                result.insert(join(edited));
+                edited = letters;
+            }
+        }
+
+        result.erase(s);
+        return result;
+    }
+
+
+    std::vector<std::string> sorted(std::vector<std::string> words)
+    {
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+}
+
+
+TEST(WordChecker_Utf8Tests, wordsAreCheckedWithoutRegardToCase)
+{
+    HashSet<std::string> words = makeWords();
+    WordChecker checker{words};
+
+    EXPECT_TRUE(checker.wordExists(MUEDE));
+    EXPECT_TRUE(checker.wordExists("m\xC3\xBC" "de"));
+    EXPECT_TRUE(checker.wordExists("M\xC3\xBC" "de"));
+    EXPECT_TRUE(checker.wordExists("stra\xC3\x9F" "e"));
+    EXPECT_TRUE(checker.wordExists("sch\xC3\xB6n"));
+    EXPECT_FALSE(checker.wordExists("mude"));
+}
+
+
+TEST(WordChecker_Utf8Tests, editsWorkOnWholeCharacters)
+{
+    HashSet<std::string> words = makeWords();
+    Alphabet alphabet{dictionary};
+    WordChecker checker{words, alphabet};
+
+    std::vector<std::string> swapped;
+    std::vector<std::string> deleted;
+    std::vector<std::string> inserted;
+    std::vector<std::string> replaced;
+
+    checker.swapIt("\xC3\x9CMDE", swapped);
+    checker.deleteIt("M\xC3\x9C\xC3\x9C" "DE", deleted);
+    checker.insertIt("MDE", inserted);
+    checker.replaceIt("MUDE", replaced);
+
+    EXPECT_EQ(std::vector<std::string>{MUEDE}, swapped);
+    EXPECT_EQ(std::vector<std::string>{MUEDE}, deleted);
+    EXPECT_EQ(std::vector<std::string>{MUEDE}, inserted);
+    EXPECT_EQ(std::vector<std::string>{MUEDE}, replaced);
+
+    // Replacing a byte at a time would leave half of Ü behind in TÜRE,
+    // and could never turn TÜR into TOR.
+    std::vector<std::string> suggestions = checker.findSuggestions("T\xC3\x9CRE");
+    EXPECT_TRUE(contains(suggestions, "T\xC3\x9CR"));
+    EXPECT_TRUE(std::all_of(suggestions.begin(), suggestions.end(), isWellFormed));
+
+    replaced.clear();
+    checker.replaceIt("T\xC3\x9CR", replaced);
+    EXPECT_EQ((std::vector<std::string>{"TOR", "T\xC3\x9CR"}), sorted(replaced));
+}
+
+
+TEST(WordChecker_Utf8Tests, theEnglishAlphabetIsUsedUnlessAnotherIsGiven)
+{
+    HashSet<std::string> words = makeWords();
+    Alphabet alphabet{dictionary};
+
+    WordChecker english{words};
+    WordChecker german{words, alphabet};
+
+    EXPECT_FALSE(contains(english.findSuggestions("MUDE"), MUEDE));
+    EXPECT_TRUE(contains(german.findSuggestions("MUDE"), MUEDE));
+}
+
+
+TEST(WordChecker_Utf8Tests, likelySuggestionsTryTheRestOfTheAlphabetLast)
+{
+    HashSet<std::string> words = makeWords();
+    Alphabet alphabet{dictionary};
+    WordChecker checker{words, alphabet};
+
+    EXPECT_TRUE(contains(checker.findLikelySuggestions("MUDE", 5), MUEDE));
+    EXPECT_TRUE(contains(checker.findLikelySuggestions("MDE", 5), MUEDE));
+    EXPECT_FALSE(contains(checker.findLikelySuggestions("MUDE", 5, nullptr, EditTier::SoundAlike), MUEDE));
+}
+
+
+TEST(WordChecker_Utf8Tests, frequenciesAreBoundedByLengthInCharacters)
+{
+    HashSet<std::string> words = makeWords();
+    Alphabet alphabet{dictionary};
+
+    WordFrequencies frequencies;
+    frequencies.add(MUEDE, 1000);
+    frequencies.add("MUD", 1);
+
+    // MÜDE is four characters but five bytes; if the replacements of the
+    // four-letter MUDE were bounded by the frequencies of four-byte words,
+    // none of which are in the table, MUD would be found first and MÜDE
+    // never looked for.
+    EXPECT_EQ(1000u, frequencies.maxFrequency(4));
+
+    WordChecker checker{words, frequencies, alphabet};
+    EXPECT_EQ(std::vector<std::string>{MUEDE}, checker.findTopSuggestions("MUDE", 1));
+}
+
+
+TEST(WordChecker_Utf8Tests, distance2SuggestionsReachEveryWordWithinTwoEdits)
+{
+    HashSet<std::string> words = makeWords();
+    Alphabet alphabet{dictionary};
+    WordChecker checker{words, alphabet};
+    PrefixFilter prefixes{dictionary};
+
+    for (const char* query : {"MUDR", "\xC3\x9CMD", "STRASE", "GRUSSE", "SCHON", "APFEL", "TR", ""})
+    {
+        std::set<std::string> reachable = edits(query, alphabet);
+        for (const std::string& edit : edits(query, alphabet))
+        {
+            std::set<std::string> more = edits(edit, alphabet);
+            reachable.insert(more.begin(), more.end());
+        }
+
+        std::vector<std::string> expected;
+        for (const std::string& word : dictionary)
+        {
+            if (word != query && reachable.count(word) != 0)
+            {
+                expected.push_back(word);
+            }
+        }
+
+        SuggestionResult result = checker.findDistance2Suggestions(query, prefixes);
+        EXPECT_TRUE(result.complete) << query;
+        EXPECT_EQ(sorted(expected), sorted(result.words)) << query;
+    }
+
+    EXPECT_TRUE(contains(checker.findDistance2Suggestions("mudr", prefixes).words, MUEDE));
+}